@@ -1,18 +1,14 @@
 #version 460 core
+#include "../common/camera_data.glsl"
 
 layout (location = 0) out vec4 FragOut;
 layout (binding = 0) uniform sampler2D previousDepthTexture;
 
 in vec4 WorldPos;
-uniform mat4 view;
-uniform float nearPlane;
-uniform float farPlane;
-uniform float viewportWidth;
-uniform float viewportHeight;
 
 void main() {
  
-    vec2 uv_screenspace = gl_FragCoord.xy / vec2(viewportWidth, viewportHeight);
+    vec2 uv_screenspace = gl_FragCoord.xy / vec2(hairViewportWidth, hairViewportHeight);
     float previousDepth = texture2D(previousDepthTexture, uv_screenspace).r;
 
     float viewspaceDepth = (view * WorldPos).z;
@@ -1,14 +1,12 @@
 #version 460 core
+#include "../common/camera_data.glsl"
+#include "../common/instance_data.glsl"
 
 layout (location = 0) in vec3 vPosition;
 
-uniform mat4 projection;
-uniform mat4 view;
-uniform mat4 model;
-
 out vec4 WorldPos;
 
 void main() {
-    WorldPos = model * vec4(vPosition, 1.0);
+    WorldPos = instances[gl_BaseInstance + gl_InstanceID].modelMatrix * vec4(vPosition, 1.0);
 	gl_Position = projection * view * WorldPos;
-}
\ No newline at end of file
+}
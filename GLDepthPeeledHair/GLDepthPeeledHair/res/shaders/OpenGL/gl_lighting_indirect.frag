@@ -0,0 +1,27 @@
+#version 460 core
+#extension GL_ARB_bindless_texture : require
+#include "../common/camera_data.glsl"
+#include "../common/render_items.glsl"
+#include "../common/surface_lighting.glsl"
+
+layout (location = 0) out vec4 FragOut;
+
+in vec2 TexCoord;
+in vec3 Normal;
+in vec3 Tangent;
+in vec3 BiTangent;
+in vec3 WorldPos;
+flat in float AlphaScale;
+flat in int RenderItemIndex;
+
+uniform int settings;
+uniform bool isHair;
+
+void main() {
+    RenderItem renderItem = renderItems[RenderItemIndex];
+    vec4 baseColor = texture(sampler2D(renderItem.baseColorHandle), TexCoord);
+    baseColor.a = min(baseColor.a * AlphaScale, 1.0);
+    vec3 normalMap = texture(sampler2D(renderItem.normalHandle), TexCoord).rgb;
+    vec3 rma = texture(sampler2D(renderItem.rmaHandle), TexCoord).rgb;
+    FragOut = GetSurfaceLighting(baseColor, normalMap, rma, WorldPos, Normal, Tangent, BiTangent, viewPos.xyz);
+}
@@ -0,0 +1,36 @@
+#version 460 core
+#include "../common/camera_data.glsl"
+#include "../common/instance_data.glsl"
+#include "../common/octahedral.glsl"
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec2 vNormal;
+layout (location = 2) in vec2 vUV;
+layout (location = 3) in vec2 vTangent;
+
+uniform vec4 clippingPlane;
+
+out vec2 TexCoord;
+out vec3 WorldPos;
+out vec3 Normal;
+out vec3 Tangent;
+out vec3 BiTangent;
+flat out float AlphaScale;
+flat out int RenderItemIndex;
+
+void main() {
+    InstanceData instance = instances[gl_BaseInstance + gl_InstanceID];
+    vec4 worldPos = instance.modelMatrix * vec4(vPosition, 1.0);
+
+	TexCoord = vUV;
+    WorldPos = worldPos.xyz;
+    AlphaScale = instance.alphaScale;
+    RenderItemIndex = gl_BaseInstance + gl_InstanceID;
+
+    Normal = normalize(instance.normalMatrix * vec4(OctahedralDecode(vNormal), 0)).xyz;
+    Tangent = normalize(instance.normalMatrix * vec4(OctahedralDecode(vTangent), 0)).xyz;
+    BiTangent = normalize(cross(Normal, Tangent));
+
+    gl_ClipDistance[0] = dot(worldPos, clippingPlane);
+	gl_Position = projection * view * worldPos;
+}
@@ -1,10 +1,9 @@
 #version 460 core
+#include "../common/camera_data.glsl"
 
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 
-uniform mat4 projection;
-uniform mat4 view;
 uniform mat4 model;
 
 out vec3 Color;
@@ -0,0 +1,16 @@
+// Mirrors CameraData in Types.h, uploaded and bound once per frame
+layout(std140, binding = 0) uniform CameraData {
+    mat4 projection;
+    mat4 projectionInverse;
+    mat4 view;
+    mat4 viewInverse;
+    vec4 viewPos;
+    float viewportWidth;
+    float viewportHeight;
+    float hairViewportWidth;
+    float hairViewportHeight;
+    float nearPlane;
+    float farPlane;
+    float time;
+    float cameraDataPadding;
+};
@@ -0,0 +1,13 @@
+// Mirrors InstanceData in Types.h, indexed by gl_BaseInstance + gl_InstanceID, both the per item and the indirect paths draw with it
+struct InstanceData {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    float alphaScale;   // Above 1 on hair card LODs to make up for the removed cards
+    float padding0;
+    float padding1;
+    float padding2;
+};
+
+layout(std430, binding = 1) readonly buffer Instances {
+    InstanceData instances[];
+};
@@ -0,0 +1,8 @@
+// Mirrors VertexCompression::OctahedralDecode(), the input is the snorm16x2 attribute already normalized to [-1, 1]
+vec3 OctahedralDecode(vec2 e) {
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
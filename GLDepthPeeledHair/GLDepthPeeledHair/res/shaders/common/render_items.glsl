@@ -0,0 +1,11 @@
+// Mirrors GPURenderItem in Types.h, indexed by gl_BaseInstance + gl_InstanceID of each indirect draw
+struct RenderItem {
+    uvec2 baseColorHandle;
+    uvec2 normalHandle;
+    uvec2 rmaHandle;
+    uvec2 padding;
+};
+
+layout(std430, binding = 0) readonly buffer RenderItems {
+    RenderItem renderItems[];
+};
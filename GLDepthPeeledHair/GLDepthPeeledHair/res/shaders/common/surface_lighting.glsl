@@ -0,0 +1,62 @@
+#include "../common/lighting.glsl"
+#include "../common/post_processing.glsl"
+
+// Shared by the bound texture and the bindless lighting shaders, takes the already sampled material textures
+vec4 GetSurfaceLighting(vec4 baseColor, vec3 normalMap, vec3 rma, vec3 WorldPos, vec3 Normal, vec3 Tangent, vec3 BiTangent, vec3 viewPos) {
+	baseColor.rgb = pow(baseColor.rgb, vec3(2.2));
+
+	mat3 tbn = mat3(Tangent, BiTangent, Normal);
+	vec3 normal = normalize(tbn * (normalMap.rgb * 2.0 - 1.0));
+    
+    float roughness = rma.r;
+    float metallic = rma.g;
+
+    vec3 lightPosition = (vec3(7, 0, 10) * 0.5) + vec3(0, 0.125, 1);
+    vec3 lightColor = vec3(1, 0.98, 0.94);
+    float lightRadius = 5;
+    float lightStrength = 2;
+        
+    lightPosition = (vec3(7, 0, 10) * 0.5) + vec3(-0.5, 0.525, 1);
+    lightStrength = 1;
+    lightRadius = 10;
+		
+    vec3 directLighting = GetDirectLighting(lightPosition, lightColor, lightRadius, lightStrength, normal, WorldPos.xyz, baseColor.rgb, roughness, metallic, viewPos);
+
+    float ambientIntensity = 0.05;
+    vec3 ambientColor = baseColor.rgb * lightColor;
+    vec3 ambientLighting = ambientColor * ambientIntensity;
+
+    float finalAlpha = baseColor.a;
+    
+    vec3 finalColor = directLighting.rgb + ambientLighting;
+
+    // Hair transluceny    
+    //if (isHair) {    
+	//    vec3 viewDir = normalize(viewPos - WorldPos);
+    //    vec3 lightDir = normalize(lightPosition - WorldPos.xyz);
+    //    vec3 halfVector = normalize(lightDir + viewDir);
+    //    float diff = max(dot(normal, lightDir), 0.0);
+    //    float spec = pow(max(dot(normal, halfVector), 0.0), 32.0);
+    //    float backlight = max(dot(-normal, lightDir), 0.0);
+    //    vec3 lightColor = vec3(1, 0.98, 0.94);
+    //    float translucencyFactor = 0.01;
+    //    vec3 translucency = backlight * lightColor * translucencyFactor;
+    //    finalColor.rgb += translucency * baseColor.rgb; // multiplying with baseColor is a hack but looks 100x better
+    //}
+
+    // Hair frensel
+    //if (isHair) {    
+	//    vec3 viewDir = normalize(viewPos - WorldPos);
+    //    float frenselFactor = 0.025;
+    //    float fresnel = pow(1.0 - dot(normal, viewDir), 2.0);        
+    //    finalColor.rgb += vec3(fresnel * frenselFactor) * baseColor.rgb; // multiplying with baseColor is a hack but looks 100x better
+    //}
+
+    // Tone mapping
+	finalColor = mix(finalColor, Tonemap_ACES(finalColor), 1.0);
+	finalColor = pow(finalColor, vec3(1.0/2.2));
+	finalColor = mix(finalColor, Tonemap_ACES(finalColor), 0.235);
+
+    finalColor.rgb = finalColor.rgb * finalAlpha;
+    return vec4(finalColor, finalAlpha);
+}
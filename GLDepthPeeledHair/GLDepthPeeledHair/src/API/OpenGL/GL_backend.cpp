@@ -2,11 +2,18 @@
 #include "GL_backend.h"
 #include "../AssetManagement/BakeQueue.h"
 #include "../AssetManagement/AssetManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iterator>
 #include <string>
 #include <iostream>
 #include <vector>
 #include "Types.h"
 #include "GL_util.hpp"
+#include "GL_stats.h"
+#include "GL_capture.h"
 
 namespace OpenGLBackend {
 
@@ -21,19 +28,86 @@ namespace OpenGLBackend {
     GLuint g_fullscreenWidth;
     GLuint g_fullscreenHeight;
 
-    // PBO texture loading
+    // Texture staging. The ring replaced 32 PBOs sized for a 4096x4096 RGBA level each, those are only kept for the memory report
     const size_t MAX_TEXTURE_WIDTH = 4096;
     const size_t MAX_TEXTURE_HEIGHT = 4096;
     const size_t MAX_CHANNEL_COUNT = 4;
     const size_t MAX_DATA_SIZE = MAX_TEXTURE_WIDTH * MAX_TEXTURE_HEIGHT * MAX_CHANNEL_COUNT;
-    std::vector<PBO> g_textureBakingPBOs;
+    const size_t LEGACY_PBO_COUNT = 32;
+    const size_t STAGING_ALIGNMENT = 16;            // Covers every unpack alignment and the 8/16 byte BC blocks
+    const size_t STAGING_CHUNK_DIVISOR = 4;         // Levels bigger than a quarter of the ring go up in row chunks
+    size_t g_textureStagingSize = 128 * 1024 * 1024;
+    StagingRing g_textureStagingRing;
+    uint32_t g_chunkedUploadCount = 0;
+
+    // Texture upload scheduling, bytes and time spent staging per frame are capped so streaming never hitches a frame
+    using UploadClock = std::chrono::high_resolution_clock;
+    size_t g_uploadByteBudget = 16 * 1024 * 1024;
+    double g_uploadTimeBudgetMs = 2.0;
+    std::vector<QueuedTextureBake*> g_pendingBakes;
+
+    struct TextureUploadStats {
+        int pendingCounts[3] = { 0, 0, 0 };     // Per UploadPriority
+        size_t totalBytes = 0;
+        double peakFrameMs = 0.0;
+        size_t windowBytes = 0;
+        double windowMBPerSecond = 0.0;
+        UploadClock::time_point windowStart = UploadClock::now();
+        UploadClock::time_point firstUploadTime;
+        UploadClock::time_point lastUploadTime;
+    } g_uploadStats;
+
+    // Headless
+    bool g_headless = false;
+    bool g_headlessCloseRequested = false;
+    void CreateTextureStagingRing();
+
+    // State cache
+    constexpr GLuint UNKNOWN_BINDING = 0xFFFFFFFF;
+    constexpr GLenum UNKNOWN_STATE = 0xFFFFFFFF;
+    constexpr int MAX_CACHED_TEXTURE_UNITS = 32;
+
+    enum class CachedCapability { BLEND, CULL_FACE, DEPTH_TEST, COUNT };
+
+    struct StateCache {
+        GLuint program = UNKNOWN_BINDING;
+        GLuint vertexArray = UNKNOWN_BINDING;
+        GLuint drawFrameBuffer = UNKNOWN_BINDING;
+        GLuint readFrameBuffer = UNKNOWN_BINDING;
+        GLuint textureUnits[MAX_CACHED_TEXTURE_UNITS];
+        GLenum capabilities[(int)CachedCapability::COUNT];
+        GLenum depthFunc = UNKNOWN_STATE;
+        GLenum depthMask = UNKNOWN_STATE;
+        GLenum blendSourceFactor = UNKNOWN_STATE;
+        GLenum blendDestinationFactor = UNKNOWN_STATE;
+        glm::ivec4 viewport = glm::ivec4(-1);
+    } g_stateCache;
+
+    struct StateCacheCounters {
+        uint32_t programs = 0;
+        uint32_t vertexArrays = 0;
+        uint32_t frameBuffers = 0;
+        uint32_t textures = 0;
+        uint32_t capabilities = 0;
+        uint32_t depthAndBlend = 0;
+        uint32_t viewports = 0;
+    };
+    StateCacheCounters g_skippedCalls;
+    StateCacheCounters g_lastFrameSkippedCalls;
 
     GLFWwindow* GetWindowPtr() {
         return g_window;
     }
 
-    void Init(int width, int height, std::string title) {
-        glfwInit();
+    bool IsHeadless() {
+        return g_headless;
+    }
+
+    bool Init(int width, int height, std::string title) {
+        if (!glfwInit()) {
+            std::cout << "GLFW failed init\n";
+            return false;
+        }
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -52,12 +126,12 @@ namespace OpenGLBackend {
         if (g_window == NULL) {
             std::cout << "GLFW window failed creation\n";
             glfwTerminate();
-            return;
+            return false;
         }
         glfwMakeContextCurrent(g_window);
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
             std::cout << "GLAD failed init\n";
-            return;
+            return false;
         }
         glfwSetInputMode(g_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
         ToggleFullscreen();
@@ -67,14 +141,69 @@ namespace OpenGLBackend {
         glClear(GL_COLOR_BUFFER_BIT);
         SwapBuffersPollEvents();
 
-        for (int i = 0; i < 32; ++i) {
-            PBO& pbo = g_textureBakingPBOs.emplace_back();
-            pbo.Init(MAX_DATA_SIZE);
+        CreateTextureStagingRing();
+        return true;
+    }
+
+    // Headless is an invisible GLFW window, everything renders into FBOs and nothing is presented
+    bool InitHeadless(int width, int height) {
+        g_headless = true;
+        g_currentWindowWidth = width;
+        g_currentWindowHeight = height;
+        g_windowedWidth = width;
+        g_windowedHeight = height;
+        g_fullscreenWidth = width;
+        g_fullscreenHeight = height;
+        if (!glfwInit()) {
+            std::cout << "GLFW failed init\n";
+            return false;
         }
-        return;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        g_window = glfwCreateWindow(width, height, "Headless", NULL, NULL);
+        if (g_window == NULL) {
+            std::cout << "GLFW headless window failed creation\n";
+            glfwTerminate();
+            return false;
+        }
+        glfwMakeContextCurrent(g_window);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cout << "GLAD failed init\n";
+            return false;
+        }
+        glfwSwapInterval(0);
+        std::cout << "Headless context: " << glGetString(GL_RENDERER) << " / " << glGetString(GL_VERSION) << "\n";
+        CreateTextureStagingRing();
+        return true;
+    }
+
+    void SetTextureUploadBudget(size_t bytesPerFrame, double msPerFrame) {
+        g_uploadByteBudget = std::max(bytesPerFrame, (size_t)64 * 1024);
+        g_uploadTimeBudgetMs = msPerFrame;
+    }
+
+    void SetTextureStagingSize(size_t size) {
+        g_textureStagingSize = std::max(size, (size_t)1024 * 1024);
+    }
+
+    void CreateTextureStagingRing() {
+        g_textureStagingRing.Init(g_textureStagingSize);
+        size_t megabyte = 1024 * 1024;
+        std::cout << "Texture staging: " << g_textureStagingSize / megabyte << " MB ring, was " << LEGACY_PBO_COUNT << " x " << MAX_DATA_SIZE / megabyte
+            << " MB PBOs (" << LEGACY_PBO_COUNT * MAX_DATA_SIZE / megabyte << " MB)\n";
+    }
+
+    void CleanUp() {
+        g_textureStagingRing.CleanUp();
+        glfwTerminate();
     }
 
     void SetWindowedMode(const WindowedMode& windowedMode) {
+        if (g_headless) {
+            return;
+        }
         if (windowedMode == WindowedMode::WINDOWED) {
             g_currentWindowWidth = g_windowedWidth;
             g_currentWindowHeight = g_windowedHeight;
@@ -101,39 +230,69 @@ namespace OpenGLBackend {
     }
 
     void ForceCloseWindow() {
+        if (g_headless) {
+            g_headlessCloseRequested = true;
+            return;
+        }
         glfwSetWindowShouldClose(g_window, true);
     }
 
     double GetMouseX() {
+        if (g_headless) {
+            return 0;
+        }
         double x, y;
         glfwGetCursorPos(g_window, &x, &y);
         return x;
     }
 
     double GetMouseY() {
+        if (g_headless) {
+            return 0;
+        }
         double x, y;
         glfwGetCursorPos(g_window, &x, &y);
         return y;
     }
 
     int GetWindowWidth() {
+        if (g_headless) {
+            return g_currentWindowWidth;
+        }
         int width, height;
         glfwGetWindowSize(g_window, &width, &height);
         return width;
     }
 
     int GetWindowHeight() {
+        if (g_headless) {
+            return g_currentWindowHeight;
+        }
         int width, height;
         glfwGetWindowSize(g_window, &width, &height);
         return height;
     }
 
     void SwapBuffersPollEvents() {
+        OpenGLCapture::EndFrame();
+        if (OpenGLStats::IsInstalled()) {
+            OpenGLStats::EndFrame();
+        }
+#ifdef _DEBUG
+        g_lastFrameSkippedCalls = g_skippedCalls;
+        g_skippedCalls = StateCacheCounters();
+#endif
+        if (g_headless) {
+            return;
+        }
         glfwSwapBuffers(g_window);
         glfwPollEvents();
     }
 
     bool WindowIsOpen() {
+        if (g_headless) {
+            return !g_headlessCloseRequested;
+        }
         return !glfwWindowShouldClose(g_window);
     }
 
@@ -203,84 +362,313 @@ namespace OpenGLBackend {
         BakeQueue::RemoveQueuedTextureBakeByJobID(queuedTextureBake.jobID);
     }
 
+    // Runs once per frame: one pass over the fences, then the highest priority bakes are staged until the ring,
+    // the byte budget or the time budget runs out. Everything staged in the frame shares a single fence.
     void UpdateTextureBaking() {
-        for (int i = 0; i < g_textureBakingPBOs.size(); i++) {
-            // Update pbo states
-            for (PBO& pbo : g_textureBakingPBOs) {
-                pbo.UpdateState();
-            }
-            // If any have completed, remove the job ID from the queue
-            for (PBO& pbo : g_textureBakingPBOs) {
-                uint32_t jobID = pbo.GetCustomValue();
-                if (pbo.IsSyncComplete() && jobID != -1) {
-                    QueuedTextureBake* queuedTextureBake = BakeQueue::GetQueuedTextureBakeByJobID(jobID);
-                    Texture* texture = static_cast<Texture*>(queuedTextureBake->texture);
-                    texture->SetTextureDataLevelBakeState(queuedTextureBake->mipmapLevel, BakeState::BAKE_COMPLETE);
-                    // Generate Mipmaps if none were supplied
-                    if (texture->MipmapsAreRequested()) {
-                        if (texture->GetTextureDataCount() == 1) {
-                            glBindTexture(GL_TEXTURE_2D, texture->GetGLTexture().GetHandle());
-                            glGenerateMipmap(GL_TEXTURE_2D); 
-                            glBindTexture(GL_TEXTURE_2D, 0);
-                        }
-                    }
-                    BakeQueue::RemoveQueuedTextureBakeByJobID(jobID);
-                    pbo.SetCustomValue(-1);
-                }
+        UploadClock::time_point startTime = UploadClock::now();
+
+        // Fences signal in submission order, so every bake handed back here has had all of its chunks consumed
+        std::vector<int> completedJobIDs;
+        g_textureStagingRing.Reclaim(completedJobIDs);
+        for (int jobID : completedJobIDs) {
+            QueuedTextureBake* queuedTextureBake = BakeQueue::GetQueuedTextureBakeByJobID(jobID);
+            if (!queuedTextureBake) {
+                continue; // Immediate baked while it was in flight
             }
-            // Bake next queued bake (should one exist)
-            if (BakeQueue::GetQueuedTextureBakeJobCount() > 0) {
-                QueuedTextureBake* queuedTextureBake = BakeQueue::GetNextQueuedTextureBake();
-                if (queuedTextureBake) {
-                    AsyncBakeQueuedTextureBake(*queuedTextureBake);
+            Texture* texture = static_cast<Texture*>(queuedTextureBake->texture);
+            texture->SetTextureDataLevelBakeState(queuedTextureBake->mipmapLevel, BakeState::BAKE_COMPLETE);
+            // Generate Mipmaps if none were supplied
+            if (texture->MipmapsAreRequested()) {
+                if (texture->GetTextureDataCount() == 1) {
+                    glBindTexture(GL_TEXTURE_2D, texture->GetGLTexture().GetHandle());
+                    glGenerateMipmap(GL_TEXTURE_2D);
+                    glBindTexture(GL_TEXTURE_2D, 0);
                 }
             }
+            BakeQueue::RemoveQueuedTextureBakeByJobID(jobID);
         }
-    }
 
-    void AsyncBakeQueuedTextureBake(QueuedTextureBake& queuedTextureBake) {
-        // Get next free PBO
-        PBO* pbo = nullptr;
-        for (PBO& queryPbo : g_textureBakingPBOs) {
-            if (queryPbo.IsSyncComplete()) {
-                pbo = &queryPbo;
+        BakeQueue::GatherPendingBakes(g_pendingBakes);
+        std::fill(std::begin(g_uploadStats.pendingCounts), std::end(g_uploadStats.pendingCounts), 0);
+        for (QueuedTextureBake* queuedTextureBake : g_pendingBakes) {
+            g_uploadStats.pendingCounts[(int)queuedTextureBake->priority]++;
+        }
+        size_t byteBudget = g_uploadByteBudget;
+        std::vector<int> stagedJobIDs;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, g_textureStagingRing.GetHandle());
+        for (QueuedTextureBake* queuedTextureBake : g_pendingBakes) {
+            int jobID = queuedTextureBake->jobID;
+            if (!AsyncBakeQueuedTextureBake(*queuedTextureBake, byteBudget)) {
+                break;
+            }
+            stagedJobIDs.push_back(jobID);
+            double elapsedMs = std::chrono::duration<double, std::milli>(UploadClock::now() - startTime).count();
+            if (byteBudget == 0 || elapsedMs >= g_uploadTimeBudgetMs) {
                 break;
             }
         }
-        // Return early if no free pbos
-        if (!pbo) {
-            //std::cout << "OpenGLBackend::UploadTexture() return early because there were no pbos avaliable!\n";
-            return;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        g_textureStagingRing.Fence(stagedJobIDs);
+
+        // Stats
+        UploadClock::time_point endTime = UploadClock::now();
+        size_t frameBytes = g_uploadByteBudget - byteBudget;
+        if (frameBytes > 0) {
+            if (g_uploadStats.totalBytes == 0) {
+                g_uploadStats.firstUploadTime = startTime;
+            }
+            g_uploadStats.totalBytes += frameBytes;
+            g_uploadStats.lastUploadTime = endTime;
+            g_uploadStats.peakFrameMs = std::max(g_uploadStats.peakFrameMs, std::chrono::duration<double, std::milli>(endTime - startTime).count());
         }
-        queuedTextureBake.inProgress = true;
+        g_uploadStats.windowBytes += frameBytes;
+        double windowSeconds = std::chrono::duration<double>(endTime - g_uploadStats.windowStart).count();
+        if (windowSeconds >= 1.0) {
+            g_uploadStats.windowMBPerSecond = g_uploadStats.windowBytes / (1024.0 * 1024.0) / windowSeconds;
+            g_uploadStats.windowBytes = 0;
+            g_uploadStats.windowStart = endTime;
+        }
+    }
 
+    // Copies as much of the level as fits into the staging ring and the remaining byte budget, which it spends. Expects the
+    // ring bound to GL_PIXEL_UNPACK_BUFFER and leaves fencing to the caller. Returns false when the level was only partly
+    // staged, the bake then picks up from uploadedRowCount on a later frame.
+    bool AsyncBakeQueuedTextureBake(QueuedTextureBake& queuedTextureBake, size_t& byteBudget) {
         Texture* texture = static_cast<Texture*>(queuedTextureBake.texture);
-        int jobID = queuedTextureBake.jobID;
         int width = queuedTextureBake.width;
         int height = queuedTextureBake.height;
         int format = queuedTextureBake.format;
         int internalFormat = queuedTextureBake.internalFormat;
         int level = queuedTextureBake.mipmapLevel;
         int dataSize = queuedTextureBake.dataSize;
-        const void* data = queuedTextureBake.data;
+        const GLubyte* data = static_cast<const GLubyte*>(queuedTextureBake.data);
+        bool compressed = texture->GetImageDataType() == ImageDataType::COMPRESSED;
 
+        if (texture->GetImageDataType() == ImageDataType::EXR) {
+            //glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, glTexture.GetWidth(), glTexture.GetHeight(), glTexture.GetFormat(), GL_FLOAT, nullptr);
+            texture->SetTextureDataLevelBakeState(level, BakeState::BAKING_IN_PROGRESS);
+            queuedTextureBake.inProgress = true;
+            return true;
+        }
+
+        // A row is one line of pixels, or one line of 4x4 blocks for compressed data
+        int rowHeight = compressed ? 4 : 1;
+        int rowCount = (height + rowHeight - 1) / rowHeight;
+        size_t rowSize = dataSize / std::max(rowCount, 1);
+        size_t maxChunkSize = std::max(rowSize, g_textureStagingRing.GetSize() / STAGING_CHUNK_DIVISOR);
+        if (rowSize == 0 || rowSize > g_textureStagingRing.GetSize()) {
+            std::cout << "OpenGLBackend::AsyncBakeQueuedTextureBake() fell back to an immediate bake because a row of '" << texture->GetFileName() << "' does not fit in the staging ring\n";
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            ImmediateBake(queuedTextureBake);
+            return false; // The bake queue changed under the caller's pending list
+        }
+        if (queuedTextureBake.uploadedRowCount == 0 && (size_t)dataSize > maxChunkSize) {
+            g_chunkedUploadCount++;
+        }
         texture->SetTextureDataLevelBakeState(level, BakeState::BAKING_IN_PROGRESS);
-        
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo->GetHandle());
-        std::memcpy(pbo->GetPersistentBuffer(), data, dataSize);
+
         glBindTexture(GL_TEXTURE_2D, texture->GetGLTexture().GetHandle());
-        
-        if (texture->GetImageDataType() == ImageDataType::UNCOMPRESSED) {
-            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, format, GL_UNSIGNED_BYTE, nullptr);
+        while (queuedTextureBake.uploadedRowCount < rowCount && byteBudget > 0) {
+            int firstRow = queuedTextureBake.uploadedRowCount;
+            size_t chunkLimit = std::min(maxChunkSize, std::max(rowSize, byteBudget));
+            int chunkRowCount = std::min(rowCount - firstRow, (int)(chunkLimit / rowSize));
+            size_t chunkSize = (firstRow + chunkRowCount == rowCount) ? dataSize - firstRow * rowSize : chunkRowCount * rowSize;
+            size_t offset = 0;
+            GLubyte* stagingData = g_textureStagingRing.Allocate(chunkSize, STAGING_ALIGNMENT, offset);
+            if (!stagingData) {
+                break;
+            }
+            std::memcpy(stagingData, data + firstRow * rowSize, chunkSize);
+            int y = firstRow * rowHeight;
+            int chunkHeight = std::min(chunkRowCount * rowHeight, height - y);
+            if (compressed) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, chunkHeight, internalFormat, (GLsizei)chunkSize, (const void*)offset);
+            }
+            else {
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, width, chunkHeight, format, GL_UNSIGNED_BYTE, (const void*)offset);
+            }
+            queuedTextureBake.uploadedRowCount += chunkRowCount;
+            byteBudget -= std::min(byteBudget, chunkSize);
         }
-        if (texture->GetImageDataType() == ImageDataType::COMPRESSED) {
-            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, internalFormat, dataSize, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        if (queuedTextureBake.uploadedRowCount < rowCount) {
+            return false;
         }
-        if (texture->GetImageDataType() == ImageDataType::EXR) {
-            //glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, glTexture.GetWidth(), glTexture.GetHeight(), glTexture.GetFormat(), GL_FLOAT, nullptr);
+        queuedTextureBake.inProgress = true;
+        return true;
+    }
+
+    std::string GetTextureStagingText() {
+        size_t megabyte = 1024 * 1024;
+        return "Texture staging: " + std::to_string(g_textureStagingRing.GetUsedSize() / megabyte) + "/" + std::to_string(g_textureStagingRing.GetSize() / megabyte) + " MB, peak "
+            + std::to_string(g_textureStagingRing.GetPeakUsedSize() / megabyte) + " MB, " + std::to_string(g_textureStagingRing.GetFenceCount()) + " fences, "
+            + std::to_string(g_chunkedUploadCount) + " chunked uploads\n";
+    }
+
+    std::string GetTextureUploadText() {
+        double streamingSeconds = std::chrono::duration<double>(g_uploadStats.lastUploadTime - g_uploadStats.firstUploadTime).count();
+        double averageMBPerSecond = streamingSeconds > 0.0 ? g_uploadStats.totalBytes / (1024.0 * 1024.0) / streamingSeconds : 0.0;
+        return "Texture uploads: " + std::format("{:.1f}", g_uploadStats.windowMBPerSecond) + " MB/s (" + std::format("{:.1f}", averageMBPerSecond) + " avg, "
+            + std::to_string(g_uploadStats.totalBytes / (1024 * 1024)) + " MB total), pending " + std::to_string(g_uploadStats.pendingCounts[(int)UploadPriority::UI]) + " UI / "
+            + std::to_string(g_uploadStats.pendingCounts[(int)UploadPriority::VISIBLE]) + " visible / " + std::to_string(g_uploadStats.pendingCounts[(int)UploadPriority::BACKGROUND])
+            + " other, peak " + std::format("{:.2f}", g_uploadStats.peakFrameMs) + " ms/frame\n";
+    }
+
+    /*
+    █▀▀ ▀█▀ █▀█ ▀█▀ █▀▀   █▀▀ █▀█ █▀▀ █ █ █▀▀
+    ▀▀█  █  █▀█  █  █▀▀   █   █▀█ █   █▀█ █▀▀
+    ▀▀▀  ▀  ▀ ▀  ▀  ▀▀▀   ▀▀▀ ▀ ▀ ▀▀▀ ▀ ▀ ▀▀▀ */
+
+#ifdef _DEBUG
+#define COUNT_SKIPPED_CALL(counter) g_skippedCalls.counter++
+#else
+#define COUNT_SKIPPED_CALL(counter)
+#endif
+
+    void InvalidateStateCache() {
+        g_stateCache = StateCache();
+        std::fill(std::begin(g_stateCache.textureUnits), std::end(g_stateCache.textureUnits), UNKNOWN_BINDING);
+        std::fill(std::begin(g_stateCache.capabilities), std::end(g_stateCache.capabilities), UNKNOWN_STATE);
+    }
+
+    void UseProgram(GLuint program) {
+        if (g_stateCache.program == program) {
+            COUNT_SKIPPED_CALL(programs);
+            return;
         }
-        pbo->SyncStart();
-        pbo->SetCustomValue(jobID);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        g_stateCache.program = program;
+        glUseProgram(program);
+    }
+
+    void BindVertexArray(GLuint vertexArray) {
+        if (g_stateCache.vertexArray == vertexArray) {
+            COUNT_SKIPPED_CALL(vertexArrays);
+            return;
+        }
+        g_stateCache.vertexArray = vertexArray;
+        glBindVertexArray(vertexArray);
+    }
+
+    void BindFrameBuffer(GLenum target, GLuint frameBuffer) {
+        bool drawChanged = (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) && g_stateCache.drawFrameBuffer != frameBuffer;
+        bool readChanged = (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) && g_stateCache.readFrameBuffer != frameBuffer;
+        if (!drawChanged && !readChanged) {
+            COUNT_SKIPPED_CALL(frameBuffers);
+            return;
+        }
+        // Only rebind the half that actually changed
+        if (drawChanged && readChanged) {
+            glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+        }
+        else {
+            glBindFramebuffer(drawChanged ? GL_DRAW_FRAMEBUFFER : GL_READ_FRAMEBUFFER, frameBuffer);
+        }
+        if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) {
+            g_stateCache.drawFrameBuffer = frameBuffer;
+        }
+        if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) {
+            g_stateCache.readFrameBuffer = frameBuffer;
+        }
+    }
+
+    void BindTextureUnit(GLuint unit, GLuint texture) {
+        if (unit < MAX_CACHED_TEXTURE_UNITS) {
+            if (g_stateCache.textureUnits[unit] == texture) {
+                COUNT_SKIPPED_CALL(textures);
+                return;
+            }
+            g_stateCache.textureUnits[unit] = texture;
+        }
+        glBindTextureUnit(unit, texture);
+    }
+
+    GLenum* GetCachedCapability(GLenum capability) {
+        switch (capability) {
+            case GL_BLEND:      return &g_stateCache.capabilities[(int)CachedCapability::BLEND];
+            case GL_CULL_FACE:  return &g_stateCache.capabilities[(int)CachedCapability::CULL_FACE];
+            case GL_DEPTH_TEST: return &g_stateCache.capabilities[(int)CachedCapability::DEPTH_TEST];
+            default:            return nullptr;
+        }
+    }
+
+    void Enable(GLenum capability) {
+        GLenum* cachedState = GetCachedCapability(capability);
+        if (cachedState && *cachedState == GL_TRUE) {
+            COUNT_SKIPPED_CALL(capabilities);
+            return;
+        }
+        if (cachedState) {
+            *cachedState = GL_TRUE;
+        }
+        glEnable(capability);
+    }
+
+    void Disable(GLenum capability) {
+        GLenum* cachedState = GetCachedCapability(capability);
+        if (cachedState && *cachedState == GL_FALSE) {
+            COUNT_SKIPPED_CALL(capabilities);
+            return;
+        }
+        if (cachedState) {
+            *cachedState = GL_FALSE;
+        }
+        glDisable(capability);
+    }
+
+    void SetDepthFunc(GLenum func) {
+        if (g_stateCache.depthFunc == func) {
+            COUNT_SKIPPED_CALL(depthAndBlend);
+            return;
+        }
+        g_stateCache.depthFunc = func;
+        glDepthFunc(func);
+    }
+
+    void SetDepthMask(bool enabled) {
+        GLenum mask = enabled ? GL_TRUE : GL_FALSE;
+        if (g_stateCache.depthMask == mask) {
+            COUNT_SKIPPED_CALL(depthAndBlend);
+            return;
+        }
+        g_stateCache.depthMask = mask;
+        glDepthMask(mask);
+    }
+
+    void SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor) {
+        if (g_stateCache.blendSourceFactor == sourceFactor && g_stateCache.blendDestinationFactor == destinationFactor) {
+            COUNT_SKIPPED_CALL(depthAndBlend);
+            return;
+        }
+        g_stateCache.blendSourceFactor = sourceFactor;
+        g_stateCache.blendDestinationFactor = destinationFactor;
+        glBlendFunc(sourceFactor, destinationFactor);
+    }
+
+    void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        glm::ivec4 viewport(x, y, width, height);
+        if (g_stateCache.viewport == viewport) {
+            COUNT_SKIPPED_CALL(viewports);
+            return;
+        }
+        g_stateCache.viewport = viewport;
+        glViewport(x, y, width, height);
+    }
+
+    std::string GetStateCacheText() {
+#ifdef _DEBUG
+        const StateCacheCounters& counters = g_lastFrameSkippedCalls;
+        std::string text = "State cache skipped\n";
+        text += "Programs: " + std::to_string(counters.programs) + "\n";
+        text += "Vertex arrays: " + std::to_string(counters.vertexArrays) + "\n";
+        text += "Framebuffers: " + std::to_string(counters.frameBuffers) + "\n";
+        text += "Textures: " + std::to_string(counters.textures) + "\n";
+        text += "Enables: " + std::to_string(counters.capabilities) + "\n";
+        text += "Depth/blend: " + std::to_string(counters.depthAndBlend) + "\n";
+        text += "Viewports: " + std::to_string(counters.viewports) + "\n";
+        return text;
+#else
+        return "";
+#endif
     }
-}
\ No newline at end of file
+}
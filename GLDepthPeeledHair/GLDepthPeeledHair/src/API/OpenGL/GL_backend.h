@@ -3,14 +3,17 @@
 #include <GLFW/glfw3.h>
 #include <string>
 #include <iostream>
-#include "Types/GL_pbo.hpp"
+#include "Types/GL_stagingRing.hpp"
 #include "Types/GL_texture.h"
 #include "../Types/Texture.h"
 
 enum class WindowedMode { WINDOWED, FULLSCREEN };
 
 namespace OpenGLBackend {
-    void Init(int width, int height, std::string title);
+    bool Init(int width, int height, std::string title);    // False when no usable GL context could be created
+    bool InitHeadless(int width, int height);
+    void CleanUp();
+    bool IsHeadless();
     void ToggleFullscreen();
     void SetWindowedMode(const WindowedMode& windowedMode);
     void ToggleFullscreen();
@@ -24,8 +27,27 @@ namespace OpenGLBackend {
     GLFWwindow* GetWindowPtr();
 
     // Textures
+    void SetTextureStagingSize(size_t size);  // Call before Init()
+    void SetTextureUploadBudget(size_t bytesPerFrame, double msPerFrame);
     void UpdateTextureBaking();
     void AllocateTextureMemory(Texture& texture);
     void ImmediateBake(QueuedTextureBake& queuedTextureBake);
-    void AsyncBakeQueuedTextureBake(QueuedTextureBake& queuedTextureBake);
+    bool AsyncBakeQueuedTextureBake(QueuedTextureBake& queuedTextureBake, size_t& byteBudget);
+    std::string GetTextureStagingText();
+    std::string GetTextureUploadText();
+
+    // State cache, shadows the bindings and fixed function state the renderer touches and drops calls that change nothing.
+    // Anything that binds behind its back must call InvalidateStateCache() before the cache is used again.
+    void InvalidateStateCache();
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vertexArray);
+    void BindFrameBuffer(GLenum target, GLuint frameBuffer);
+    void BindTextureUnit(GLuint unit, GLuint texture);
+    void Enable(GLenum capability);
+    void Disable(GLenum capability);
+    void SetDepthFunc(GLenum func);
+    void SetDepthMask(bool enabled);
+    void SetBlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    std::string GetStateCacheText(); // Skipped call counts for the last frame, empty outside debug builds
 }
\ No newline at end of file
@@ -0,0 +1,1300 @@
+#include "GL_capture.h"
+#include <glad/glad.h>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Types.h"
+#include "GL_util.hpp"
+#include "../../File/File.h"
+
+namespace OpenGLCapture {
+
+    enum class CaptureOp : uint32_t {
+        ENABLE,
+        DISABLE,
+        DEPTH_FUNC,
+        DEPTH_MASK,
+        BLEND_FUNC,
+        VIEWPORT,
+        CLEAR_COLOR,
+        CLEAR,
+        POINT_SIZE,
+        DRAW_BUFFER,
+        DRAW_BUFFERS,
+        READ_BUFFER,
+        ACTIVE_TEXTURE,
+        USE_PROGRAM,
+        BIND_TEXTURE,
+        BIND_TEXTURE_UNIT,
+        BIND_IMAGE_TEXTURE,
+        BIND_VERTEX_ARRAY,
+        BIND_FRAMEBUFFER,
+        BIND_BUFFER,
+        BIND_BUFFER_BASE,
+        BIND_BUFFER_RANGE,
+        UNIFORM_1I,
+        UNIFORM_1F,
+        UNIFORM_2F,
+        UNIFORM_3F,
+        UNIFORM_4F,
+        UNIFORM_FV,
+        UNIFORM_MATRIX_FV,
+        BUFFER_DATA,
+        BUFFER_SUB_DATA,
+        NAMED_BUFFER_SUB_DATA,
+        DRAW_ARRAYS,
+        DRAW_ELEMENTS,
+        DRAW_ELEMENTS_BASE_VERTEX,
+        DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE,
+        MULTI_DRAW_ELEMENTS_INDIRECT,
+        MULTI_DRAW_ELEMENTS_INDIRECT_COUNT,
+        DISPATCH_COMPUTE,
+        DISPATCH_COMPUTE_INDIRECT,
+        MEMORY_BARRIER,
+        BLIT_FRAMEBUFFER,
+        PROGRAM_UNIFORM_1I,
+        PROGRAM_UNIFORM_1F,
+        PROGRAM_UNIFORM_FV,
+        PROGRAM_UNIFORM_MATRIX_FV
+    };
+
+    struct OriginalEntryPoints {
+        PFNGLENABLEPROC enable = nullptr;
+        PFNGLDISABLEPROC disable = nullptr;
+        PFNGLDEPTHFUNCPROC depthFunc = nullptr;
+        PFNGLDEPTHMASKPROC depthMask = nullptr;
+        PFNGLBLENDFUNCPROC blendFunc = nullptr;
+        PFNGLVIEWPORTPROC viewport = nullptr;
+        PFNGLCLEARCOLORPROC clearColor = nullptr;
+        PFNGLCLEARPROC clear = nullptr;
+        PFNGLPOINTSIZEPROC pointSize = nullptr;
+        PFNGLDRAWBUFFERPROC drawBuffer = nullptr;
+        PFNGLDRAWBUFFERSPROC drawBuffers = nullptr;
+        PFNGLREADBUFFERPROC readBuffer = nullptr;
+        PFNGLACTIVETEXTUREPROC activeTexture = nullptr;
+        PFNGLUSEPROGRAMPROC useProgram = nullptr;
+        PFNGLBINDTEXTUREPROC bindTexture = nullptr;
+        PFNGLBINDTEXTUREUNITPROC bindTextureUnit = nullptr;
+        PFNGLBINDIMAGETEXTUREPROC bindImageTexture = nullptr;
+        PFNGLBINDVERTEXARRAYPROC bindVertexArray = nullptr;
+        PFNGLBINDFRAMEBUFFERPROC bindFramebuffer = nullptr;
+        PFNGLBINDBUFFERPROC bindBuffer = nullptr;
+        PFNGLBINDBUFFERBASEPROC bindBufferBase = nullptr;
+        PFNGLBINDBUFFERRANGEPROC bindBufferRange = nullptr;
+        PFNGLUNIFORM1IPROC uniform1i = nullptr;
+        PFNGLUNIFORM1FPROC uniform1f = nullptr;
+        PFNGLUNIFORM2FPROC uniform2f = nullptr;
+        PFNGLUNIFORM3FPROC uniform3f = nullptr;
+        PFNGLUNIFORM4FPROC uniform4f = nullptr;
+        PFNGLUNIFORM2FVPROC uniform2fv = nullptr;
+        PFNGLUNIFORM3FVPROC uniform3fv = nullptr;
+        PFNGLUNIFORM4FVPROC uniform4fv = nullptr;
+        PFNGLUNIFORMMATRIX2FVPROC uniformMatrix2fv = nullptr;
+        PFNGLUNIFORMMATRIX3FVPROC uniformMatrix3fv = nullptr;
+        PFNGLUNIFORMMATRIX4FVPROC uniformMatrix4fv = nullptr;
+        PFNGLBUFFERDATAPROC bufferData = nullptr;
+        PFNGLBUFFERSUBDATAPROC bufferSubData = nullptr;
+        PFNGLNAMEDBUFFERSUBDATAPROC namedBufferSubData = nullptr;
+        PFNGLDRAWARRAYSPROC drawArrays = nullptr;
+        PFNGLDRAWELEMENTSPROC drawElements = nullptr;
+        PFNGLDRAWELEMENTSBASEVERTEXPROC drawElementsBaseVertex = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDPROC drawElementsInstanced = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC drawElementsInstancedBaseVertex = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC drawElementsInstancedBaseVertexBaseInstance = nullptr;
+        PFNGLMULTIDRAWELEMENTSINDIRECTPROC multiDrawElementsIndirect = nullptr;
+        PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC multiDrawElementsIndirectCount = nullptr;
+        PFNGLDISPATCHCOMPUTEPROC dispatchCompute = nullptr;
+        PFNGLDISPATCHCOMPUTEINDIRECTPROC dispatchComputeIndirect = nullptr;
+        PFNGLMEMORYBARRIERPROC memoryBarrier = nullptr;
+        PFNGLBLITFRAMEBUFFERPROC blitFramebuffer = nullptr;
+        PFNGLPROGRAMUNIFORM1IPROC programUniform1i = nullptr;
+        PFNGLPROGRAMUNIFORM1FPROC programUniform1f = nullptr;
+        PFNGLPROGRAMUNIFORM2FVPROC programUniform2fv = nullptr;
+        PFNGLPROGRAMUNIFORM3FVPROC programUniform3fv = nullptr;
+        PFNGLPROGRAMUNIFORM4FVPROC programUniform4fv = nullptr;
+        PFNGLPROGRAMUNIFORMMATRIX2FVPROC programUniformMatrix2fv = nullptr;
+        PFNGLPROGRAMUNIFORMMATRIX3FVPROC programUniformMatrix3fv = nullptr;
+        PFNGLPROGRAMUNIFORMMATRIX4FVPROC programUniformMatrix4fv = nullptr;
+    } g_original;
+
+    const std::string g_captureDirectory = "res/captures/";
+
+    bool g_captureRequested = false;
+    bool g_capturing = false;
+    std::string g_capturePath = "";
+    GLCaptureData g_captureData;
+    GLuint g_currentProgram = 0;
+    std::unordered_set<GLuint> g_snapshottedTextures;
+    std::unordered_set<GLuint> g_snapshottedBuffers;
+    std::unordered_set<GLuint> g_snapshottedVertexArrays;
+    std::unordered_set<GLuint> g_snapshottedPrograms;
+    std::unordered_set<GLuint> g_snapshottedFrameBuffers;
+
+    GLCaptureData g_replayData;
+    GLuint g_replayCurrentProgram = 0;
+    std::unordered_map<GLuint, GLuint> g_replayTextures;
+    std::unordered_map<GLuint, GLuint> g_replayBuffers;
+    std::unordered_map<GLuint, GLuint> g_replayVertexArrays;
+    std::unordered_map<GLuint, GLuint> g_replayPrograms;
+    std::unordered_map<GLuint, GLuint> g_replayFrameBuffers;
+    std::unordered_map<GLuint, std::unordered_map<GLint, GLint>> g_replayUniformLocations;
+
+    void InstallHooks();
+    void UninstallHooks();
+    void RecordInitialState();
+
+    /*
+    █ █ ▀█▀ ▀█▀ █
+    █ █  █   █  █
+    ▀▀▀  ▀  ▀▀▀ ▀▀▀ */
+
+    uint64_t PackFloat(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float UnpackFloat(uint64_t value) {
+        uint32_t bits = (uint32_t)value;
+        float result = 0;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    uint64_t PackInt(GLint64 value) {
+        return (uint64_t)value;
+    }
+
+    GLint UnpackInt(uint64_t value) {
+        return (GLint)(GLint64)value;
+    }
+
+    int32_t AddBlob(const void* data, size_t size) {
+        if (!data) {
+            return -1;
+        }
+        std::vector<uint8_t>& blob = g_captureData.blobs.emplace_back(size);
+        std::memcpy(blob.data(), data, size);
+        return (int32_t)g_captureData.blobs.size() - 1;
+    }
+
+    void Record(CaptureOp op, std::initializer_list<uint64_t> args, int32_t blobIndex = -1) {
+        GLCapturedCall& call = g_captureData.calls.emplace_back();
+        call.opcode = (uint32_t)op;
+        call.argCount = (uint32_t)std::min(args.size(), std::size(call.args));
+        std::copy(args.begin(), args.begin() + call.argCount, call.args);
+        call.blobIndex = blobIndex;
+    }
+
+    bool GetReadbackFormat(GLenum internalFormat, GLenum& format, GLenum& type, int& bytesPerPixel) {
+        switch (internalFormat) {
+            case GL_RGBA8: case GL_SRGB8_ALPHA8: case GL_RGBA:   format = GL_RGBA; type = GL_UNSIGNED_BYTE; bytesPerPixel = 4; return true;
+            case GL_RGB8: case GL_SRGB8: case GL_RGB:            format = GL_RGB; type = GL_UNSIGNED_BYTE; bytesPerPixel = 3; return true;
+            case GL_RG8:                                         format = GL_RG; type = GL_UNSIGNED_BYTE; bytesPerPixel = 2; return true;
+            case GL_R8: case GL_RED:                             format = GL_RED; type = GL_UNSIGNED_BYTE; bytesPerPixel = 1; return true;
+            case GL_R16F:                                        format = GL_RED; type = GL_HALF_FLOAT; bytesPerPixel = 2; return true;
+            case GL_RG16F:                                       format = GL_RG; type = GL_HALF_FLOAT; bytesPerPixel = 4; return true;
+            case GL_RGBA16F:                                     format = GL_RGBA; type = GL_HALF_FLOAT; bytesPerPixel = 8; return true;
+            case GL_R32F:                                        format = GL_RED; type = GL_FLOAT; bytesPerPixel = 4; return true;
+            case GL_RG32F:                                       format = GL_RG; type = GL_FLOAT; bytesPerPixel = 8; return true;
+            case GL_RGBA32F:                                     format = GL_RGBA; type = GL_FLOAT; bytesPerPixel = 16; return true;
+            case GL_R32UI:                                       format = GL_RED_INTEGER; type = GL_UNSIGNED_INT; bytesPerPixel = 4; return true;
+            case GL_DEPTH_COMPONENT32F:                          format = GL_DEPTH_COMPONENT; type = GL_FLOAT; bytesPerPixel = 4; return true;
+            case GL_DEPTH24_STENCIL8:                            format = GL_DEPTH_STENCIL; type = GL_UNSIGNED_INT_24_8; bytesPerPixel = 4; return true;
+            case GL_DEPTH32F_STENCIL8:                           format = GL_DEPTH_STENCIL; type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV; bytesPerPixel = 8; return true;
+            default: return false;
+        }
+    }
+
+    void GetUniformTypeInfo(GLenum type, int& componentCount, bool& isFloat, bool& isUnsigned) {
+        isFloat = false;
+        isUnsigned = false;
+        switch (type) {
+            case GL_FLOAT:        componentCount = 1; isFloat = true; return;
+            case GL_FLOAT_VEC2:   componentCount = 2; isFloat = true; return;
+            case GL_FLOAT_VEC3:   componentCount = 3; isFloat = true; return;
+            case GL_FLOAT_VEC4:   componentCount = 4; isFloat = true; return;
+            case GL_FLOAT_MAT2:   componentCount = 4; isFloat = true; return;
+            case GL_FLOAT_MAT3:   componentCount = 9; isFloat = true; return;
+            case GL_FLOAT_MAT4:   componentCount = 16; isFloat = true; return;
+            case GL_INT_VEC2: case GL_BOOL_VEC2: componentCount = 2; return;
+            case GL_INT_VEC3: case GL_BOOL_VEC3: componentCount = 3; return;
+            case GL_INT_VEC4: case GL_BOOL_VEC4: componentCount = 4; return;
+            case GL_UNSIGNED_INT: componentCount = 1; isUnsigned = true; return;
+            default:              componentCount = 1; return; // int, bool, samplers and images
+        }
+    }
+
+    /*
+    █▀▀ █▀█ █▀█ █▀█ █▀▀ █ █ █▀█ ▀█▀ █▀▀
+    ▀▀█ █ █ █▀█ █▀▀ ▀▀█ █▀█ █ █  █  ▀▀█
+    ▀▀▀ ▀ ▀ ▀ ▀ ▀   ▀▀▀ ▀ ▀ ▀▀▀  ▀  ▀▀▀ */
+
+    void SnapshotTexture(GLuint name) {
+        if (name == 0 || g_snapshottedTextures.contains(name) || !glIsTexture(name)) {
+            return;
+        }
+        g_snapshottedTextures.insert(name);
+        GLint target = 0;
+        glGetTextureParameteriv(name, GL_TEXTURE_TARGET, &target);
+        if (target != GL_TEXTURE_2D) {
+            std::cout << "OpenGLCapture::SnapshotTexture() skipped texture " << name << " because only 2D textures are supported\n";
+            return;
+        }
+        GLint internalFormat = 0;
+        GLint width = 0;
+        GLint height = 0;
+        GLint compressed = 0;
+        glGetTextureLevelParameteriv(name, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        glGetTextureLevelParameteriv(name, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTextureLevelParameteriv(name, 0, GL_TEXTURE_HEIGHT, &height);
+        glGetTextureLevelParameteriv(name, 0, GL_TEXTURE_COMPRESSED, &compressed);
+
+        GLCapturedTexture& texture = g_captureData.textures.emplace_back();
+        texture.name = name;
+        texture.internalFormat = internalFormat;
+        texture.width = width;
+        texture.height = height;
+        texture.compressed = compressed;
+        glGetTextureParameteriv(name, GL_TEXTURE_MIN_FILTER, (GLint*)&texture.minFilter);
+        glGetTextureParameteriv(name, GL_TEXTURE_MAG_FILTER, (GLint*)&texture.magFilter);
+        glGetTextureParameteriv(name, GL_TEXTURE_WRAP_S, (GLint*)&texture.wrapS);
+        glGetTextureParameteriv(name, GL_TEXTURE_WRAP_T, (GLint*)&texture.wrapT);
+
+        GLint levelCount = 0;
+        glGetTextureParameteriv(name, GL_TEXTURE_IMMUTABLE_LEVELS, &levelCount);
+        if (levelCount == 0) {
+            GLint levelWidth = width;
+            while (levelWidth > 0 && levelCount < 16) {
+                levelCount++;
+                glGetTextureLevelParameteriv(name, levelCount, GL_TEXTURE_WIDTH, &levelWidth);
+            }
+        }
+        GLenum format = 0;
+        GLenum type = 0;
+        int bytesPerPixel = 0;
+        if (!compressed && !GetReadbackFormat(internalFormat, format, type, bytesPerPixel)) {
+            std::cout << "OpenGLCapture::SnapshotTexture() failed because internal format " << OpenGLUtil::GetGLInternalFormatAsString(internalFormat) << " can't be read back, texture " << name << " will be uninitialized\n";
+            texture.levels.resize(1);
+            return;
+        }
+        texture.levels.resize(levelCount);
+        for (int level = 0; level < levelCount; level++) {
+            std::vector<uint8_t>& levelData = texture.levels[level];
+            if (compressed) {
+                GLint imageSize = 0;
+                glGetTextureLevelParameteriv(name, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &imageSize);
+                levelData.resize(imageSize);
+                glGetCompressedTextureImage(name, level, imageSize, levelData.data());
+            }
+            else {
+                GLint levelWidth = 0;
+                GLint levelHeight = 0;
+                glGetTextureLevelParameteriv(name, level, GL_TEXTURE_WIDTH, &levelWidth);
+                glGetTextureLevelParameteriv(name, level, GL_TEXTURE_HEIGHT, &levelHeight);
+                levelData.resize((size_t)levelWidth * levelHeight * bytesPerPixel);
+                glGetTextureImage(name, level, format, type, (GLsizei)levelData.size(), levelData.data());
+            }
+        }
+    }
+
+    void SnapshotBuffer(GLuint name) {
+        if (name == 0 || g_snapshottedBuffers.contains(name) || !glIsBuffer(name)) {
+            return;
+        }
+        g_snapshottedBuffers.insert(name);
+        GLCapturedBuffer& buffer = g_captureData.buffers.emplace_back();
+        buffer.name = name;
+        GLint64 size = 0;
+        GLint mapped = 0;
+        GLint accessFlags = 0;
+        glGetNamedBufferParameteri64v(name, GL_BUFFER_SIZE, &size);
+        glGetNamedBufferParameteriv(name, GL_BUFFER_MAPPED, &mapped);
+        glGetNamedBufferParameteriv(name, GL_BUFFER_ACCESS_FLAGS, &accessFlags);
+        buffer.size = size;
+        // Reading a buffer that is mapped without the persistent bit is an error, the replay gets zeros instead
+        if (size > 0 && (!mapped || (accessFlags & GL_MAP_PERSISTENT_BIT))) {
+            buffer.data.resize(size);
+            glGetNamedBufferSubData(name, 0, size, buffer.data.data());
+        }
+    }
+
+    // Expects the vertex array to be bound, it is only ever snapshotted straight after its bind is forwarded
+    void SnapshotVertexArray(GLuint name) {
+        if (name == 0 || g_snapshottedVertexArrays.contains(name)) {
+            return;
+        }
+        g_snapshottedVertexArrays.insert(name);
+        GLCapturedVertexArray& vertexArray = g_captureData.vertexArrays.emplace_back();
+        vertexArray.name = name;
+        GLint elementBuffer = 0;
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+        vertexArray.elementBuffer = elementBuffer;
+        SnapshotBuffer(elementBuffer);
+        for (GLuint i = 0; i < 16; i++) {
+            GLCapturedVertexAttribute& attribute = vertexArray.attributes[i];
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &attribute.enabled);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attribute.size);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &attribute.type);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &attribute.normalized);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &attribute.integer);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_RELATIVE_OFFSET, &attribute.relativeOffset);
+            glGetVertexAttribIuiv(i, GL_VERTEX_ATTRIB_BINDING, &attribute.bindingIndex);
+
+            GLCapturedVertexBinding& binding = vertexArray.bindings[i];
+            GLint64 offset = 0;
+            glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, i, (GLint*)&binding.buffer);
+            glGetIntegeri_v(GL_VERTEX_BINDING_STRIDE, i, (GLint*)&binding.stride);
+            glGetIntegeri_v(GL_VERTEX_BINDING_DIVISOR, i, (GLint*)&binding.divisor);
+            glGetInteger64i_v(GL_VERTEX_BINDING_OFFSET, i, &offset);
+            binding.offset = offset;
+            SnapshotBuffer(binding.buffer);
+        }
+    }
+
+    void SnapshotProgram(GLuint name) {
+        if (name == 0 || g_snapshottedPrograms.contains(name) || !glIsProgram(name)) {
+            return;
+        }
+        g_snapshottedPrograms.insert(name);
+        GLCapturedProgram& program = g_captureData.programs.emplace_back();
+        program.name = name;
+
+        // Shader objects stay attached after linking, so their (already #include expanded) source is still queryable
+        GLuint shaders[8];
+        GLsizei shaderCount = 0;
+        glGetAttachedShaders(name, 8, &shaderCount, shaders);
+        for (int i = 0; i < shaderCount; i++) {
+            GLint type = 0;
+            GLint sourceLength = 0;
+            glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+            glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &sourceLength);
+            GLCapturedShader& shader = program.shaders.emplace_back();
+            shader.type = type;
+            shader.source.resize(sourceLength);
+            glGetShaderSource(shaders[i], sourceLength, nullptr, shader.source.data());
+            if (sourceLength > 0) {
+                shader.source.resize(sourceLength - 1); // Drop the null terminator
+            }
+        }
+        // Uniforms set before the capture started persist in the program, so record their current values too
+        GLint uniformCount = 0;
+        glGetProgramiv(name, GL_ACTIVE_UNIFORMS, &uniformCount);
+        for (int i = 0; i < uniformCount; i++) {
+            char uniformName[256];
+            GLsizei nameLength = 0;
+            GLint arraySize = 0;
+            GLenum type = 0;
+            glGetActiveUniform(name, i, sizeof(uniformName), &nameLength, &arraySize, &type, uniformName);
+            std::string baseName(uniformName, nameLength);
+            if (baseName.size() > 3 && baseName.ends_with("[0]")) {
+                baseName.resize(baseName.size() - 3);
+            }
+            int componentCount = 1;
+            bool isFloat = false;
+            bool isUnsigned = false;
+            GetUniformTypeInfo(type, componentCount, isFloat, isUnsigned);
+            for (int element = 0; element < arraySize; element++) {
+                std::string elementName = arraySize > 1 ? baseName + "[" + std::to_string(element) + "]" : std::string(uniformName, nameLength);
+                GLint location = glGetUniformLocation(name, elementName.c_str());
+                if (location == -1) {
+                    continue; // Block members
+                }
+                GLCapturedUniform& uniform = program.uniforms.emplace_back();
+                uniform.name = elementName;
+                uniform.location = location;
+                uniform.type = type;
+                uniform.value.resize(componentCount * 4);
+                if (isFloat) {
+                    glGetUniformfv(name, location, (GLfloat*)uniform.value.data());
+                }
+                else if (isUnsigned) {
+                    glGetUniformuiv(name, location, (GLuint*)uniform.value.data());
+                }
+                else {
+                    glGetUniformiv(name, location, (GLint*)uniform.value.data());
+                }
+            }
+        }
+    }
+
+    void SnapshotFrameBuffer(GLuint name) {
+        if (name == 0 || g_snapshottedFrameBuffers.contains(name) || !glIsFramebuffer(name)) {
+            return;
+        }
+        g_snapshottedFrameBuffers.insert(name);
+        GLCapturedFrameBuffer& frameBuffer = g_captureData.frameBuffers.emplace_back();
+        frameBuffer.name = name;
+        auto getAttachedTexture = [name](GLenum attachment, uint32_t& texture, uint32_t* level) {
+            GLint objectType = GL_NONE;
+            glGetNamedFramebufferAttachmentParameteriv(name, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType);
+            if (objectType != GL_TEXTURE) {
+                return;
+            }
+            glGetNamedFramebufferAttachmentParameteriv(name, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, (GLint*)&texture);
+            if (level) {
+                glGetNamedFramebufferAttachmentParameteriv(name, attachment, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, (GLint*)level);
+            }
+            SnapshotTexture(texture);
+        };
+        for (int i = 0; i < 8; i++) {
+            getAttachedTexture(GL_COLOR_ATTACHMENT0 + i, frameBuffer.colorAttachments[i], &frameBuffer.colorAttachmentLevels[i]);
+        }
+        getAttachedTexture(GL_DEPTH_ATTACHMENT, frameBuffer.depthAttachment, nullptr);
+        getAttachedTexture(GL_STENCIL_ATTACHMENT, frameBuffer.stencilAttachment, nullptr);
+
+        // Draw and read buffers are per framebuffer state with no DSA query, so bind it briefly behind the renderer's back
+        GLint previousDrawFrameBuffer = 0;
+        GLint previousReadFrameBuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDrawFrameBuffer);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFrameBuffer);
+        g_original.bindFramebuffer(GL_DRAW_FRAMEBUFFER, name);
+        g_original.bindFramebuffer(GL_READ_FRAMEBUFFER, name);
+        for (int i = 0; i < 8; i++) {
+            glGetIntegerv(GL_DRAW_BUFFER0 + i, (GLint*)&frameBuffer.drawBuffers[i]);
+        }
+        glGetIntegerv(GL_READ_BUFFER, (GLint*)&frameBuffer.readBuffer);
+        g_original.bindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDrawFrameBuffer);
+        g_original.bindFramebuffer(GL_READ_FRAMEBUFFER, previousReadFrameBuffer);
+    }
+
+    /*
+    █ █ █▀█ █▀█ █ █ █▀▀
+    █▀█ █ █ █ █ █▀▄ ▀▀█
+    ▀ ▀ ▀▀▀ ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    void APIENTRY Enable(GLenum cap) {
+        Record(CaptureOp::ENABLE, { cap });
+        g_original.enable(cap);
+    }
+
+    void APIENTRY Disable(GLenum cap) {
+        Record(CaptureOp::DISABLE, { cap });
+        g_original.disable(cap);
+    }
+
+    void APIENTRY DepthFunc(GLenum func) {
+        Record(CaptureOp::DEPTH_FUNC, { func });
+        g_original.depthFunc(func);
+    }
+
+    void APIENTRY DepthMask(GLboolean flag) {
+        Record(CaptureOp::DEPTH_MASK, { flag });
+        g_original.depthMask(flag);
+    }
+
+    void APIENTRY BlendFunc(GLenum sfactor, GLenum dfactor) {
+        Record(CaptureOp::BLEND_FUNC, { sfactor, dfactor });
+        g_original.blendFunc(sfactor, dfactor);
+    }
+
+    void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        Record(CaptureOp::VIEWPORT, { PackInt(x), PackInt(y), PackInt(width), PackInt(height) });
+        g_original.viewport(x, y, width, height);
+    }
+
+    void APIENTRY ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+        Record(CaptureOp::CLEAR_COLOR, { PackFloat(r), PackFloat(g), PackFloat(b), PackFloat(a) });
+        g_original.clearColor(r, g, b, a);
+    }
+
+    void APIENTRY Clear(GLbitfield mask) {
+        Record(CaptureOp::CLEAR, { mask });
+        g_original.clear(mask);
+    }
+
+    void APIENTRY PointSize(GLfloat size) {
+        Record(CaptureOp::POINT_SIZE, { PackFloat(size) });
+        g_original.pointSize(size);
+    }
+
+    void APIENTRY DrawBuffer(GLenum buffer) {
+        Record(CaptureOp::DRAW_BUFFER, { buffer });
+        g_original.drawBuffer(buffer);
+    }
+
+    void APIENTRY DrawBuffers(GLsizei count, const GLenum* buffers) {
+        Record(CaptureOp::DRAW_BUFFERS, { PackInt(count) }, AddBlob(buffers, count * sizeof(GLenum)));
+        g_original.drawBuffers(count, buffers);
+    }
+
+    void APIENTRY ReadBuffer(GLenum source) {
+        Record(CaptureOp::READ_BUFFER, { source });
+        g_original.readBuffer(source);
+    }
+
+    void APIENTRY ActiveTexture(GLenum texture) {
+        Record(CaptureOp::ACTIVE_TEXTURE, { texture });
+        g_original.activeTexture(texture);
+    }
+
+    void APIENTRY UseProgram(GLuint program) {
+        SnapshotProgram(program);
+        Record(CaptureOp::USE_PROGRAM, { program });
+        g_currentProgram = program;
+        g_original.useProgram(program);
+    }
+
+    void APIENTRY BindTexture(GLenum target, GLuint texture) {
+        Record(CaptureOp::BIND_TEXTURE, { target, texture });
+        g_original.bindTexture(target, texture);
+        SnapshotTexture(texture);
+    }
+
+    void APIENTRY BindTextureUnit(GLuint unit, GLuint texture) {
+        Record(CaptureOp::BIND_TEXTURE_UNIT, { unit, texture });
+        g_original.bindTextureUnit(unit, texture);
+        SnapshotTexture(texture);
+    }
+
+    void APIENTRY BindImageTexture(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format) {
+        Record(CaptureOp::BIND_IMAGE_TEXTURE, { unit, texture, PackInt(level), layered, PackInt(layer), access, format });
+        g_original.bindImageTexture(unit, texture, level, layered, layer, access, format);
+        SnapshotTexture(texture);
+    }
+
+    void APIENTRY BindVertexArray(GLuint vertexArray) {
+        Record(CaptureOp::BIND_VERTEX_ARRAY, { vertexArray });
+        g_original.bindVertexArray(vertexArray);
+        SnapshotVertexArray(vertexArray);
+    }
+
+    void APIENTRY BindFramebuffer(GLenum target, GLuint frameBuffer) {
+        Record(CaptureOp::BIND_FRAMEBUFFER, { target, frameBuffer });
+        g_original.bindFramebuffer(target, frameBuffer);
+        SnapshotFrameBuffer(frameBuffer);
+    }
+
+    void APIENTRY BindBuffer(GLenum target, GLuint buffer) {
+        Record(CaptureOp::BIND_BUFFER, { target, buffer });
+        g_original.bindBuffer(target, buffer);
+        SnapshotBuffer(buffer);
+    }
+
+    void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+        Record(CaptureOp::BIND_BUFFER_BASE, { target, index, buffer });
+        g_original.bindBufferBase(target, index, buffer);
+        SnapshotBuffer(buffer);
+    }
+
+    void APIENTRY BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+        Record(CaptureOp::BIND_BUFFER_RANGE, { target, index, buffer, (uint64_t)offset, (uint64_t)size });
+        g_original.bindBufferRange(target, index, buffer, offset, size);
+        SnapshotBuffer(buffer);
+    }
+
+    void APIENTRY Uniform1i(GLint location, GLint v0) {
+        Record(CaptureOp::UNIFORM_1I, { PackInt(location), PackInt(v0) });
+        g_original.uniform1i(location, v0);
+    }
+
+    void APIENTRY Uniform1f(GLint location, GLfloat v0) {
+        Record(CaptureOp::UNIFORM_1F, { PackInt(location), PackFloat(v0) });
+        g_original.uniform1f(location, v0);
+    }
+
+    void APIENTRY Uniform2f(GLint location, GLfloat v0, GLfloat v1) {
+        Record(CaptureOp::UNIFORM_2F, { PackInt(location), PackFloat(v0), PackFloat(v1) });
+        g_original.uniform2f(location, v0, v1);
+    }
+
+    void APIENTRY Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+        Record(CaptureOp::UNIFORM_3F, { PackInt(location), PackFloat(v0), PackFloat(v1), PackFloat(v2) });
+        g_original.uniform3f(location, v0, v1, v2);
+    }
+
+    void APIENTRY Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+        Record(CaptureOp::UNIFORM_4F, { PackInt(location), PackFloat(v0), PackFloat(v1), PackFloat(v2), PackFloat(v3) });
+        g_original.uniform4f(location, v0, v1, v2, v3);
+    }
+
+    void APIENTRY Uniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_FV, { PackInt(location), 2, PackInt(count) }, AddBlob(value, count * 2 * sizeof(GLfloat)));
+        g_original.uniform2fv(location, count, value);
+    }
+
+    void APIENTRY Uniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_FV, { PackInt(location), 3, PackInt(count) }, AddBlob(value, count * 3 * sizeof(GLfloat)));
+        g_original.uniform3fv(location, count, value);
+    }
+
+    void APIENTRY Uniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_FV, { PackInt(location), 4, PackInt(count) }, AddBlob(value, count * 4 * sizeof(GLfloat)));
+        g_original.uniform4fv(location, count, value);
+    }
+
+    void APIENTRY UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_MATRIX_FV, { PackInt(location), 2, PackInt(count), transpose }, AddBlob(value, count * 4 * sizeof(GLfloat)));
+        g_original.uniformMatrix2fv(location, count, transpose, value);
+    }
+
+    void APIENTRY UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_MATRIX_FV, { PackInt(location), 3, PackInt(count), transpose }, AddBlob(value, count * 9 * sizeof(GLfloat)));
+        g_original.uniformMatrix3fv(location, count, transpose, value);
+    }
+
+    void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        Record(CaptureOp::UNIFORM_MATRIX_FV, { PackInt(location), 4, PackInt(count), transpose }, AddBlob(value, count * 16 * sizeof(GLfloat)));
+        g_original.uniformMatrix4fv(location, count, transpose, value);
+    }
+
+    void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        Record(CaptureOp::BUFFER_DATA, { target, (uint64_t)size, usage }, AddBlob(data, size));
+        g_original.bufferData(target, size, data, usage);
+    }
+
+    void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        Record(CaptureOp::BUFFER_SUB_DATA, { target, (uint64_t)offset, (uint64_t)size }, AddBlob(data, size));
+        g_original.bufferSubData(target, offset, size, data);
+    }
+
+    void APIENTRY NamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+        SnapshotBuffer(buffer);
+        Record(CaptureOp::NAMED_BUFFER_SUB_DATA, { buffer, (uint64_t)offset, (uint64_t)size }, AddBlob(data, size));
+        g_original.namedBufferSubData(buffer, offset, size, data);
+    }
+
+    void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count) {
+        Record(CaptureOp::DRAW_ARRAYS, { mode, PackInt(first), PackInt(count) });
+        g_original.drawArrays(mode, first, count);
+    }
+
+    // Index pointers are offsets into the bound element buffer, core profile has no client side arrays
+    void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        Record(CaptureOp::DRAW_ELEMENTS, { mode, PackInt(count), type, (uint64_t)indices });
+        g_original.drawElements(mode, count, type, indices);
+    }
+
+    void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex) {
+        Record(CaptureOp::DRAW_ELEMENTS_BASE_VERTEX, { mode, PackInt(count), type, (uint64_t)indices, PackInt(baseVertex) });
+        g_original.drawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    }
+
+    void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount) {
+        Record(CaptureOp::DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE, { mode, PackInt(count), type, (uint64_t)indices, PackInt(instanceCount), 0, 0 });
+        g_original.drawElementsInstanced(mode, count, type, indices, instanceCount);
+    }
+
+    void APIENTRY DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLint baseVertex) {
+        Record(CaptureOp::DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE, { mode, PackInt(count), type, (uint64_t)indices, PackInt(instanceCount), PackInt(baseVertex), 0 });
+        g_original.drawElementsInstancedBaseVertex(mode, count, type, indices, instanceCount, baseVertex);
+    }
+
+    void APIENTRY DrawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLint baseVertex, GLuint baseInstance) {
+        Record(CaptureOp::DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE, { mode, PackInt(count), type, (uint64_t)indices, PackInt(instanceCount), PackInt(baseVertex), baseInstance });
+        g_original.drawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instanceCount, baseVertex, baseInstance);
+    }
+
+    void APIENTRY MultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride) {
+        Record(CaptureOp::MULTI_DRAW_ELEMENTS_INDIRECT, { mode, type, (uint64_t)indirect, PackInt(drawCount), PackInt(stride) });
+        g_original.multiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+    }
+
+    void APIENTRY MultiDrawElementsIndirectCount(GLenum mode, GLenum type, const void* indirect, GLintptr drawCount, GLsizei maxDrawCount, GLsizei stride) {
+        Record(CaptureOp::MULTI_DRAW_ELEMENTS_INDIRECT_COUNT, { mode, type, (uint64_t)indirect, (uint64_t)drawCount, PackInt(maxDrawCount), PackInt(stride) });
+        g_original.multiDrawElementsIndirectCount(mode, type, indirect, drawCount, maxDrawCount, stride);
+    }
+
+    void APIENTRY DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) {
+        Record(CaptureOp::DISPATCH_COMPUTE, { groupsX, groupsY, groupsZ });
+        g_original.dispatchCompute(groupsX, groupsY, groupsZ);
+    }
+
+    void APIENTRY DispatchComputeIndirect(GLintptr indirect) {
+        Record(CaptureOp::DISPATCH_COMPUTE_INDIRECT, { (uint64_t)indirect });
+        g_original.dispatchComputeIndirect(indirect);
+    }
+
+    void APIENTRY MemoryBarrier(GLbitfield barriers) {
+        Record(CaptureOp::MEMORY_BARRIER, { barriers });
+        g_original.memoryBarrier(barriers);
+    }
+
+    void APIENTRY BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+        Record(CaptureOp::BLIT_FRAMEBUFFER, { PackInt(srcX0), PackInt(srcY0), PackInt(srcX1), PackInt(srcY1), PackInt(dstX0), PackInt(dstY0), PackInt(dstX1), PackInt(dstY1), mask, filter });
+        g_original.blitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    }
+
+    // Shader setters write through the DSA entry points, the program is named explicitly so it needs no bind to replay
+    void APIENTRY ProgramUniform1i(GLuint program, GLint location, GLint v0) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_1I, { program, PackInt(location), PackInt(v0) });
+        g_original.programUniform1i(program, location, v0);
+    }
+
+    void APIENTRY ProgramUniform1f(GLuint program, GLint location, GLfloat v0) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_1F, { program, PackInt(location), PackFloat(v0) });
+        g_original.programUniform1f(program, location, v0);
+    }
+
+    void APIENTRY ProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_FV, { program, PackInt(location), 2, PackInt(count) }, AddBlob(value, count * 2 * sizeof(GLfloat)));
+        g_original.programUniform2fv(program, location, count, value);
+    }
+
+    void APIENTRY ProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_FV, { program, PackInt(location), 3, PackInt(count) }, AddBlob(value, count * 3 * sizeof(GLfloat)));
+        g_original.programUniform3fv(program, location, count, value);
+    }
+
+    void APIENTRY ProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_FV, { program, PackInt(location), 4, PackInt(count) }, AddBlob(value, count * 4 * sizeof(GLfloat)));
+        g_original.programUniform4fv(program, location, count, value);
+    }
+
+    void APIENTRY ProgramUniformMatrix2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_MATRIX_FV, { program, PackInt(location), 2, PackInt(count), transpose }, AddBlob(value, count * 4 * sizeof(GLfloat)));
+        g_original.programUniformMatrix2fv(program, location, count, transpose, value);
+    }
+
+    void APIENTRY ProgramUniformMatrix3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_MATRIX_FV, { program, PackInt(location), 3, PackInt(count), transpose }, AddBlob(value, count * 9 * sizeof(GLfloat)));
+        g_original.programUniformMatrix3fv(program, location, count, transpose, value);
+    }
+
+    void APIENTRY ProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        SnapshotProgram(program);
+        Record(CaptureOp::PROGRAM_UNIFORM_MATRIX_FV, { program, PackInt(location), 4, PackInt(count), transpose }, AddBlob(value, count * 16 * sizeof(GLfloat)));
+        g_original.programUniformMatrix4fv(program, location, count, transpose, value);
+    }
+
+    void InstallHooks() {
+        OpenGLUtil::HookEntryPoint(glad_glEnable, g_original.enable, Enable);
+        OpenGLUtil::HookEntryPoint(glad_glDisable, g_original.disable, Disable);
+        OpenGLUtil::HookEntryPoint(glad_glDepthFunc, g_original.depthFunc, DepthFunc);
+        OpenGLUtil::HookEntryPoint(glad_glDepthMask, g_original.depthMask, DepthMask);
+        OpenGLUtil::HookEntryPoint(glad_glBlendFunc, g_original.blendFunc, BlendFunc);
+        OpenGLUtil::HookEntryPoint(glad_glViewport, g_original.viewport, Viewport);
+        OpenGLUtil::HookEntryPoint(glad_glClearColor, g_original.clearColor, ClearColor);
+        OpenGLUtil::HookEntryPoint(glad_glClear, g_original.clear, Clear);
+        OpenGLUtil::HookEntryPoint(glad_glPointSize, g_original.pointSize, PointSize);
+        OpenGLUtil::HookEntryPoint(glad_glDrawBuffer, g_original.drawBuffer, DrawBuffer);
+        OpenGLUtil::HookEntryPoint(glad_glDrawBuffers, g_original.drawBuffers, DrawBuffers);
+        OpenGLUtil::HookEntryPoint(glad_glReadBuffer, g_original.readBuffer, ReadBuffer);
+        OpenGLUtil::HookEntryPoint(glad_glActiveTexture, g_original.activeTexture, ActiveTexture);
+        OpenGLUtil::HookEntryPoint(glad_glUseProgram, g_original.useProgram, UseProgram);
+        OpenGLUtil::HookEntryPoint(glad_glBindTexture, g_original.bindTexture, BindTexture);
+        OpenGLUtil::HookEntryPoint(glad_glBindTextureUnit, g_original.bindTextureUnit, BindTextureUnit);
+        OpenGLUtil::HookEntryPoint(glad_glBindImageTexture, g_original.bindImageTexture, BindImageTexture);
+        OpenGLUtil::HookEntryPoint(glad_glBindVertexArray, g_original.bindVertexArray, BindVertexArray);
+        OpenGLUtil::HookEntryPoint(glad_glBindFramebuffer, g_original.bindFramebuffer, BindFramebuffer);
+        OpenGLUtil::HookEntryPoint(glad_glBindBuffer, g_original.bindBuffer, BindBuffer);
+        OpenGLUtil::HookEntryPoint(glad_glBindBufferBase, g_original.bindBufferBase, BindBufferBase);
+        OpenGLUtil::HookEntryPoint(glad_glBindBufferRange, g_original.bindBufferRange, BindBufferRange);
+        OpenGLUtil::HookEntryPoint(glad_glUniform1i, g_original.uniform1i, Uniform1i);
+        OpenGLUtil::HookEntryPoint(glad_glUniform1f, g_original.uniform1f, Uniform1f);
+        OpenGLUtil::HookEntryPoint(glad_glUniform2f, g_original.uniform2f, Uniform2f);
+        OpenGLUtil::HookEntryPoint(glad_glUniform3f, g_original.uniform3f, Uniform3f);
+        OpenGLUtil::HookEntryPoint(glad_glUniform4f, g_original.uniform4f, Uniform4f);
+        OpenGLUtil::HookEntryPoint(glad_glUniform2fv, g_original.uniform2fv, Uniform2fv);
+        OpenGLUtil::HookEntryPoint(glad_glUniform3fv, g_original.uniform3fv, Uniform3fv);
+        OpenGLUtil::HookEntryPoint(glad_glUniform4fv, g_original.uniform4fv, Uniform4fv);
+        OpenGLUtil::HookEntryPoint(glad_glUniformMatrix2fv, g_original.uniformMatrix2fv, UniformMatrix2fv);
+        OpenGLUtil::HookEntryPoint(glad_glUniformMatrix3fv, g_original.uniformMatrix3fv, UniformMatrix3fv);
+        OpenGLUtil::HookEntryPoint(glad_glUniformMatrix4fv, g_original.uniformMatrix4fv, UniformMatrix4fv);
+        OpenGLUtil::HookEntryPoint(glad_glBufferData, g_original.bufferData, BufferData);
+        OpenGLUtil::HookEntryPoint(glad_glBufferSubData, g_original.bufferSubData, BufferSubData);
+        OpenGLUtil::HookEntryPoint(glad_glNamedBufferSubData, g_original.namedBufferSubData, NamedBufferSubData);
+        OpenGLUtil::HookEntryPoint(glad_glDrawArrays, g_original.drawArrays, DrawArrays);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElements, g_original.drawElements, DrawElements);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsBaseVertex, g_original.drawElementsBaseVertex, DrawElementsBaseVertex);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstanced, g_original.drawElementsInstanced, DrawElementsInstanced);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstancedBaseVertex, g_original.drawElementsInstancedBaseVertex, DrawElementsInstancedBaseVertex);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstancedBaseVertexBaseInstance, g_original.drawElementsInstancedBaseVertexBaseInstance, DrawElementsInstancedBaseVertexBaseInstance);
+        OpenGLUtil::HookEntryPoint(glad_glMultiDrawElementsIndirect, g_original.multiDrawElementsIndirect, MultiDrawElementsIndirect);
+        OpenGLUtil::HookEntryPoint(glad_glMultiDrawElementsIndirectCount, g_original.multiDrawElementsIndirectCount, MultiDrawElementsIndirectCount);
+        OpenGLUtil::HookEntryPoint(glad_glDispatchCompute, g_original.dispatchCompute, DispatchCompute);
+        OpenGLUtil::HookEntryPoint(glad_glDispatchComputeIndirect, g_original.dispatchComputeIndirect, DispatchComputeIndirect);
+        OpenGLUtil::HookEntryPoint(glad_glMemoryBarrier, g_original.memoryBarrier, MemoryBarrier);
+        OpenGLUtil::HookEntryPoint(glad_glBlitFramebuffer, g_original.blitFramebuffer, BlitFramebuffer);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniform1i, g_original.programUniform1i, ProgramUniform1i);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniform1f, g_original.programUniform1f, ProgramUniform1f);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniform2fv, g_original.programUniform2fv, ProgramUniform2fv);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniform3fv, g_original.programUniform3fv, ProgramUniform3fv);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniform4fv, g_original.programUniform4fv, ProgramUniform4fv);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniformMatrix2fv, g_original.programUniformMatrix2fv, ProgramUniformMatrix2fv);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniformMatrix3fv, g_original.programUniformMatrix3fv, ProgramUniformMatrix3fv);
+        OpenGLUtil::HookEntryPoint(glad_glProgramUniformMatrix4fv, g_original.programUniformMatrix4fv, ProgramUniformMatrix4fv);
+    }
+
+    void UninstallHooks() {
+        OpenGLUtil::UnhookEntryPoint(glad_glEnable, g_original.enable);
+        OpenGLUtil::UnhookEntryPoint(glad_glDisable, g_original.disable);
+        OpenGLUtil::UnhookEntryPoint(glad_glDepthFunc, g_original.depthFunc);
+        OpenGLUtil::UnhookEntryPoint(glad_glDepthMask, g_original.depthMask);
+        OpenGLUtil::UnhookEntryPoint(glad_glBlendFunc, g_original.blendFunc);
+        OpenGLUtil::UnhookEntryPoint(glad_glViewport, g_original.viewport);
+        OpenGLUtil::UnhookEntryPoint(glad_glClearColor, g_original.clearColor);
+        OpenGLUtil::UnhookEntryPoint(glad_glClear, g_original.clear);
+        OpenGLUtil::UnhookEntryPoint(glad_glPointSize, g_original.pointSize);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawBuffer, g_original.drawBuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawBuffers, g_original.drawBuffers);
+        OpenGLUtil::UnhookEntryPoint(glad_glReadBuffer, g_original.readBuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glActiveTexture, g_original.activeTexture);
+        OpenGLUtil::UnhookEntryPoint(glad_glUseProgram, g_original.useProgram);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindTexture, g_original.bindTexture);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindTextureUnit, g_original.bindTextureUnit);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindImageTexture, g_original.bindImageTexture);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindVertexArray, g_original.bindVertexArray);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindFramebuffer, g_original.bindFramebuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindBuffer, g_original.bindBuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindBufferBase, g_original.bindBufferBase);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindBufferRange, g_original.bindBufferRange);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform1i, g_original.uniform1i);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform1f, g_original.uniform1f);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform2f, g_original.uniform2f);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform3f, g_original.uniform3f);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform4f, g_original.uniform4f);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform2fv, g_original.uniform2fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform3fv, g_original.uniform3fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniform4fv, g_original.uniform4fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniformMatrix2fv, g_original.uniformMatrix2fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniformMatrix3fv, g_original.uniformMatrix3fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glUniformMatrix4fv, g_original.uniformMatrix4fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glBufferData, g_original.bufferData);
+        OpenGLUtil::UnhookEntryPoint(glad_glBufferSubData, g_original.bufferSubData);
+        OpenGLUtil::UnhookEntryPoint(glad_glNamedBufferSubData, g_original.namedBufferSubData);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawArrays, g_original.drawArrays);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElements, g_original.drawElements);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsBaseVertex, g_original.drawElementsBaseVertex);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstanced, g_original.drawElementsInstanced);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstancedBaseVertex, g_original.drawElementsInstancedBaseVertex);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstancedBaseVertexBaseInstance, g_original.drawElementsInstancedBaseVertexBaseInstance);
+        OpenGLUtil::UnhookEntryPoint(glad_glMultiDrawElementsIndirect, g_original.multiDrawElementsIndirect);
+        OpenGLUtil::UnhookEntryPoint(glad_glMultiDrawElementsIndirectCount, g_original.multiDrawElementsIndirectCount);
+        OpenGLUtil::UnhookEntryPoint(glad_glDispatchCompute, g_original.dispatchCompute);
+        OpenGLUtil::UnhookEntryPoint(glad_glDispatchComputeIndirect, g_original.dispatchComputeIndirect);
+        OpenGLUtil::UnhookEntryPoint(glad_glMemoryBarrier, g_original.memoryBarrier);
+        OpenGLUtil::UnhookEntryPoint(glad_glBlitFramebuffer, g_original.blitFramebuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniform1i, g_original.programUniform1i);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniform1f, g_original.programUniform1f);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniform2fv, g_original.programUniform2fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniform3fv, g_original.programUniform3fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniform4fv, g_original.programUniform4fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniformMatrix2fv, g_original.programUniformMatrix2fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniformMatrix3fv, g_original.programUniformMatrix3fv);
+        OpenGLUtil::UnhookEntryPoint(glad_glProgramUniformMatrix4fv, g_original.programUniformMatrix4fv);
+    }
+
+    /*
+    █▀▀ █▀█ █▀█ ▀█▀ █ █ █▀▄ █▀▀
+    █   █▀█ █▀▀  █  █ █ █▀▄ █▀▀
+    ▀▀▀ ▀ ▀ ▀    ▀  ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    void RequestCapture(const std::string& filepath) {
+        g_capturePath = filepath;
+        if (g_capturePath.empty()) {
+            std::filesystem::create_directories(g_captureDirectory);
+            g_capturePath = g_captureDirectory + "capture_" + std::to_string(File::GetCurrentTimestamp()) + ".glcap";
+        }
+        g_captureRequested = true;
+    }
+
+    void BeginFrame() {
+        if (!g_captureRequested) {
+            return;
+        }
+        g_captureRequested = false;
+        g_captureData = GLCaptureData();
+        g_snapshottedTextures.clear();
+        g_snapshottedBuffers.clear();
+        g_snapshottedVertexArrays.clear();
+        g_snapshottedPrograms.clear();
+        g_snapshottedFrameBuffers.clear();
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        g_captureData.width = viewport[2];
+        g_captureData.height = viewport[3];
+
+        InstallHooks();
+        g_capturing = true;
+        RecordInitialState();
+    }
+
+    // The frame inherits whatever state the previous one left behind, so open the capture by re-establishing it
+    void RecordInitialState() {
+        GLint value = 0;
+        GLint values[4];
+        GLfloat floatValues[4];
+        for (GLenum cap : { GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_PROGRAM_POINT_SIZE }) {
+            if (glIsEnabled(cap)) {
+                Enable(cap);
+            }
+            else {
+                Disable(cap);
+            }
+        }
+        glGetIntegerv(GL_DEPTH_FUNC, &value);
+        DepthFunc(value);
+        GLboolean depthMask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+        DepthMask(depthMask);
+        glGetIntegerv(GL_BLEND_SRC_RGB, &values[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB, &values[1]);
+        BlendFunc(values[0], values[1]);
+        glGetIntegerv(GL_VIEWPORT, values);
+        Viewport(values[0], values[1], values[2], values[3]);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, floatValues);
+        ClearColor(floatValues[0], floatValues[1], floatValues[2], floatValues[3]);
+        glGetFloatv(GL_POINT_SIZE, floatValues);
+        PointSize(floatValues[0]);
+
+        GLint readFrameBuffer = 0;
+        GLint drawFrameBuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFrameBuffer);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFrameBuffer);
+        BindFramebuffer(GL_READ_FRAMEBUFFER, readFrameBuffer);
+        BindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFrameBuffer);
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &value);
+        BindBuffer(GL_ARRAY_BUFFER, value);
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+        BindVertexArray(value);
+        glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+        UseProgram(value);
+
+        GLint activeTexture = GL_TEXTURE0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+        for (int unit = 0; unit < 16; unit++) {
+            g_original.activeTexture(GL_TEXTURE0 + unit);
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &value);
+            if (value != 0) {
+                BindTextureUnit(unit, value);
+            }
+        }
+        g_original.activeTexture(activeTexture);
+        ActiveTexture(activeTexture);
+    }
+
+    void EndFrame() {
+        if (!g_capturing) {
+            return;
+        }
+        UninstallHooks();
+        g_capturing = false;
+        File::ExportGLCapture(g_capturePath, g_captureData);
+        std::cout << "Captured " << g_captureData.calls.size() << " GL calls, "
+            << g_captureData.textures.size() << " textures, "
+            << g_captureData.buffers.size() << " buffers, "
+            << g_captureData.programs.size() << " programs\n";
+        g_captureData = GLCaptureData();
+    }
+
+    bool IsCapturing() {
+        return g_capturing;
+    }
+
+    /*
+    █▀▄ █▀▀ █▀█ █   █▀█ █ █
+    █▀▄ █▀▀ █▀▀ █   █▀█  █
+    ▀ ▀ ▀▀▀ ▀   ▀▀▀ ▀ ▀  ▀  */
+
+    GLuint GetReplayName(std::unordered_map<GLuint, GLuint>& names, uint64_t capturedName) {
+        auto it = names.find((GLuint)capturedName);
+        return it != names.end() ? it->second : 0;
+    }
+
+    const void* GetReplayBlob(const GLCapturedCall& call) {
+        if (call.blobIndex < 0 || call.blobIndex >= g_replayData.blobs.size()) {
+            return nullptr;
+        }
+        return g_replayData.blobs[call.blobIndex].data();
+    }
+
+    GLint GetReplayUniformLocation(GLuint capturedProgram, uint64_t capturedLocation) {
+        GLint location = UnpackInt(capturedLocation);
+        auto program = g_replayUniformLocations.find(capturedProgram);
+        if (program != g_replayUniformLocations.end()) {
+            auto it = program->second.find(location);
+            if (it != program->second.end()) {
+                return it->second;
+            }
+        }
+        return location;
+    }
+
+    GLuint CreateReplayProgram(const GLCapturedProgram& capturedProgram) {
+        GLuint program = glCreateProgram();
+        std::vector<GLuint> shaders;
+        for (const GLCapturedShader& capturedShader : capturedProgram.shaders) {
+            GLuint shader = glCreateShader(capturedShader.type);
+            const char* source = capturedShader.source.c_str();
+            glShaderSource(shader, 1, &source, nullptr);
+            glCompileShader(shader);
+            glAttachShader(program, shader);
+            shaders.push_back(shader);
+        }
+        glLinkProgram(program);
+        for (GLuint shader : shaders) {
+            glDeleteShader(shader);
+        }
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            std::cout << "OpenGLCapture::LoadReplay() failed to relink captured program " << capturedProgram.name << "\n";
+        }
+        std::unordered_map<GLint, GLint>& locations = g_replayUniformLocations[capturedProgram.name];
+        for (const GLCapturedUniform& uniform : capturedProgram.uniforms) {
+            GLint location = glGetUniformLocation(program, uniform.name.c_str());
+            locations[uniform.location] = location;
+            if (location == -1 || uniform.value.empty()) {
+                continue;
+            }
+            int componentCount = 1;
+            bool isFloat = false;
+            bool isUnsigned = false;
+            GetUniformTypeInfo(uniform.type, componentCount, isFloat, isUnsigned);
+            const GLfloat* floats = (const GLfloat*)uniform.value.data();
+            const GLint* ints = (const GLint*)uniform.value.data();
+            switch (uniform.type) {
+                case GL_FLOAT:      glProgramUniform1fv(program, location, 1, floats); break;
+                case GL_FLOAT_VEC2: glProgramUniform2fv(program, location, 1, floats); break;
+                case GL_FLOAT_VEC3: glProgramUniform3fv(program, location, 1, floats); break;
+                case GL_FLOAT_VEC4: glProgramUniform4fv(program, location, 1, floats); break;
+                case GL_FLOAT_MAT2: glProgramUniformMatrix2fv(program, location, 1, GL_FALSE, floats); break;
+                case GL_FLOAT_MAT3: glProgramUniformMatrix3fv(program, location, 1, GL_FALSE, floats); break;
+                case GL_FLOAT_MAT4: glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, floats); break;
+                case GL_UNSIGNED_INT: glProgramUniform1uiv(program, location, 1, (const GLuint*)ints); break;
+                default:
+                    if (componentCount == 2) glProgramUniform2iv(program, location, 1, ints);
+                    else if (componentCount == 3) glProgramUniform3iv(program, location, 1, ints);
+                    else if (componentCount == 4) glProgramUniform4iv(program, location, 1, ints);
+                    else glProgramUniform1iv(program, location, 1, ints);
+                    break;
+            }
+        }
+        return program;
+    }
+
+    bool LoadReplay(const std::string& filepath) {
+        CleanUpReplay();
+        if (!File::ImportGLCapture(filepath, g_replayData)) {
+            return false;
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (GLCapturedTexture& capturedTexture : g_replayData.textures) {
+            GLuint texture = 0;
+            glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+            glTextureStorage2D(texture, std::max<GLsizei>(1, capturedTexture.levels.size()), capturedTexture.internalFormat, capturedTexture.width, capturedTexture.height);
+            glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, capturedTexture.minFilter);
+            glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, capturedTexture.magFilter);
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_S, capturedTexture.wrapS);
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_T, capturedTexture.wrapT);
+            GLenum format = 0;
+            GLenum type = 0;
+            int bytesPerPixel = 0;
+            bool canUpload = capturedTexture.compressed || GetReadbackFormat(capturedTexture.internalFormat, format, type, bytesPerPixel);
+            for (int level = 0; level < capturedTexture.levels.size() && canUpload; level++) {
+                std::vector<uint8_t>& levelData = capturedTexture.levels[level];
+                if (levelData.empty()) {
+                    continue;
+                }
+                GLsizei levelWidth = std::max(1u, capturedTexture.width >> level);
+                GLsizei levelHeight = std::max(1u, capturedTexture.height >> level);
+                if (capturedTexture.compressed) {
+                    glCompressedTextureSubImage2D(texture, level, 0, 0, levelWidth, levelHeight, capturedTexture.internalFormat, (GLsizei)levelData.size(), levelData.data());
+                }
+                else {
+                    glTextureSubImage2D(texture, level, 0, 0, levelWidth, levelHeight, format, type, levelData.data());
+                }
+            }
+            g_replayTextures[capturedTexture.name] = texture;
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        for (GLCapturedBuffer& capturedBuffer : g_replayData.buffers) {
+            GLuint buffer = 0;
+            glCreateBuffers(1, &buffer);
+            glNamedBufferData(buffer, capturedBuffer.size, capturedBuffer.data.empty() ? nullptr : capturedBuffer.data.data(), GL_DYNAMIC_DRAW);
+            g_replayBuffers[capturedBuffer.name] = buffer;
+        }
+        for (GLCapturedVertexArray& capturedVertexArray : g_replayData.vertexArrays) {
+            GLuint vertexArray = 0;
+            glCreateVertexArrays(1, &vertexArray);
+            glVertexArrayElementBuffer(vertexArray, GetReplayName(g_replayBuffers, capturedVertexArray.elementBuffer));
+            for (GLuint i = 0; i < 16; i++) {
+                GLCapturedVertexAttribute& attribute = capturedVertexArray.attributes[i];
+                GLCapturedVertexBinding& binding = capturedVertexArray.bindings[i];
+                if (binding.buffer) {
+                    glVertexArrayVertexBuffer(vertexArray, i, GetReplayName(g_replayBuffers, binding.buffer), binding.offset, binding.stride);
+                    glVertexArrayBindingDivisor(vertexArray, i, binding.divisor);
+                }
+                if (!attribute.enabled) {
+                    continue;
+                }
+                if (attribute.integer) {
+                    glVertexArrayAttribIFormat(vertexArray, i, attribute.size, attribute.type, attribute.relativeOffset);
+                }
+                else {
+                    glVertexArrayAttribFormat(vertexArray, i, attribute.size, attribute.type, attribute.normalized, attribute.relativeOffset);
+                }
+                glVertexArrayAttribBinding(vertexArray, i, attribute.bindingIndex);
+                glEnableVertexArrayAttrib(vertexArray, i);
+            }
+            g_replayVertexArrays[capturedVertexArray.name] = vertexArray;
+        }
+        for (GLCapturedProgram& capturedProgram : g_replayData.programs) {
+            g_replayPrograms[capturedProgram.name] = CreateReplayProgram(capturedProgram);
+        }
+        for (GLCapturedFrameBuffer& capturedFrameBuffer : g_replayData.frameBuffers) {
+            GLuint frameBuffer = 0;
+            glCreateFramebuffers(1, &frameBuffer);
+            for (int i = 0; i < 8; i++) {
+                if (capturedFrameBuffer.colorAttachments[i]) {
+                    glNamedFramebufferTexture(frameBuffer, GL_COLOR_ATTACHMENT0 + i, GetReplayName(g_replayTextures, capturedFrameBuffer.colorAttachments[i]), capturedFrameBuffer.colorAttachmentLevels[i]);
+                }
+            }
+            if (capturedFrameBuffer.depthAttachment && capturedFrameBuffer.depthAttachment == capturedFrameBuffer.stencilAttachment) {
+                glNamedFramebufferTexture(frameBuffer, GL_DEPTH_STENCIL_ATTACHMENT, GetReplayName(g_replayTextures, capturedFrameBuffer.depthAttachment), 0);
+            }
+            else if (capturedFrameBuffer.depthAttachment) {
+                glNamedFramebufferTexture(frameBuffer, GL_DEPTH_ATTACHMENT, GetReplayName(g_replayTextures, capturedFrameBuffer.depthAttachment), 0);
+            }
+            glNamedFramebufferDrawBuffers(frameBuffer, 8, (const GLenum*)capturedFrameBuffer.drawBuffers);
+            glNamedFramebufferReadBuffer(frameBuffer, capturedFrameBuffer.readBuffer);
+            g_replayFrameBuffers[capturedFrameBuffer.name] = frameBuffer;
+        }
+        std::cout << "Loaded GL capture '" << g_replayData.name << "': " << g_replayData.calls.size() << " calls, "
+            << g_replayData.textures.size() << " textures, " << g_replayData.buffers.size() << " buffers, "
+            << g_replayData.programs.size() << " programs\n";
+        return true;
+    }
+
+    void ReplayFrame() {
+        for (const GLCapturedCall& call : g_replayData.calls) {
+            const uint64_t* a = call.args;
+            switch ((CaptureOp)call.opcode) {
+                case CaptureOp::ENABLE:             glEnable(a[0]); break;
+                case CaptureOp::DISABLE:            glDisable(a[0]); break;
+                case CaptureOp::DEPTH_FUNC:         glDepthFunc(a[0]); break;
+                case CaptureOp::DEPTH_MASK:         glDepthMask((GLboolean)a[0]); break;
+                case CaptureOp::BLEND_FUNC:         glBlendFunc(a[0], a[1]); break;
+                case CaptureOp::VIEWPORT:           glViewport(UnpackInt(a[0]), UnpackInt(a[1]), UnpackInt(a[2]), UnpackInt(a[3])); break;
+                case CaptureOp::CLEAR_COLOR:        glClearColor(UnpackFloat(a[0]), UnpackFloat(a[1]), UnpackFloat(a[2]), UnpackFloat(a[3])); break;
+                case CaptureOp::CLEAR:              glClear(a[0]); break;
+                case CaptureOp::POINT_SIZE:         glPointSize(UnpackFloat(a[0])); break;
+                case CaptureOp::DRAW_BUFFER:        glDrawBuffer(a[0]); break;
+                case CaptureOp::DRAW_BUFFERS:       glDrawBuffers(UnpackInt(a[0]), (const GLenum*)GetReplayBlob(call)); break;
+                case CaptureOp::READ_BUFFER:        glReadBuffer(a[0]); break;
+                case CaptureOp::ACTIVE_TEXTURE:     glActiveTexture(a[0]); break;
+                case CaptureOp::USE_PROGRAM:
+                    g_replayCurrentProgram = (GLuint)a[0];
+                    glUseProgram(GetReplayName(g_replayPrograms, a[0]));
+                    break;
+                case CaptureOp::BIND_TEXTURE:       glBindTexture(a[0], GetReplayName(g_replayTextures, a[1])); break;
+                case CaptureOp::BIND_TEXTURE_UNIT:  glBindTextureUnit(a[0], GetReplayName(g_replayTextures, a[1])); break;
+                case CaptureOp::BIND_IMAGE_TEXTURE: glBindImageTexture(a[0], GetReplayName(g_replayTextures, a[1]), UnpackInt(a[2]), (GLboolean)a[3], UnpackInt(a[4]), a[5], a[6]); break;
+                case CaptureOp::BIND_VERTEX_ARRAY:  glBindVertexArray(GetReplayName(g_replayVertexArrays, a[0])); break;
+                case CaptureOp::BIND_FRAMEBUFFER:   glBindFramebuffer(a[0], GetReplayName(g_replayFrameBuffers, a[1])); break;
+                case CaptureOp::BIND_BUFFER:        glBindBuffer(a[0], GetReplayName(g_replayBuffers, a[1])); break;
+                case CaptureOp::BIND_BUFFER_BASE:   glBindBufferBase(a[0], a[1], GetReplayName(g_replayBuffers, a[2])); break;
+                case CaptureOp::BIND_BUFFER_RANGE:  glBindBufferRange(a[0], a[1], GetReplayName(g_replayBuffers, a[2]), (GLintptr)a[3], (GLsizeiptr)a[4]); break;
+                case CaptureOp::UNIFORM_1I:         glUniform1i(GetReplayUniformLocation(g_replayCurrentProgram, a[0]), UnpackInt(a[1])); break;
+                case CaptureOp::UNIFORM_1F:         glUniform1f(GetReplayUniformLocation(g_replayCurrentProgram, a[0]), UnpackFloat(a[1])); break;
+                case CaptureOp::UNIFORM_2F:         glUniform2f(GetReplayUniformLocation(g_replayCurrentProgram, a[0]), UnpackFloat(a[1]), UnpackFloat(a[2])); break;
+                case CaptureOp::UNIFORM_3F:         glUniform3f(GetReplayUniformLocation(g_replayCurrentProgram, a[0]), UnpackFloat(a[1]), UnpackFloat(a[2]), UnpackFloat(a[3])); break;
+                case CaptureOp::UNIFORM_4F:         glUniform4f(GetReplayUniformLocation(g_replayCurrentProgram, a[0]), UnpackFloat(a[1]), UnpackFloat(a[2]), UnpackFloat(a[3]), UnpackFloat(a[4])); break;
+                case CaptureOp::UNIFORM_FV: {
+                    GLint location = GetReplayUniformLocation(g_replayCurrentProgram, a[0]);
+                    const GLfloat* value = (const GLfloat*)GetReplayBlob(call);
+                    if (a[1] == 2) glUniform2fv(location, UnpackInt(a[2]), value);
+                    if (a[1] == 3) glUniform3fv(location, UnpackInt(a[2]), value);
+                    if (a[1] == 4) glUniform4fv(location, UnpackInt(a[2]), value);
+                    break;
+                }
+                case CaptureOp::UNIFORM_MATRIX_FV: {
+                    GLint location = GetReplayUniformLocation(g_replayCurrentProgram, a[0]);
+                    const GLfloat* value = (const GLfloat*)GetReplayBlob(call);
+                    if (a[1] == 2) glUniformMatrix2fv(location, UnpackInt(a[2]), (GLboolean)a[3], value);
+                    if (a[1] == 3) glUniformMatrix3fv(location, UnpackInt(a[2]), (GLboolean)a[3], value);
+                    if (a[1] == 4) glUniformMatrix4fv(location, UnpackInt(a[2]), (GLboolean)a[3], value);
+                    break;
+                }
+                case CaptureOp::BUFFER_DATA:        glBufferData(a[0], (GLsizeiptr)a[1], GetReplayBlob(call), a[2]); break;
+                case CaptureOp::BUFFER_SUB_DATA:    glBufferSubData(a[0], (GLintptr)a[1], (GLsizeiptr)a[2], GetReplayBlob(call)); break;
+                case CaptureOp::NAMED_BUFFER_SUB_DATA: glNamedBufferSubData(GetReplayName(g_replayBuffers, a[0]), (GLintptr)a[1], (GLsizeiptr)a[2], GetReplayBlob(call)); break;
+                case CaptureOp::DRAW_ARRAYS:        glDrawArrays(a[0], UnpackInt(a[1]), UnpackInt(a[2])); break;
+                case CaptureOp::DRAW_ELEMENTS:      glDrawElements(a[0], UnpackInt(a[1]), a[2], (const void*)a[3]); break;
+                case CaptureOp::DRAW_ELEMENTS_BASE_VERTEX: glDrawElementsBaseVertex(a[0], UnpackInt(a[1]), a[2], (const void*)a[3], UnpackInt(a[4])); break;
+                case CaptureOp::DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE:
+                    glDrawElementsInstancedBaseVertexBaseInstance(a[0], UnpackInt(a[1]), a[2], (const void*)a[3], UnpackInt(a[4]), UnpackInt(a[5]), (GLuint)a[6]);
+                    break;
+                case CaptureOp::MULTI_DRAW_ELEMENTS_INDIRECT: glMultiDrawElementsIndirect(a[0], a[1], (const void*)a[2], UnpackInt(a[3]), UnpackInt(a[4])); break;
+                case CaptureOp::MULTI_DRAW_ELEMENTS_INDIRECT_COUNT: glMultiDrawElementsIndirectCount(a[0], a[1], (const void*)a[2], (GLintptr)a[3], UnpackInt(a[4]), UnpackInt(a[5])); break;
+                case CaptureOp::DISPATCH_COMPUTE:   glDispatchCompute((GLuint)a[0], (GLuint)a[1], (GLuint)a[2]); break;
+                case CaptureOp::DISPATCH_COMPUTE_INDIRECT: glDispatchComputeIndirect((GLintptr)a[0]); break;
+                case CaptureOp::MEMORY_BARRIER:     glMemoryBarrier(a[0]); break;
+                case CaptureOp::BLIT_FRAMEBUFFER:
+                    glBlitFramebuffer(UnpackInt(a[0]), UnpackInt(a[1]), UnpackInt(a[2]), UnpackInt(a[3]), UnpackInt(a[4]), UnpackInt(a[5]), UnpackInt(a[6]), UnpackInt(a[7]), a[8], a[9]);
+                    break;
+                case CaptureOp::PROGRAM_UNIFORM_1I:
+                    glProgramUniform1i(GetReplayName(g_replayPrograms, a[0]), GetReplayUniformLocation((GLuint)a[0], a[1]), UnpackInt(a[2]));
+                    break;
+                case CaptureOp::PROGRAM_UNIFORM_1F:
+                    glProgramUniform1f(GetReplayName(g_replayPrograms, a[0]), GetReplayUniformLocation((GLuint)a[0], a[1]), UnpackFloat(a[2]));
+                    break;
+                case CaptureOp::PROGRAM_UNIFORM_FV: {
+                    GLuint program = GetReplayName(g_replayPrograms, a[0]);
+                    GLint location = GetReplayUniformLocation((GLuint)a[0], a[1]);
+                    const GLfloat* value = (const GLfloat*)GetReplayBlob(call);
+                    if (a[2] == 2) glProgramUniform2fv(program, location, UnpackInt(a[3]), value);
+                    if (a[2] == 3) glProgramUniform3fv(program, location, UnpackInt(a[3]), value);
+                    if (a[2] == 4) glProgramUniform4fv(program, location, UnpackInt(a[3]), value);
+                    break;
+                }
+                case CaptureOp::PROGRAM_UNIFORM_MATRIX_FV: {
+                    GLuint program = GetReplayName(g_replayPrograms, a[0]);
+                    GLint location = GetReplayUniformLocation((GLuint)a[0], a[1]);
+                    const GLfloat* value = (const GLfloat*)GetReplayBlob(call);
+                    if (a[2] == 2) glProgramUniformMatrix2fv(program, location, UnpackInt(a[3]), (GLboolean)a[4], value);
+                    if (a[2] == 3) glProgramUniformMatrix3fv(program, location, UnpackInt(a[3]), (GLboolean)a[4], value);
+                    if (a[2] == 4) glProgramUniformMatrix4fv(program, location, UnpackInt(a[3]), (GLboolean)a[4], value);
+                    break;
+                }
+            }
+        }
+    }
+
+    void CleanUpReplay() {
+        for (auto& [capturedName, texture] : g_replayTextures) {
+            glDeleteTextures(1, &texture);
+        }
+        for (auto& [capturedName, buffer] : g_replayBuffers) {
+            glDeleteBuffers(1, &buffer);
+        }
+        for (auto& [capturedName, vertexArray] : g_replayVertexArrays) {
+            glDeleteVertexArrays(1, &vertexArray);
+        }
+        for (auto& [capturedName, program] : g_replayPrograms) {
+            glDeleteProgram(program);
+        }
+        for (auto& [capturedName, frameBuffer] : g_replayFrameBuffers) {
+            glDeleteFramebuffers(1, &frameBuffer);
+        }
+        g_replayTextures.clear();
+        g_replayBuffers.clear();
+        g_replayVertexArrays.clear();
+        g_replayPrograms.clear();
+        g_replayFrameBuffers.clear();
+        g_replayUniformLocations.clear();
+        g_replayCurrentProgram = 0;
+        g_replayData = GLCaptureData();
+    }
+
+    const std::string& GetReplayName() {
+        return g_replayData.name;
+    }
+
+    int GetReplayCallCount() {
+        return g_replayData.calls.size();
+    }
+}
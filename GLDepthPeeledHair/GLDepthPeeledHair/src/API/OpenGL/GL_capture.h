@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+
+// Records one frame of GL calls, plus the contents of every texture, buffer, vertex array, program and framebuffer
+// those calls touch, so the frame can be replayed and timed without the asset pipeline or the scene.
+// Only the entry points the renderer uses during RenderFrame are recorded, anything else is invisible to the capture.
+
+namespace OpenGLCapture {
+    // Capture, an empty filepath writes to res/captures/capture_<timestamp>.glcap
+    void RequestCapture(const std::string& filepath);
+    void BeginFrame();
+    void EndFrame();
+    bool IsCapturing();
+
+    // Replay
+    bool LoadReplay(const std::string& filepath);
+    void ReplayFrame();
+    void CleanUpReplay();
+    const std::string& GetReplayName();
+    int GetReplayCallCount();
+}
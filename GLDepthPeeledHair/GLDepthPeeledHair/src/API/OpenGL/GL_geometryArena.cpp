@@ -0,0 +1,154 @@
+#include "GL_geometryArena.h"
+#include "../../Common/VertexCompression.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace OpenGLGeometryArena {
+
+    constexpr uint32_t INITIAL_VERTEX_CAPACITY = 256 * 1024;
+    constexpr uint32_t INITIAL_INDEX_CAPACITY = 1024 * 1024;
+
+    GLuint g_vao = 0;
+    GLuint g_vbo = 0;
+    GLuint g_ebo = 0;
+    OffsetAllocator g_vertexAllocator;
+    OffsetAllocator g_indexAllocator;
+
+    /*
+    █▀▄ █ █ █▀▀ █▀▀ █▀▀ █▀▄ █▀▀
+    █▀▄ █ █ █▀▀ █▀▀ █▀▀ █▀▄ ▀▀█
+    ▀▀  ▀▀▀ ▀   ▀   ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    GLuint CreateBuffer(size_t size) {
+        GLuint buffer = 0;
+        glCreateBuffers(1, &buffer);
+        glNamedBufferStorage(buffer, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        return buffer;
+    }
+
+    // Moves the old contents into a larger buffer so existing base vertex and first index offsets stay valid
+    GLuint GrowBuffer(GLuint oldBuffer, size_t oldSize, size_t newSize) {
+        GLuint newBuffer = CreateBuffer(newSize);
+        if (oldBuffer != 0) {
+            glCopyNamedBufferSubData(oldBuffer, newBuffer, 0, 0, oldSize);
+            glDeleteBuffers(1, &oldBuffer);
+        }
+        return newBuffer;
+    }
+
+    void Init() {
+        g_vertexAllocator.Init(INITIAL_VERTEX_CAPACITY);
+        g_indexAllocator.Init(INITIAL_INDEX_CAPACITY);
+        g_vbo = CreateBuffer(INITIAL_VERTEX_CAPACITY * sizeof(CompactVertex));
+        g_ebo = CreateBuffer(INITIAL_INDEX_CAPACITY * sizeof(uint32_t));
+        glCreateVertexArrays(1, &g_vao);
+        glVertexArrayVertexBuffer(g_vao, 0, g_vbo, 0, sizeof(CompactVertex));
+        glVertexArrayElementBuffer(g_vao, g_ebo);
+        glEnableVertexArrayAttrib(g_vao, 0);
+        glEnableVertexArrayAttrib(g_vao, 1);
+        glEnableVertexArrayAttrib(g_vao, 2);
+        glEnableVertexArrayAttrib(g_vao, 3);
+        // Normal and tangent arrive as octahedral vec2s, the vertex shaders decode them with OctahedralDecode()
+        glVertexArrayAttribFormat(g_vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(CompactVertex, position));
+        glVertexArrayAttribFormat(g_vao, 1, 2, GL_SHORT, GL_TRUE, offsetof(CompactVertex, normal));
+        glVertexArrayAttribFormat(g_vao, 2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(CompactVertex, uv));
+        glVertexArrayAttribFormat(g_vao, 3, 2, GL_SHORT, GL_TRUE, offsetof(CompactVertex, tangent));
+        glVertexArrayAttribBinding(g_vao, 0, 0);
+        glVertexArrayAttribBinding(g_vao, 1, 0);
+        glVertexArrayAttribBinding(g_vao, 2, 0);
+        glVertexArrayAttribBinding(g_vao, 3, 0);
+    }
+
+    uint32_t AllocateOrGrow(OffsetAllocator& allocator, GLuint& buffer, size_t elementSize, uint32_t count, bool isVertexBuffer) {
+        uint32_t offset = allocator.Allocate(count);
+        if (offset != OffsetAllocator::INVALID_OFFSET) {
+            return offset;
+        }
+        uint32_t oldCapacity = allocator.GetCapacity();
+        uint32_t newCapacity = std::max(oldCapacity * 2, oldCapacity + count);
+        buffer = GrowBuffer(buffer, oldCapacity * elementSize, newCapacity * elementSize);
+        allocator.Grow(newCapacity);
+        if (isVertexBuffer) {
+            glVertexArrayVertexBuffer(g_vao, 0, buffer, 0, sizeof(CompactVertex));
+        }
+        else {
+            glVertexArrayElementBuffer(g_vao, buffer);
+        }
+        return allocator.Allocate(count);
+    }
+
+    /*
+    █▀█ █▀▄ █▀▀ █▀█ █▀█
+    █▀█ █▀▄ █▀▀ █ █ █▀█
+    ▀ ▀ ▀ ▀ ▀▀▀ ▀ ▀ ▀ ▀ */
+
+    GeometryAllocation Allocate(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        std::vector<CompactVertex> compactVertices = VertexCompression::Pack(vertices);
+        return Allocate(compactVertices.data(), (uint32_t)compactVertices.size(), indices.data(), (uint32_t)indices.size(), sizeof(uint32_t));
+    }
+
+    // Vertices and 32 bit indices upload straight from the caller's memory, which for .model files is the mapped file itself.
+    // Every mesh shares one 32 bit element buffer, so 16 bit indices are not zero copy: they are widened into a scratch copy first.
+    GeometryAllocation Allocate(const CompactVertex* vertices, uint32_t vertexCount, const void* indices, uint32_t indexCount, uint32_t indexSize) {
+        GeometryAllocation allocation;
+        if (vertexCount == 0 || indexCount == 0) {
+            return allocation;
+        }
+        if (g_vao == 0) {
+            Init();
+        }
+        allocation.vertexCount = vertexCount;
+        allocation.indexCount = indexCount;
+        allocation.baseVertex = AllocateOrGrow(g_vertexAllocator, g_vbo, sizeof(CompactVertex), allocation.vertexCount, true);
+        allocation.firstIndex = AllocateOrGrow(g_indexAllocator, g_ebo, sizeof(uint32_t), allocation.indexCount, false);
+        if (!allocation.IsValid()) {
+            std::cout << "OpenGLGeometryArena::Allocate() failed because " << vertexCount << " vertices and " << indexCount << " indices did not fit after growing the arena\n";
+            Free(allocation);
+            return allocation;
+        }
+        glNamedBufferSubData(g_vbo, allocation.baseVertex * sizeof(CompactVertex), vertexCount * sizeof(CompactVertex), vertices);
+        if (indexSize == sizeof(uint32_t)) {
+            glNamedBufferSubData(g_ebo, allocation.firstIndex * sizeof(uint32_t), indexCount * sizeof(uint32_t), indices);
+        }
+        else {
+            const uint16_t* shortIndices = static_cast<const uint16_t*>(indices);
+            std::vector<uint32_t> widenedIndices(shortIndices, shortIndices + indexCount);
+            glNamedBufferSubData(g_ebo, allocation.firstIndex * sizeof(uint32_t), indexCount * sizeof(uint32_t), widenedIndices.data());
+        }
+        return allocation;
+    }
+
+    void Free(GeometryAllocation& allocation) {
+        if (allocation.baseVertex != OffsetAllocator::INVALID_OFFSET) {
+            g_vertexAllocator.Free(allocation.baseVertex, allocation.vertexCount);
+        }
+        if (allocation.firstIndex != OffsetAllocator::INVALID_OFFSET) {
+            g_indexAllocator.Free(allocation.firstIndex, allocation.indexCount);
+        }
+        allocation = GeometryAllocation();
+    }
+
+    void CleanUp() {
+        if (g_vao != 0) {
+            glDeleteVertexArrays(1, &g_vao);
+            glDeleteBuffers(1, &g_vbo);
+            glDeleteBuffers(1, &g_ebo);
+            g_vao = g_vbo = g_ebo = 0;
+        }
+        g_vertexAllocator = OffsetAllocator();
+        g_indexAllocator = OffsetAllocator();
+    }
+
+    GLuint GetVAO() {
+        return g_vao;
+    }
+
+    std::string GetDebugText() {
+        std::string text = "Geometry arena\n";
+        text += "Vertices: " + std::to_string(g_vertexAllocator.GetUsedSize()) + " / " + std::to_string(g_vertexAllocator.GetCapacity());
+        text += " (" + std::to_string(g_vertexAllocator.GetFreeRangeCount()) + " free ranges)\n";
+        text += "Indices: " + std::to_string(g_indexAllocator.GetUsedSize()) + " / " + std::to_string(g_indexAllocator.GetCapacity());
+        text += " (" + std::to_string(g_indexAllocator.GetFreeRangeCount()) + " free ranges)\n";
+        return text;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include "OffsetAllocator.hpp"
+#include "Types.h"
+
+struct GeometryAllocation {
+    uint32_t baseVertex = OffsetAllocator::INVALID_OFFSET;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = OffsetAllocator::INVALID_OFFSET;
+    uint32_t indexCount = 0;
+
+    bool IsValid() const {
+        return baseVertex != OffsetAllocator::INVALID_OFFSET && firstIndex != OffsetAllocator::INVALID_OFFSET;
+    }
+};
+
+// One vertex and one index buffer shared by every static mesh, drawn through a single VAO using base vertex and first index offsets
+namespace OpenGLGeometryArena {
+    GeometryAllocation Allocate(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+    GeometryAllocation Allocate(const CompactVertex* vertices, uint32_t vertexCount, const void* indices, uint32_t indexCount, uint32_t indexSize);
+    void Free(GeometryAllocation& allocation);
+    void CleanUp();
+    GLuint GetVAO();
+    std::string GetDebugText();
+}
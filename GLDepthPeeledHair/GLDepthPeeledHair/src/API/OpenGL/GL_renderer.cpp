@@ -1,13 +1,19 @@
 #include "GL_renderer.h"
 #include "GL_backend.h"
 #include "GL_util.hpp"
+#include "GL_stats.h"
+#include "GL_capture.h"
+#include "GL_geometryArena.h"
 #include "Types/GL_detachedMesh.hpp"
 #include "Types/GL_frameBuffer.hpp"
-#include "Types/GL_pbo.hpp"
 #include "Types/GL_shader.h"
+#include "Types/GL_ssbo.hpp"
+#include "Types/GL_ubo.hpp"
 #include "../AssetManagement/AssetManager.h"
 #include "../Core/Audio.h"
 #include "../Core/Camera.h"
+#include "../Core/FrustumCulling.h"
+#include "../Core/RenderQueue.h"
 #include "../Core/Scene.hpp"
 #include "../Input/Input.h"
 #include "../Util.hpp"
@@ -21,6 +27,9 @@ namespace OpenGLRenderer {
     struct Shaders {
         Shader solidColor;
         Shader lighting;
+        Shader lightingIndirect;
+        Shader gpuCull;
+        Shader hiZDownsample;
         Shader hairDepthPeel;
         Shader textBlitter;
         Shader hairfinalComposite;
@@ -32,29 +41,186 @@ namespace OpenGLRenderer {
         GLFrameBuffer hair;
     } g_frameBuffers;
 
-    void DrawScene(Shader& shader);
+    // Each render item list owns a contiguous slice of the instance buffer, and of the command buffer when drawing indirectly.
+    // With GPU culling the command slice is an upper bound and the real count lives in drawCounts[drawCountIndex].
+    struct DrawList {
+        int instanceOffset = 0;
+        int commandOffset = 0;
+        int commandCount = 0;
+        uint32_t drawCountIndex = GPU_CULL_KEEP_ORDER;
+    };
+
+    struct DrawLists {
+        DrawList opaque;
+        DrawList blended;
+        DrawList hairTopLayer;
+        DrawList hairBottomLayer;
+    } g_drawLists;
+
+    struct UBOs {
+        UBO cameraData;
+    } g_ubos;
+
+    struct SSBOs {
+        SSBO instances;
+        SSBO renderItems;
+        SSBO drawCommands;
+        SSBO cullItems;
+        SSBO drawCounts;
+    } g_ssbos;
+
+    // Farthest depth mip chain of the opaque pass, level 0 is half the main framebuffer resolution
+    struct HiZPyramid {
+        GLuint texture = 0;
+        int width = 0;
+        int height = 0;
+        int levelCount = 0;
+    } g_hiZPyramid;
+
+    HairSettings g_hairSettings;
+    bool g_textOverlaysEnabled = true;
+    CameraData g_cameraData;
+    std::vector<InstanceData> g_instanceData;
+    std::vector<GPURenderItem> g_gpuRenderItems;
+    std::vector<DrawElementsIndirectCommand> g_drawCommands;
+    std::vector<GPUCullItem> g_gpuCullItems;
+    bool g_indirectDrawingSupported = false;
+    bool g_indirectDrawingEnabled = true;
+    bool g_indirectDrawingThisFrame = false;
+    bool g_gpuCullingSupported = false;
+    bool g_gpuCullingEnabled = true;
+    bool g_gpuCullingThisFrame = false;
+    bool g_hiZCullingEnabled = true;
+    int g_opaqueCullItemCount = 0;
+    int g_clusterCullItemCount = 0;
+
+    void DrawScene();
     void RenderLighting();
     void RenderDebug();
     void RenderHair();
-    void RenderHairLayer(std::vector<RenderItem>& renderItems, int peelCount);
+    void RenderHairLayer(std::vector<RenderItem>& renderItems, DrawList& drawList, int peelCount);
+    void CullRenderItems();
+    void SortRenderItems();
+    void MarkVisibleMaterials();
+    void UpdateCameraData();
+    void UpdateInstanceData();
+    bool BuildIndirectDrawLists();
+    int GetInstanceRunLength(std::vector<RenderItem>& renderItems, int first);
+    void DispatchGPUCulling(int cullItemOffset, int cullItemCount, bool occlusionCulling);
+    void CullOccludableItems();
+    void BuildHiZPyramid();
+    std::string GetCullingText();
+    void MultiDrawIndirect(DrawList& drawList);
     void RenderText();
+    void CreateHairFrameBuffer();
 
     void Init() {
         g_frameBuffers.main.Create("Main", 1920, 1080);
         g_frameBuffers.main.CreateAttachment("Color", GL_RGBA8);
         g_frameBuffers.main.CreateDepthAttachment(GL_DEPTH32F_STENCIL8);
+        CreateHairFrameBuffer();
+        LoadShaders();
+    }
 
-        float hairDownscaleRatio = 1.0f;
+    void CreateHairFrameBuffer() {
+        float hairDownscaleRatio = g_hairSettings.downscaleRatio;
         g_frameBuffers.hair.Create("Hair", g_frameBuffers.main.GetWidth() * hairDownscaleRatio, g_frameBuffers.main.GetHeight() * hairDownscaleRatio);
         g_frameBuffers.hair.CreateDepthAttachment(GL_DEPTH32F_STENCIL8);
         g_frameBuffers.hair.CreateAttachment("Color", GL_RGBA8);
         g_frameBuffers.hair.CreateAttachment("ViewspaceDepth", GL_R32F);
         g_frameBuffers.hair.CreateAttachment("ViewspaceDepthPrevious", GL_R32F);
         g_frameBuffers.hair.CreateAttachment("Composite", GL_RGBA8);
-        LoadShaders();
+    }
+
+    HairSettings& GetHairSettings() {
+        return g_hairSettings;
+    }
+
+    void SetHairSettings(const HairSettings& hairSettings) {
+        bool resolutionChanged = hairSettings.downscaleRatio != g_hairSettings.downscaleRatio;
+        g_hairSettings = hairSettings;
+        if (resolutionChanged) {
+            g_frameBuffers.hair.CleanUp();
+            CreateHairFrameBuffer();
+        }
+    }
+
+    void SetTextOverlaysEnabled(bool enabled) {
+        g_textOverlaysEnabled = enabled;
+    }
+
+    void SetIndirectDrawingEnabled(bool enabled) {
+        g_indirectDrawingEnabled = enabled;
+    }
+
+    bool IsIndirectDrawingEnabled() {
+        return g_indirectDrawingEnabled;
+    }
+
+    void SetGPUCullingEnabled(bool enabled) {
+        g_gpuCullingEnabled = enabled;
+    }
+
+    bool IsGPUCullingEnabled() {
+        return g_gpuCullingEnabled;
+    }
+
+    void SetHiZCullingEnabled(bool enabled) {
+        g_hiZCullingEnabled = enabled;
+    }
+
+    bool IsHiZCullingEnabled() {
+        return g_hiZCullingEnabled;
+    }
+
+    int GetMainFrameBufferWidth() {
+        return g_frameBuffers.main.GetWidth();
+    }
+
+    int GetMainFrameBufferHeight() {
+        return g_frameBuffers.main.GetHeight();
+    }
+
+    void ReadBackMainColor(std::vector<uint8_t>& pixels) {
+        GLuint handle = g_frameBuffers.main.GetColorAttachmentHandleByName("Color");
+        GLsizei dataSize = g_frameBuffers.main.GetWidth() * g_frameBuffers.main.GetHeight() * 4;
+        pixels.resize(dataSize);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTextureImage(handle, 0, GL_RGBA, GL_UNSIGNED_BYTE, dataSize, pixels.data());
     }
 
     void RenderFrame() {
+        OpenGLCapture::BeginFrame();
+        OpenGLBackend::InvalidateStateCache();
+
+        // Bindless handles mean nothing outside this process, so a captured frame always takes the bound texture path
+        bool indirectDrawingAllowed = g_indirectDrawingSupported && g_indirectDrawingEnabled && !OpenGLCapture::IsCapturing();
+
+        // The GPU does the frustum test itself. If the frame then falls back to per item drawing while textures
+        // are still streaming in, it draws unculled, which costs time but not correctness.
+        g_gpuCullingThisFrame = indirectDrawingAllowed && g_gpuCullingSupported && g_gpuCullingEnabled;
+        if (!g_gpuCullingThisFrame) {
+            CullRenderItems();
+        }
+        SortRenderItems();
+        MarkVisibleMaterials();
+        UpdateCameraData();
+        UpdateInstanceData();
+        g_ubos.cameraData.Bind(0);
+        g_ssbos.instances.Bind(1);
+
+        g_indirectDrawingThisFrame = false;
+        if (indirectDrawingAllowed) {
+            g_indirectDrawingThisFrame = BuildIndirectDrawLists();
+        }
+        g_gpuCullingThisFrame &= g_indirectDrawingThisFrame;
+        if (g_indirectDrawingThisFrame) {
+            g_ssbos.renderItems.Bind(0);
+        }
+        // Only the solid list is culled up front, the rest waits for its depth in DrawScene()
+        if (g_gpuCullingThisFrame) {
+            DispatchGPUCulling(0, g_opaqueCullItemCount, false);
+        }
 
         g_frameBuffers.main.Bind();
         g_frameBuffers.main.SetViewport();
@@ -66,109 +232,388 @@ namespace OpenGLRenderer {
         RenderHair();
         RenderDebug();
 
-        int width, height;
-        glfwGetWindowSize(OpenGLBackend::GetWindowPtr(), &width, &height);
+        int width = OpenGLBackend::GetWindowWidth();
+        int height = OpenGLBackend::GetWindowHeight();
 
         GLFrameBuffer& mainFrameBuffer = g_frameBuffers.main;
         GLFrameBuffer& hairFrameBuffer = g_frameBuffers.hair;
 
         g_shaders.hairfinalComposite.Use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, hairFrameBuffer.GetColorAttachmentHandleByName("Composite"));
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, mainFrameBuffer.GetColorAttachmentHandleByName("Color"));
+        OpenGLBackend::BindTextureUnit(0, hairFrameBuffer.GetColorAttachmentHandleByName("Composite"));
+        OpenGLBackend::BindTextureUnit(1, mainFrameBuffer.GetColorAttachmentHandleByName("Color"));
         glBindImageTexture(0, mainFrameBuffer.GetColorAttachmentHandleByName("Color"), 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
         glDispatchCompute((g_frameBuffers.main.GetWidth() + 7) / 8, (g_frameBuffers.main.GetHeight() + 7) / 8, 1);
 
-        RenderText();
+        if (OpenGLStats::IsInstalled() && g_textOverlaysEnabled) {
+            TextBlitter::BlitText(OpenGLStats::GetHUDText() + OpenGLBackend::GetStateCacheText() + OpenGLBackend::GetTextureStagingText() + OpenGLBackend::GetTextureUploadText() + GetCullingText(), "StandardFont", 0, 80, g_frameBuffers.main.GetWidth(), g_frameBuffers.main.GetHeight(), 1.5f);
+        }
 
-        g_frameBuffers.main.BlitToDefaultFrameBuffer("Color", 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        if (g_textOverlaysEnabled) {
+            RenderText();
+        }
 
-        glfwSwapBuffers(OpenGLBackend::GetWindowPtr());
-        glfwPollEvents();
+        // Headless runs have no default framebuffer, the final image stays in g_frameBuffers.main
+        if (!OpenGLBackend::IsHeadless()) {
+            g_frameBuffers.main.BlitToDefaultFrameBuffer("Color", 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+        OpenGLBackend::SwapBuffersPollEvents();
     }
 
     void CopyDepthBuffer(GLFrameBuffer& srcFrameBuffer, GLFrameBuffer& dstFrameBuffer) {
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, srcFrameBuffer.GetHandle());
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dstFrameBuffer.GetHandle());
+        OpenGLBackend::BindFrameBuffer(GL_READ_FRAMEBUFFER, srcFrameBuffer.GetHandle());
+        OpenGLBackend::BindFrameBuffer(GL_DRAW_FRAMEBUFFER, dstFrameBuffer.GetHandle());
         glBlitFramebuffer(0, 0, srcFrameBuffer.GetWidth(), srcFrameBuffer.GetHeight(), 0, 0, dstFrameBuffer.GetWidth(), dstFrameBuffer.GetHeight(), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     }
 
     void CopyColorBuffer(GLFrameBuffer& srcFrameBuffer, GLFrameBuffer& dstFrameBuffer, const char* srcAttachmentName, const char* dstAttachmentName) {
         GLenum srcAttachmentSlot = srcFrameBuffer.GetColorAttachmentSlotByName(srcAttachmentName);
         GLenum dstAttachmentSlot = dstFrameBuffer.GetColorAttachmentSlotByName(dstAttachmentName);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, srcFrameBuffer.GetHandle());
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dstFrameBuffer.GetHandle());
+        OpenGLBackend::BindFrameBuffer(GL_READ_FRAMEBUFFER, srcFrameBuffer.GetHandle());
+        OpenGLBackend::BindFrameBuffer(GL_DRAW_FRAMEBUFFER, dstFrameBuffer.GetHandle());
         glReadBuffer(srcAttachmentSlot);
         glDrawBuffer(dstAttachmentSlot);
         glBlitFramebuffer(0, 0, srcFrameBuffer.GetWidth(), srcFrameBuffer.GetHeight(), 0, 0, dstFrameBuffer.GetWidth(), dstFrameBuffer.GetHeight(), GL_COLOR_BUFFER_BIT, GL_NEAREST);
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     }
 
-    void DrawScene(Shader& shader) {
-        // Non blended
-        for (RenderItem& renderItem : Scene::GetRenderItems()) {
-            OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
-            if (mesh) {
-                shader.SetMat4("model", renderItem.modelMatrix);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.baseColorTextureIndex)->GetGLTexture().GetHandle());
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.normalTextureIndex)->GetGLTexture().GetHandle());
-                glActiveTexture(GL_TEXTURE2);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.rmaTextureIndex)->GetGLTexture().GetHandle());
-                glBindVertexArray(mesh->GetVAO());
-                glDrawElements(GL_TRIANGLES, mesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
+    /*
+    █ █▀█ █▀▄ ▀█▀ █▀▄ █▀▀ █▀▀ ▀█▀
+    █ █ █ █ █  █  █▀▄ █▀▀ █    █
+    ▀ ▀ ▀ ▀▀  ▀▀▀ ▀ ▀ ▀▀▀ ▀▀▀  ▀  */
+
+    // Every pass including each hair peel layer draws from these lists, so whatever is culled here is skipped everywhere
+    void CullRenderItems() {
+        FrustumCulling::BeginFrame(Camera::GetProjectionMatrix() * Camera::GetViewMatrix());
+        FrustumCulling::Cull(Scene::GetRenderItems(), "Solid");
+        FrustumCulling::Cull(Scene::GetRenderItemsBlended(), "Blended");
+        FrustumCulling::Cull(Scene::GetRenderItemsHairTopLayer(), "Hair top");
+        FrustumCulling::Cull(Scene::GetRenderItemsHairBottomLayer(), "Hair bottom");
+    }
+
+    // Everything downstream (instance data, indirect commands, per item draws) walks the lists in this order
+    void SortRenderItems() {
+        glm::mat4 viewMatrix = Camera::GetViewMatrix();
+        RenderQueue::Sort(Scene::GetRenderItems(), RenderPass::SOLID, viewMatrix);
+        RenderQueue::Sort(Scene::GetRenderItemsBlended(), RenderPass::BLENDED, viewMatrix);
+        RenderQueue::Sort(Scene::GetRenderItemsHairTopLayer(), RenderPass::HAIR_TOP_LAYER, viewMatrix);
+        RenderQueue::Sort(Scene::GetRenderItemsHairBottomLayer(), RenderPass::HAIR_BOTTOM_LAYER, viewMatrix);
+    }
+
+    // Render items keep the material they want even while it falls back to the default one, so this is what streaming should fetch first
+    void MarkVisibleMaterials() {
+        for (std::vector<RenderItem>* renderItems : { &Scene::GetRenderItems(), &Scene::GetRenderItemsBlended(), &Scene::GetRenderItemsHairTopLayer(), &Scene::GetRenderItemsHairBottomLayer() }) {
+            int lastMaterialIndex = -1;
+            for (RenderItem& renderItem : *renderItems) {
+                if (renderItem.materialIndex != lastMaterialIndex) {
+                    AssetManager::MarkMaterialVisible(renderItem.materialIndex);
+                    lastMaterialIndex = renderItem.materialIndex;
+                }
             }
         }
-        // Blended
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_CULL_FACE);
-        glDepthMask(GL_FALSE);
-        for (RenderItem& renderItem : Scene::GetRenderItemsBlended()) {
+    }
+
+    void UpdateCameraData() {
+        static float time = 0;
+        time += 1.0f / 60.0f;
+        g_cameraData.projection = Camera::GetProjectionMatrix();
+        g_cameraData.projectionInverse = glm::inverse(g_cameraData.projection);
+        g_cameraData.view = Camera::GetViewMatrix();
+        g_cameraData.viewInverse = Camera::GetInverseViewMatrix();
+        g_cameraData.viewPos = glm::vec4(Camera::GetViewPos(), 1.0f);
+        g_cameraData.viewportWidth = g_frameBuffers.main.GetWidth();
+        g_cameraData.viewportHeight = g_frameBuffers.main.GetHeight();
+        g_cameraData.hairViewportWidth = g_frameBuffers.hair.GetWidth();
+        g_cameraData.hairViewportHeight = g_frameBuffers.hair.GetHeight();
+        g_cameraData.nearPlane = NEAR_PLANE;
+        g_cameraData.farPlane = FAR_PLANE;
+        g_cameraData.time = time;
+        g_ubos.cameraData.Update(sizeof(CameraData), &g_cameraData);
+    }
+
+    // Normal matrices are computed here once per item rather than per vertex
+    void UpdateInstanceData() {
+        g_instanceData.clear();
+        auto addInstances = [](std::vector<RenderItem>& renderItems, DrawList& drawList) {
+            drawList.instanceOffset = g_instanceData.size();
+            for (RenderItem& renderItem : renderItems) {
+                InstanceData& instanceData = g_instanceData.emplace_back();
+                instanceData.modelMatrix = renderItem.modelMatrix;
+                instanceData.normalMatrix = glm::transpose(glm::inverse(renderItem.modelMatrix));
+                OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
+                instanceData.alphaScale = mesh ? mesh->GetLod(renderItem.lodIndex).alphaScale : 1.0f;
+            }
+        };
+        addInstances(Scene::GetRenderItems(), g_drawLists.opaque);
+        addInstances(Scene::GetRenderItemsBlended(), g_drawLists.blended);
+        addInstances(Scene::GetRenderItemsHairTopLayer(), g_drawLists.hairTopLayer);
+        addInstances(Scene::GetRenderItemsHairBottomLayer(), g_drawLists.hairBottomLayer);
+        g_ssbos.instances.Update(g_instanceData.size() * sizeof(InstanceData), g_instanceData.data());
+    }
+
+    // Returns false if any texture isn't resident yet, in which case the frame falls back to binding textures per item.
+    // With GPU culling on, the lists are written out as cull items and the compute pass produces the commands.
+    bool BuildIndirectDrawLists() {
+        g_gpuRenderItems.clear();
+        g_drawCommands.clear();
+        g_gpuCullItems.clear();
+        g_clusterCullItemCount = 0;
+        bool texturesResident = true;
+        auto getBindlessHandle = [&texturesResident](int textureIndex) -> uint64_t {
+            Texture* texture = textureIndex != -1 ? AssetManager::GetTextureByIndex(textureIndex) : nullptr;
+            uint64_t handle = texture ? texture->GetGLTexture().GetBindlessID() : 0;
+            texturesResident &= handle != 0;
+            return handle;
+        };
+        g_gpuRenderItems.resize(g_instanceData.size());
+        int commandCount = 0;
+        auto addDrawList = [&](std::vector<RenderItem>& renderItems, DrawList& drawList, uint32_t drawCountIndex) {
+            drawList.commandOffset = commandCount;
+            drawList.drawCountIndex = drawCountIndex;
+            for (int i = 0; i < renderItems.size(); i++) {
+                RenderItem& renderItem = renderItems[i];
+                OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
+                if (!mesh || mesh->GetIndexCount(renderItem.lodIndex) == 0) {
+                    continue;
+                }
+                // GPU culling tests every instance on its own, so only CPU built commands are merged into instanced runs
+                int runLength = g_gpuCullingThisFrame ? 1 : GetInstanceRunLength(renderItems, i);
+                for (int j = i; j < i + runLength; j++) {
+                    GPURenderItem& gpuRenderItem = g_gpuRenderItems[drawList.instanceOffset + j];
+                    gpuRenderItem.baseColorHandle = getBindlessHandle(renderItems[j].baseColorTextureIndex);
+                    gpuRenderItem.normalHandle = getBindlessHandle(renderItems[j].normalTextureIndex);
+                    gpuRenderItem.rmaHandle = getBindlessHandle(renderItems[j].rmaTextureIndex);
+                }
+
+                const std::vector<MeshCluster>& clusters = mesh->GetClusters();
+                if (g_gpuCullingThisFrame && renderItem.lodIndex == 0 && !clusters.empty()) {
+                    // Clustered hair culls per cluster, so every peel layer only replays the clusters that survived
+                    for (const MeshCluster& cluster : clusters) {
+                        GPUCullItem& cullItem = g_gpuCullItems.emplace_back();
+                        cullItem.aabbMin = glm::vec4(cluster.center - glm::vec3(cluster.radius), 0.0f);
+                        cullItem.aabbMax = glm::vec4(cluster.center + glm::vec3(cluster.radius), 0.0f);
+                        cullItem.cone = glm::vec4(cluster.coneAxis, cluster.coneCutoff);
+                        cullItem.instanceIndex = drawList.instanceOffset + i;
+                        cullItem.indexCount = cluster.indexCount;
+                        cullItem.firstIndex = mesh->GetFirstIndex() + cluster.firstIndex;
+                        cullItem.baseVertex = mesh->GetBaseVertex();
+                        cullItem.commandSlot = (drawCountIndex == GPU_CULL_KEEP_ORDER) ? commandCount : drawList.commandOffset;
+                        cullItem.drawCountIndex = drawCountIndex;
+                        commandCount++;
+                    }
+                    g_clusterCullItemCount += clusters.size();
+                    continue;
+                }
+                if (g_gpuCullingThisFrame) {
+                    // A mesh without bounds is never culled
+                    bool hasBounds = mesh->aabbMin.x <= mesh->aabbMax.x;
+                    GPUCullItem& cullItem = g_gpuCullItems.emplace_back();
+                    cullItem.aabbMin = glm::vec4(hasBounds ? mesh->aabbMin : glm::vec3(-1e18f), 0.0f);
+                    cullItem.aabbMax = glm::vec4(hasBounds ? mesh->aabbMax : glm::vec3(1e18f), 0.0f);
+                    cullItem.instanceIndex = drawList.instanceOffset + i;
+                    cullItem.indexCount = mesh->GetIndexCount(renderItem.lodIndex);
+                    cullItem.firstIndex = mesh->GetFirstIndex(renderItem.lodIndex);
+                    cullItem.baseVertex = mesh->GetBaseVertex();
+                    cullItem.commandSlot = (drawCountIndex == GPU_CULL_KEEP_ORDER) ? commandCount : drawList.commandOffset;
+                    cullItem.drawCountIndex = drawCountIndex;
+                }
+                else {
+                    DrawElementsIndirectCommand& command = g_drawCommands.emplace_back();
+                    command.count = mesh->GetIndexCount(renderItem.lodIndex);
+                    command.instanceCount = runLength;
+                    command.firstIndex = mesh->GetFirstIndex(renderItem.lodIndex);
+                    command.baseVertex = mesh->GetBaseVertex();
+                    command.baseInstance = drawList.instanceOffset + i;
+                }
+                commandCount++;
+                i += runLength - 1;
+            }
+            drawList.commandCount = commandCount - drawList.commandOffset;
+        };
+        // Blended draws are depth sorted, so that list is culled in place rather than compacted
+        addDrawList(Scene::GetRenderItems(), g_drawLists.opaque, 0);
+        g_opaqueCullItemCount = g_gpuCullItems.size();
+        addDrawList(Scene::GetRenderItemsBlended(), g_drawLists.blended, GPU_CULL_KEEP_ORDER);
+        addDrawList(Scene::GetRenderItemsHairTopLayer(), g_drawLists.hairTopLayer, 1);
+        addDrawList(Scene::GetRenderItemsHairBottomLayer(), g_drawLists.hairBottomLayer, 2);
+        if (!texturesResident) {
+            return false;
+        }
+        g_ssbos.renderItems.Update(g_gpuRenderItems.size() * sizeof(GPURenderItem), g_gpuRenderItems.data());
+        if (g_gpuCullingThisFrame) {
+            uint32_t drawCounts[3] = {};
+            g_ssbos.cullItems.Update(g_gpuCullItems.size() * sizeof(GPUCullItem), g_gpuCullItems.data());
+            g_ssbos.drawCommands.Reserve(commandCount * sizeof(DrawElementsIndirectCommand));
+            g_ssbos.drawCounts.Update(sizeof(drawCounts), drawCounts);
+        }
+        else {
+            g_ssbos.drawCommands.Update(g_drawCommands.size() * sizeof(DrawElementsIndirectCommand), g_drawCommands.data());
+        }
+        return true;
+    }
+
+    // One thread per cull item, the hair lists are culled once per frame and every peel layer reuses the result
+    void DispatchGPUCulling(int cullItemOffset, int cullItemCount, bool occlusionCulling) {
+        if (cullItemCount == 0) {
+            return;
+        }
+        g_ssbos.cullItems.Bind(2);
+        g_ssbos.drawCommands.Bind(3);
+        g_ssbos.drawCounts.Bind(4);
+        if (occlusionCulling) {
+            OpenGLBackend::BindTextureUnit(1, g_hiZPyramid.texture);
+        }
+        g_shaders.gpuCull.Use();
+        g_shaders.gpuCull.SetInt("cullItemOffset", cullItemOffset);
+        g_shaders.gpuCull.SetInt("cullItemCount", cullItemCount);
+        g_shaders.gpuCull.SetBool("occlusionCulling", occlusionCulling);
+        glDispatchCompute((GLuint)(cullItemCount + 63) / 64, 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    // Blended and hair items are tested against the opaque depth, so hair hidden behind the body never reaches the peel loop
+    void CullOccludableItems() {
+        int cullItemCount = (int)g_gpuCullItems.size() - g_opaqueCullItemCount;
+        bool occlusionCulling = g_hiZCullingEnabled && cullItemCount > 0;
+        if (occlusionCulling) {
+            BuildHiZPyramid();
+        }
+        DispatchGPUCulling(g_opaqueCullItemCount, cullItemCount, occlusionCulling);
+    }
+
+    void BuildHiZPyramid() {
+        int width = std::max((int)g_frameBuffers.main.GetWidth() / 2, 1);
+        int height = std::max((int)g_frameBuffers.main.GetHeight() / 2, 1);
+        if (g_hiZPyramid.width != width || g_hiZPyramid.height != height) {
+            if (g_hiZPyramid.texture != 0) {
+                glDeleteTextures(1, &g_hiZPyramid.texture);
+            }
+            g_hiZPyramid.width = width;
+            g_hiZPyramid.height = height;
+            g_hiZPyramid.levelCount = (int)std::floor(std::log2(std::max(width, height))) + 1;
+            glCreateTextures(GL_TEXTURE_2D, 1, &g_hiZPyramid.texture);
+            glTextureStorage2D(g_hiZPyramid.texture, g_hiZPyramid.levelCount, GL_R32F, width, height);
+            glTextureParameteri(g_hiZPyramid.texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTextureParameteri(g_hiZPyramid.texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTextureParameteri(g_hiZPyramid.texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteri(g_hiZPyramid.texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        // Level 0 reduces the depth attachment, every level after that reduces the one above it
+        Shader& shader = g_shaders.hiZDownsample;
+        shader.Use();
+        for (int level = 0; level < g_hiZPyramid.levelCount; level++) {
+            GLuint source = (level == 0) ? g_frameBuffers.main.GetDepthAttachmentHandle() : g_hiZPyramid.texture;
+            int levelWidth = std::max(width >> level, 1);
+            int levelHeight = std::max(height >> level, 1);
+            OpenGLBackend::BindTextureUnit(0, source);
+            shader.SetInt("sourceLevel", (level == 0) ? 0 : level - 1);
+            glBindImageTexture(0, g_hiZPyramid.texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            glDispatchCompute((levelWidth + 7) / 8, (levelHeight + 7) / 8, 1);
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        }
+    }
+
+    void MultiDrawIndirect(DrawList& drawList) {
+        if (drawList.commandCount == 0) {
+            return;
+        }
+        OpenGLBackend::BindVertexArray(OpenGLGeometryArena::GetVAO());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_ssbos.drawCommands.GetHandle());
+        void* commandOffset = (void*)(drawList.commandOffset * sizeof(DrawElementsIndirectCommand));
+        if (g_gpuCullingThisFrame && drawList.drawCountIndex != GPU_CULL_KEEP_ORDER) {
+            glBindBuffer(GL_PARAMETER_BUFFER, g_ssbos.drawCounts.GetHandle());
+            glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, commandOffset, drawList.drawCountIndex * sizeof(uint32_t), drawList.commandCount, 0);
+        }
+        else {
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, commandOffset, drawList.commandCount, 0);
+        }
+    }
+
+    // GPU culled counts stay on the GPU, reading them back would stall the frame
+    std::string GetCullingText() {
+        if (g_gpuCullingThisFrame) {
+            std::string hiZText = g_hiZCullingEnabled ? " (Hi-Z on)" : "";
+            return "GPU culling: " + std::to_string(g_gpuCullItems.size()) + " candidates, " + std::to_string(g_clusterCullItemCount) + " hair clusters" + hiZText + "\n";
+        }
+        return FrustumCulling::GetDebugText();
+    }
+
+    Shader& GetLightingShader() {
+        return g_indirectDrawingThisFrame ? g_shaders.lightingIndirect : g_shaders.lighting;
+    }
+
+    // Sorting puts items that share a mesh, LOD and material next to each other, and their instance data is contiguous,
+    // so each run can be drawn as one instanced draw starting at the first item's instance
+    int GetInstanceRunLength(std::vector<RenderItem>& renderItems, int first) {
+        const RenderItem& firstItem = renderItems[first];
+        int last = first + 1;
+        while (last < renderItems.size() && renderItems[last].meshIndex == firstItem.meshIndex && renderItems[last].lodIndex == firstItem.lodIndex && renderItems[last].materialIndex == firstItem.materialIndex) {
+            last++;
+        }
+        return last - first;
+    }
+
+    // Per item fallback, the base instance still indexes the instance buffer so no per draw uniforms are needed.
+    // Items arrive in sort key order, so textures are only rebound when the material bits of the key change.
+    void DrawRenderItems(std::vector<RenderItem>& renderItems, DrawList& drawList, bool bindTextures) {
+        uint32_t boundMaterialBits = 0xFFFFFFFF;
+        for (int i = 0; i < renderItems.size(); ) {
+            RenderItem& renderItem = renderItems[i];
+            int instanceCount = GetInstanceRunLength(renderItems, i);
             OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
-            if (mesh) {
-                shader.SetMat4("model", renderItem.modelMatrix);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.baseColorTextureIndex)->GetGLTexture().GetHandle());
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.normalTextureIndex)->GetGLTexture().GetHandle());
-                glActiveTexture(GL_TEXTURE2);
-                glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.rmaTextureIndex)->GetGLTexture().GetHandle());
-                glBindVertexArray(mesh->GetVAO());
-                glDrawElements(GL_TRIANGLES, mesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
+            if (mesh && mesh->GetIndexCount(renderItem.lodIndex) > 0) {
+                uint32_t materialBits = RenderQueue::GetMaterialBits(renderItem.sortKey);
+                if (bindTextures && materialBits != boundMaterialBits) {
+                    boundMaterialBits = materialBits;
+                    OpenGLBackend::BindTextureUnit(0, AssetManager::GetTextureByIndex(renderItem.baseColorTextureIndex)->GetGLTexture().GetHandle());
+                    OpenGLBackend::BindTextureUnit(1, AssetManager::GetTextureByIndex(renderItem.normalTextureIndex)->GetGLTexture().GetHandle());
+                    OpenGLBackend::BindTextureUnit(2, AssetManager::GetTextureByIndex(renderItem.rmaTextureIndex)->GetGLTexture().GetHandle());
+                }
+                OpenGLBackend::BindVertexArray(mesh->GetVAO());
+                glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, mesh->GetIndexCount(renderItem.lodIndex), GL_UNSIGNED_INT, (void*)(sizeof(uint32_t) * mesh->GetFirstIndex(renderItem.lodIndex)), instanceCount, mesh->GetBaseVertex(), drawList.instanceOffset + i);
             }
+            i += instanceCount;
         }
-        glDepthMask(GL_TRUE);
-        glDisable(GL_BLEND);
-        glEnable(GL_CULL_FACE);
     }
 
+    void DrawScene() {
+        // Non blended
+        if (g_indirectDrawingThisFrame) {
+            MultiDrawIndirect(g_drawLists.opaque);
+        }
+        else {
+            DrawRenderItems(Scene::GetRenderItems(), g_drawLists.opaque, true);
+        }
+        // Opaque depth is complete here
+        if (g_gpuCullingThisFrame) {
+            CullOccludableItems();
+            GetLightingShader().Use();
+        }
+        // Blended
+        OpenGLBackend::Enable(GL_BLEND);
+        OpenGLBackend::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGLBackend::Disable(GL_CULL_FACE);
+        OpenGLBackend::SetDepthMask(false);
+        if (g_indirectDrawingThisFrame) {
+            MultiDrawIndirect(g_drawLists.blended);
+        }
+        else {
+            DrawRenderItems(Scene::GetRenderItemsBlended(), g_drawLists.blended, true);
+        }
+        OpenGLBackend::SetDepthMask(true);
+        OpenGLBackend::Disable(GL_BLEND);
+        OpenGLBackend::Enable(GL_CULL_FACE);
+    }
 
-    void RenderLighting() {
-        const float waterHeight = Hardcoded::roomY + Hardcoded::waterHeight;
-        static float time = 0;
-        time += 1.0f / 60.0f;
 
+    void RenderLighting() {
         g_frameBuffers.main.Bind();
         g_frameBuffers.main.SetViewport();
         g_frameBuffers.main.DrawBuffers({ "Color" });
 
-        glEnable(GL_CULL_FACE);
-        glEnable(GL_DEPTH_TEST);
-        g_shaders.lighting.Use();
-        g_shaders.lighting.SetMat4("projection", Camera::GetProjectionMatrix());
-        g_shaders.lighting.SetMat4("view", Camera::GetViewMatrix());
-        g_shaders.lighting.SetMat4("model", glm::mat4(1));
-        g_shaders.lighting.SetVec3("viewPos", Camera::GetViewPos());
-        g_shaders.lighting.SetFloat("time", time);
-        g_shaders.lighting.SetFloat("viewportWidth", g_frameBuffers.hair.GetWidth());
-        g_shaders.lighting.SetFloat("viewportHeight", g_frameBuffers.hair.GetHeight());
-        DrawScene(g_shaders.lighting);
+        OpenGLBackend::Enable(GL_CULL_FACE);
+        OpenGLBackend::Enable(GL_DEPTH_TEST);
+        Shader& shader = GetLightingShader();
+        shader.Use();
+        DrawScene();
     }
 
 
@@ -177,7 +622,7 @@ namespace OpenGLRenderer {
         GLFrameBuffer& mainFrameBuffer = g_frameBuffers.main;
         GLFrameBuffer& hairFrameBuffer = g_frameBuffers.hair;
 
-        static int peelCount = 4;
+        int& peelCount = g_hairSettings.peelCount;
         if (Input::KeyPressed(HELL_KEY_E) && peelCount < 7) {
             Audio::PlayAudio("UI_Select.wav", 1.0f);
             peelCount++;
@@ -195,38 +640,37 @@ namespace OpenGLRenderer {
         int locationY = 0;
         float scale = 2.5f;
         std::string text = "Peel count: " + std::to_string(peelCount);
-        TextBlitter::BlitText(text, "StandardFont", locationX, locationY, viewportWidth, viewportHeight, scale);
+        if (g_textOverlaysEnabled) {
+            TextBlitter::BlitText(text, "StandardFont", locationX, locationY, viewportWidth, viewportHeight, scale);
+        }
 
         // Setup state
-        Shader* shader = &g_shaders.lighting;
-        shader->Use();
-        shader->SetBool("isHair", true);
+        Shader& shader = GetLightingShader();
+        shader.SetBool("isHair", true);
         g_frameBuffers.hair.Bind();
         g_frameBuffers.hair.ClearAttachment("Composite", 0, 0, 0, 0);
         g_frameBuffers.hair.SetViewport();
-        glEnable(GL_CULL_FACE);
-        glDisable(GL_BLEND);
+        OpenGLBackend::Enable(GL_CULL_FACE);
+        OpenGLBackend::Disable(GL_BLEND);
 
         // Render all top then all Bottom layers
-        RenderHairLayer(Scene::GetRenderItemsHairTopLayer(), peelCount);
-        RenderHairLayer(Scene::GetRenderItemsHairBottomLayer(), peelCount);
+        RenderHairLayer(Scene::GetRenderItemsHairTopLayer(), g_drawLists.hairTopLayer, peelCount);
+        RenderHairLayer(Scene::GetRenderItemsHairBottomLayer(), g_drawLists.hairBottomLayer, peelCount);
 
         g_shaders.hairfinalComposite.Use();
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, hairFrameBuffer.GetColorAttachmentHandleByName("Composite"));
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, mainFrameBuffer.GetColorAttachmentHandleByName("Color"));
+        OpenGLBackend::BindTextureUnit(0, hairFrameBuffer.GetColorAttachmentHandleByName("Composite"));
+        OpenGLBackend::BindTextureUnit(1, mainFrameBuffer.GetColorAttachmentHandleByName("Color"));
         glBindImageTexture(0, mainFrameBuffer.GetColorAttachmentHandleByName("Color"), 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
         glDispatchCompute((g_frameBuffers.main.GetWidth() + 7) / 8, (g_frameBuffers.main.GetHeight() + 7) / 8, 1);
 
         // Cleanup
-        shader->Use();
-        shader->SetBool("isHair", false);
+        shader.SetBool("isHair", false);
         g_frameBuffers.main.SetViewport();
-        glDepthFunc(GL_LESS);
+        OpenGLBackend::SetDepthFunc(GL_LESS);
     }
 
-    void RenderHairLayer(std::vector<RenderItem>& renderItems, int peelCount) {
+    // The indirect path replays the same slice of the command buffer for every peel
+    void RenderHairLayer(std::vector<RenderItem>& renderItems, DrawList& drawList, int peelCount) {
          g_frameBuffers.hair.Bind();
         g_frameBuffers.hair.ClearAttachment("ViewspaceDepthPrevious", 1, 1, 1, 1);
         for (int i = 0; i < peelCount; i++) {
@@ -235,47 +679,26 @@ namespace OpenGLRenderer {
             g_frameBuffers.hair.Bind();
             g_frameBuffers.hair.ClearAttachment("ViewspaceDepth", 0, 0, 0, 0);
             g_frameBuffers.hair.DrawBuffer("ViewspaceDepth");
-            glDepthFunc(GL_LESS);
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, g_frameBuffers.hair.GetColorAttachmentHandleByName("ViewspaceDepthPrevious"));
-            Shader* shader = &g_shaders.hairDepthPeel;
-            shader->Use();
-            shader->SetMat4("projection", Camera::GetProjectionMatrix());
-            shader->SetMat4("view", Camera::GetViewMatrix());
-            shader->SetFloat("nearPlane", NEAR_PLANE);
-            shader->SetFloat("farPlane", FAR_PLANE);
-            shader->SetFloat("viewportWidth", g_frameBuffers.hair.GetWidth());
-            shader->SetFloat("viewportHeight", g_frameBuffers.hair.GetHeight());
-            for (RenderItem& renderItem : renderItems) {
-                OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
-                if (mesh) {
-                    shader->SetMat4("model", renderItem.modelMatrix);
-                    glBindVertexArray(mesh->GetVAO());
-                    glDrawElements(GL_TRIANGLES, mesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
-                }
+            OpenGLBackend::SetDepthFunc(GL_LESS);
+            OpenGLBackend::BindTextureUnit(0, g_frameBuffers.hair.GetColorAttachmentHandleByName("ViewspaceDepthPrevious"));
+            g_shaders.hairDepthPeel.Use();
+            if (g_indirectDrawingThisFrame) {
+                MultiDrawIndirect(drawList);
+            }
+            else {
+                DrawRenderItems(renderItems, drawList, false);
             }
             // Color pass
-            glDepthFunc(GL_EQUAL);
+            OpenGLBackend::SetDepthFunc(GL_EQUAL);
             g_frameBuffers.hair.Bind();
             g_frameBuffers.hair.ClearAttachment("Color", 0, 0, 0, 0);
             g_frameBuffers.hair.DrawBuffer("Color");
-            shader = &g_shaders.lighting;
-            shader->Use();
-            shader->SetMat4("projection", Camera::GetProjectionMatrix());
-            shader->SetMat4("view", Camera::GetViewMatrix());
-            for (RenderItem& renderItem : renderItems) {
-                OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
-                if (mesh) {
-                    shader->SetMat4("model", renderItem.modelMatrix);
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.baseColorTextureIndex)->GetGLTexture().GetHandle());
-                    glActiveTexture(GL_TEXTURE1);
-                    glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.normalTextureIndex)->GetGLTexture().GetHandle());
-                    glActiveTexture(GL_TEXTURE2);
-                    glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByIndex(renderItem.rmaTextureIndex)->GetGLTexture().GetHandle());
-                    glBindVertexArray(mesh->GetVAO());
-                    glDrawElements(GL_TRIANGLES, mesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
-                }
+            GetLightingShader().Use();
+            if (g_indirectDrawingThisFrame) {
+                MultiDrawIndirect(drawList);
+            }
+            else {
+                DrawRenderItems(renderItems, drawList, true);
             }
             // TODO!: when you port this you can output previous viewspace depth in the pass above
             CopyColorBuffer(g_frameBuffers.hair, g_frameBuffers.hair, "ViewspaceDepth", "ViewspaceDepthPrevious");
@@ -289,26 +712,23 @@ namespace OpenGLRenderer {
     }
 
     void RenderDebug() {
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_CULL_FACE);
+        OpenGLBackend::Disable(GL_CULL_FACE);
+        OpenGLBackend::Disable(GL_DEPTH_TEST);
         glPointSize(8.0f);
-        glDisable(GL_DEPTH_TEST);
         
         g_shaders.solidColor.Use();
-        g_shaders.solidColor.SetMat4("projection", Camera::GetProjectionMatrix());
-        g_shaders.solidColor.SetMat4("view", Camera::GetViewMatrix());
         g_shaders.solidColor.SetMat4("model", glm::mat4(1));
 
         // Draw lines
         UpdateDebugLinesMesh();
         if (g_debugLinesMesh.GetIndexCount() > 0) {
-            glBindVertexArray(g_debugLinesMesh.GetVAO());
+            OpenGLBackend::BindVertexArray(g_debugLinesMesh.GetVAO());
             glDrawElements(GL_LINES, g_debugLinesMesh.GetIndexCount(), GL_UNSIGNED_INT, 0);
         }
         // Draw points
         UpdateDebugPointsMesh();
         if (g_debugPointsMesh.GetIndexCount() > 0) {
-            glBindVertexArray(g_debugPointsMesh.GetVAO());
+            OpenGLBackend::BindVertexArray(g_debugPointsMesh.GetVAO());
             glDrawElements(GL_POINTS, g_debugPointsMesh.GetIndexCount(), GL_UNSIGNED_INT, 0);
         }
     }
@@ -320,19 +740,18 @@ namespace OpenGLRenderer {
 
         Shader& shader = g_shaders.textBlitter;
         shader.Use();
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        OpenGLBackend::Disable(GL_DEPTH_TEST);
+        OpenGLBackend::Enable(GL_BLEND);
+        OpenGLBackend::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         OpenGLFontMesh* fontMesh = TextBlitter::GetGLFontMesh("StandardFont");
         if (fontMesh) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, AssetManager::GetTextureByName("StandardFont")->GetGLTexture().GetHandle());
-            glBindVertexArray(fontMesh->GetVAO());
+            OpenGLBackend::BindTextureUnit(0, AssetManager::GetTextureByName("StandardFont")->GetGLTexture().GetHandle());
+            OpenGLBackend::BindVertexArray(fontMesh->GetVAO());
             glDrawElements(GL_TRIANGLES, fontMesh->GetIndexCount(), GL_UNSIGNED_INT, 0);
         }
 
         // Cleanup
-        glDisable(GL_BLEND);
+        OpenGLBackend::Disable(GL_BLEND);
     }
 
     void LoadShaders() {
@@ -344,5 +763,13 @@ namespace OpenGLRenderer {
             g_shaders.textBlitter.Load({ "gl_text_blitter.vert", "gl_text_blitter.frag" })) {
             std::cout << "Hotloaded shaders\n";
         }
+        // Without bindless handles one call can't draw items with different materials, so the per item path stays in use
+        if (GLAD_GL_ARB_bindless_texture) {
+            g_indirectDrawingSupported = g_shaders.lightingIndirect.Load({ "gl_lighting_indirect.vert", "gl_lighting_indirect.frag" });
+        }
+        // Compacted lists are submitted with glMultiDrawElementsIndirectCount, which is core from 4.6
+        if (g_indirectDrawingSupported && GLAD_GL_VERSION_4_6) {
+            g_gpuCullingSupported = g_shaders.gpuCull.Load({ "gl_gpu_cull.comp" }) && g_shaders.hiZDownsample.Load({ "gl_hiz_downsample.comp" });
+        }
     }
 }
\ No newline at end of file
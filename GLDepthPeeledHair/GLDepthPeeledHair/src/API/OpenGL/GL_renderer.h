@@ -2,12 +2,33 @@
 #include "Common.h"
 #include "Types/GL_detachedMesh.hpp"
 
+struct HairSettings {
+    int peelCount = 4;
+    float downscaleRatio = 1.0f;
+};
+
 namespace OpenGLRenderer {
 
     void Init();
     void LoadShaders();
     void RenderFrame();
 
+    // Settings
+    HairSettings& GetHairSettings();
+    void SetHairSettings(const HairSettings& hairSettings);
+    void SetTextOverlaysEnabled(bool enabled);  // Off for image comparisons, the peel count and HUD text would end up in the readback
+    void SetIndirectDrawingEnabled(bool enabled);
+    bool IsIndirectDrawingEnabled();
+    void SetGPUCullingEnabled(bool enabled);
+    bool IsGPUCullingEnabled();
+    void SetHiZCullingEnabled(bool enabled);
+    bool IsHiZCullingEnabled();
+
+    // Readback
+    int GetMainFrameBufferWidth();
+    int GetMainFrameBufferHeight();
+    void ReadBackMainColor(std::vector<uint8_t>& pixels);
+
     // Debug
     void UpdateDebugLinesMesh();
     void UpdateDebugPointsMesh();
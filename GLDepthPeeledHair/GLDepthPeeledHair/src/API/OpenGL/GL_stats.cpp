@@ -0,0 +1,487 @@
+#include "GL_stats.h"
+#include <glad/glad.h>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <vector>
+#include "Types.h"
+#include "GL_util.hpp"
+
+namespace OpenGLStats {
+
+    struct OriginalEntryPoints {
+        PFNGLDRAWARRAYSPROC drawArrays = nullptr;
+        PFNGLDRAWARRAYSINSTANCEDPROC drawArraysInstanced = nullptr;
+        PFNGLDRAWELEMENTSPROC drawElements = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDPROC drawElementsInstanced = nullptr;
+        PFNGLDRAWELEMENTSBASEVERTEXPROC drawElementsBaseVertex = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC drawElementsInstancedBaseVertex = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC drawElementsInstancedBaseVertexBaseInstance = nullptr;
+        PFNGLMULTIDRAWELEMENTSINDIRECTPROC multiDrawElementsIndirect = nullptr;
+        PFNGLMULTIDRAWELEMENTSINDIRECTCOUNTPROC multiDrawElementsIndirectCount = nullptr;
+        PFNGLDISPATCHCOMPUTEPROC dispatchCompute = nullptr;
+        PFNGLDISPATCHCOMPUTEINDIRECTPROC dispatchComputeIndirect = nullptr;
+        PFNGLUSEPROGRAMPROC useProgram = nullptr;
+        PFNGLACTIVETEXTUREPROC activeTexture = nullptr;
+        PFNGLBINDTEXTUREPROC bindTexture = nullptr;
+        PFNGLBINDTEXTUREUNITPROC bindTextureUnit = nullptr;
+        PFNGLBINDVERTEXARRAYPROC bindVertexArray = nullptr;
+        PFNGLBINDFRAMEBUFFERPROC bindFramebuffer = nullptr;
+        PFNGLDELETETEXTURESPROC deleteTextures = nullptr;
+        PFNGLDELETEVERTEXARRAYSPROC deleteVertexArrays = nullptr;
+        PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers = nullptr;
+        PFNGLBUFFERDATAPROC bufferData = nullptr;
+        PFNGLBUFFERSUBDATAPROC bufferSubData = nullptr;
+        PFNGLBUFFERSTORAGEPROC bufferStorage = nullptr;
+        PFNGLNAMEDBUFFERDATAPROC namedBufferData = nullptr;
+        PFNGLNAMEDBUFFERSUBDATAPROC namedBufferSubData = nullptr;
+        PFNGLNAMEDBUFFERSTORAGEPROC namedBufferStorage = nullptr;
+        PFNGLMAPBUFFERRANGEPROC mapBufferRange = nullptr;
+        PFNGLMAPNAMEDBUFFERRANGEPROC mapNamedBufferRange = nullptr;
+        PFNGLTEXIMAGE2DPROC texImage2D = nullptr;
+        PFNGLTEXSUBIMAGE2DPROC texSubImage2D = nullptr;
+        PFNGLCOMPRESSEDTEXIMAGE2DPROC compressedTexImage2D = nullptr;
+        PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC compressedTexSubImage2D = nullptr;
+        PFNGLTEXTURESUBIMAGE2DPROC textureSubImage2D = nullptr;
+        PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC compressedTextureSubImage2D = nullptr;
+        PFNGLBLITFRAMEBUFFERPROC blitFramebuffer = nullptr;
+        PFNGLBLITNAMEDFRAMEBUFFERPROC blitNamedFramebuffer = nullptr;
+    } g_original;
+
+    // Binding state is unknown when the wrappers go in, so the first bind of anything is never reported as redundant
+    constexpr GLuint UNKNOWN_BINDING = 0xFFFFFFFF;
+
+    bool g_installed = false;
+    GLCommandCounters g_currentFrame;
+    GLCommandCounters g_lastFrame;
+    GLuint g_boundProgram = UNKNOWN_BINDING;
+    GLuint g_boundVertexArray = UNKNOWN_BINDING;
+    GLuint g_boundDrawFrameBuffer = UNKNOWN_BINDING;
+    GLuint g_boundReadFrameBuffer = UNKNOWN_BINDING;
+    GLuint g_activeTextureUnit = 0;
+    std::vector<GLuint> g_boundTextures;
+
+    uint64_t GetPixelTransferSize(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+        uint64_t componentCount = 4;
+        switch (format) {
+            case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: componentCount = 1; break;
+            case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL: componentCount = 2; break;
+            case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: componentCount = 3; break;
+            default: componentCount = 4; break;
+        }
+        uint64_t componentSize = 1;
+        switch (type) {
+            case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: componentSize = 2; break;
+            case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: componentSize = 4; break;
+            case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_2_10_10_10_REV: componentSize = 4; componentCount = 1; break;
+            default: componentSize = 1; break;
+        }
+        return (uint64_t)width * height * componentCount * componentSize;
+    }
+
+    uint64_t GetBlitSize(GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask) {
+        // Approximate, assumes 4 byte color and depth and 1 byte stencil, which covers every attachment the renderer creates
+        uint64_t area = (uint64_t)std::abs(dstX1 - dstX0) * std::abs(dstY1 - dstY0);
+        uint64_t bytesPerPixel = 0;
+        bytesPerPixel += (mask & GL_COLOR_BUFFER_BIT) ? 4 : 0;
+        bytesPerPixel += (mask & GL_DEPTH_BUFFER_BIT) ? 4 : 0;
+        bytesPerPixel += (mask & GL_STENCIL_BUFFER_BIT) ? 1 : 0;
+        return area * bytesPerPixel;
+    }
+
+    /*
+    █▀▄ █▀▄ █▀█ █ █ █ █▀█ █▀▀
+    █ █ █▀▄ █▀█ █▄▀▄█ █ █ █ █
+    ▀▀  ▀ ▀ ▀ ▀ ▀ ▀ ▀ ▀ ▀ ▀▀▀ */
+
+    void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count) {
+        g_currentFrame.drawCalls++;
+        g_original.drawArrays(mode, first, count);
+    }
+
+    void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+        g_currentFrame.drawCalls++;
+        g_original.drawArraysInstanced(mode, first, count, instanceCount);
+    }
+
+    void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        g_currentFrame.drawCalls++;
+        g_original.drawElements(mode, count, type, indices);
+    }
+
+    void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount) {
+        g_currentFrame.drawCalls++;
+        g_original.drawElementsInstanced(mode, count, type, indices, instanceCount);
+    }
+
+    void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex) {
+        g_currentFrame.drawCalls++;
+        g_original.drawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    }
+
+    void APIENTRY DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLint baseVertex) {
+        g_currentFrame.drawCalls++;
+        g_original.drawElementsInstancedBaseVertex(mode, count, type, indices, instanceCount, baseVertex);
+    }
+
+    void APIENTRY DrawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLint baseVertex, GLuint baseInstance) {
+        g_currentFrame.drawCalls++;
+        g_original.drawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instanceCount, baseVertex, baseInstance);
+    }
+
+    // Multi draws count as a single submission, that's the whole point of them
+    void APIENTRY MultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride) {
+        g_currentFrame.drawCalls++;
+        g_original.multiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+    }
+
+    void APIENTRY MultiDrawElementsIndirectCount(GLenum mode, GLenum type, const void* indirect, GLintptr drawCount, GLsizei maxDrawCount, GLsizei stride) {
+        g_currentFrame.drawCalls++;
+        g_original.multiDrawElementsIndirectCount(mode, type, indirect, drawCount, maxDrawCount, stride);
+    }
+
+    void APIENTRY DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) {
+        g_currentFrame.dispatches++;
+        g_original.dispatchCompute(groupsX, groupsY, groupsZ);
+    }
+
+    void APIENTRY DispatchComputeIndirect(GLintptr indirect) {
+        g_currentFrame.dispatches++;
+        g_original.dispatchComputeIndirect(indirect);
+    }
+
+    /*
+    █▀▄ ▀█▀ █▀█ █▀▄ █▀▀
+    █▀▄  █  █ █ █ █ ▀▀█
+    ▀▀  ▀▀▀ ▀ ▀ ▀▀  ▀▀▀ */
+
+    void APIENTRY UseProgram(GLuint program) {
+        g_currentFrame.programBinds++;
+        if (program == g_boundProgram) {
+            g_currentFrame.redundantProgramBinds++;
+        }
+        g_boundProgram = program;
+        g_original.useProgram(program);
+    }
+
+    void APIENTRY ActiveTexture(GLenum texture) {
+        g_activeTextureUnit = texture - GL_TEXTURE0;
+        g_original.activeTexture(texture);
+    }
+
+    void TrackTextureBind(GLuint unit, GLuint texture) {
+        if (unit >= g_boundTextures.size()) {
+            g_boundTextures.resize(unit + 1, UNKNOWN_BINDING);
+        }
+        g_currentFrame.textureBinds++;
+        if (g_boundTextures[unit] == texture) {
+            g_currentFrame.redundantTextureBinds++;
+        }
+        g_boundTextures[unit] = texture;
+    }
+
+    void APIENTRY BindTexture(GLenum target, GLuint texture) {
+        TrackTextureBind(g_activeTextureUnit, texture);
+        g_original.bindTexture(target, texture);
+    }
+
+    void APIENTRY BindTextureUnit(GLuint unit, GLuint texture) {
+        TrackTextureBind(unit, texture);
+        g_original.bindTextureUnit(unit, texture);
+    }
+
+    void APIENTRY BindVertexArray(GLuint vertexArray) {
+        g_currentFrame.vertexArrayBinds++;
+        if (vertexArray == g_boundVertexArray) {
+            g_currentFrame.redundantVertexArrayBinds++;
+        }
+        g_boundVertexArray = vertexArray;
+        g_original.bindVertexArray(vertexArray);
+    }
+
+    void APIENTRY BindFramebuffer(GLenum target, GLuint frameBuffer) {
+        g_currentFrame.frameBufferBinds++;
+        bool redundant = false;
+        if (target == GL_FRAMEBUFFER) {
+            redundant = g_boundDrawFrameBuffer == frameBuffer && g_boundReadFrameBuffer == frameBuffer;
+            g_boundDrawFrameBuffer = frameBuffer;
+            g_boundReadFrameBuffer = frameBuffer;
+        }
+        else if (target == GL_DRAW_FRAMEBUFFER) {
+            redundant = g_boundDrawFrameBuffer == frameBuffer;
+            g_boundDrawFrameBuffer = frameBuffer;
+        }
+        else if (target == GL_READ_FRAMEBUFFER) {
+            redundant = g_boundReadFrameBuffer == frameBuffer;
+            g_boundReadFrameBuffer = frameBuffer;
+        }
+        if (redundant) {
+            g_currentFrame.redundantFrameBufferBinds++;
+        }
+        g_original.bindFramebuffer(target, frameBuffer);
+    }
+
+    // Deleting a bound object reverts that binding to zero, so keep the tracked state honest
+    void APIENTRY DeleteTextures(GLsizei count, const GLuint* textures) {
+        for (int i = 0; i < count; i++) {
+            for (GLuint& boundTexture : g_boundTextures) {
+                if (boundTexture == textures[i]) {
+                    boundTexture = 0;
+                }
+            }
+        }
+        g_original.deleteTextures(count, textures);
+    }
+
+    void APIENTRY DeleteVertexArrays(GLsizei count, const GLuint* vertexArrays) {
+        for (int i = 0; i < count; i++) {
+            if (g_boundVertexArray == vertexArrays[i]) {
+                g_boundVertexArray = 0;
+            }
+        }
+        g_original.deleteVertexArrays(count, vertexArrays);
+    }
+
+    void APIENTRY DeleteFramebuffers(GLsizei count, const GLuint* frameBuffers) {
+        for (int i = 0; i < count; i++) {
+            if (g_boundDrawFrameBuffer == frameBuffers[i]) {
+                g_boundDrawFrameBuffer = 0;
+            }
+            if (g_boundReadFrameBuffer == frameBuffers[i]) {
+                g_boundReadFrameBuffer = 0;
+            }
+        }
+        g_original.deleteFramebuffers(count, frameBuffers);
+    }
+
+    /*
+    █ █ █▀█ █   █▀█ █▀█ █▀▄ █▀▀
+    █ █ █▀▀ █   █ █ █▀█ █ █ ▀▀█
+    ▀▀▀ ▀   ▀▀▀ ▀▀▀ ▀ ▀ ▀▀  ▀▀▀ */
+
+    void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        g_currentFrame.bufferUploadBytes += data ? size : 0;
+        g_original.bufferData(target, size, data, usage);
+    }
+
+    void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        g_currentFrame.bufferUploadBytes += size;
+        g_original.bufferSubData(target, offset, size, data);
+    }
+
+    void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+        g_currentFrame.bufferUploadBytes += data ? size : 0;
+        g_original.bufferStorage(target, size, data, flags);
+    }
+
+    void APIENTRY NamedBufferData(GLuint buffer, GLsizeiptr size, const void* data, GLenum usage) {
+        g_currentFrame.bufferUploadBytes += data ? size : 0;
+        g_original.namedBufferData(buffer, size, data, usage);
+    }
+
+    void APIENTRY NamedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data) {
+        g_currentFrame.bufferUploadBytes += size;
+        g_original.namedBufferSubData(buffer, offset, size, data);
+    }
+
+    void APIENTRY NamedBufferStorage(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags) {
+        g_currentFrame.bufferUploadBytes += data ? size : 0;
+        g_original.namedBufferStorage(buffer, size, data, flags);
+    }
+
+    // Writes through a mapping can't be observed, so count the whole mapped range as uploaded
+    void* APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        g_currentFrame.bufferUploadBytes += (access & GL_MAP_WRITE_BIT) ? length : 0;
+        return g_original.mapBufferRange(target, offset, length, access);
+    }
+
+    void* APIENTRY MapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        g_currentFrame.bufferUploadBytes += (access & GL_MAP_WRITE_BIT) ? length : 0;
+        return g_original.mapNamedBufferRange(buffer, offset, length, access);
+    }
+
+    void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+        g_currentFrame.textureUploadBytes += GetPixelTransferSize(width, height, format, type);
+        g_original.texImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+    }
+
+    void APIENTRY TexSubImage2D(GLenum target, GLint level, GLint xOffset, GLint yOffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+        g_currentFrame.textureUploadBytes += GetPixelTransferSize(width, height, format, type);
+        g_original.texSubImage2D(target, level, xOffset, yOffset, width, height, format, type, pixels);
+    }
+
+    void APIENTRY CompressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data) {
+        g_currentFrame.textureUploadBytes += imageSize;
+        g_original.compressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data);
+    }
+
+    void APIENTRY CompressedTexSubImage2D(GLenum target, GLint level, GLint xOffset, GLint yOffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data) {
+        g_currentFrame.textureUploadBytes += imageSize;
+        g_original.compressedTexSubImage2D(target, level, xOffset, yOffset, width, height, format, imageSize, data);
+    }
+
+    void APIENTRY TextureSubImage2D(GLuint texture, GLint level, GLint xOffset, GLint yOffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+        g_currentFrame.textureUploadBytes += GetPixelTransferSize(width, height, format, type);
+        g_original.textureSubImage2D(texture, level, xOffset, yOffset, width, height, format, type, pixels);
+    }
+
+    void APIENTRY CompressedTextureSubImage2D(GLuint texture, GLint level, GLint xOffset, GLint yOffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data) {
+        g_currentFrame.textureUploadBytes += imageSize;
+        g_original.compressedTextureSubImage2D(texture, level, xOffset, yOffset, width, height, format, imageSize, data);
+    }
+
+    void APIENTRY BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+        g_currentFrame.blitBytes += GetBlitSize(dstX0, dstY0, dstX1, dstY1, mask);
+        g_original.blitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    }
+
+    void APIENTRY BlitNamedFramebuffer(GLuint readFrameBuffer, GLuint drawFrameBuffer, GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+        g_currentFrame.blitBytes += GetBlitSize(dstX0, dstY0, dstX1, dstY1, mask);
+        g_original.blitNamedFramebuffer(readFrameBuffer, drawFrameBuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    }
+
+    /*
+    █ █▀█ █▀▀ ▀█▀ █▀█ █   █
+    █ █ █ ▀▀█  █  █▀█ █   █
+    ▀ ▀ ▀ ▀▀▀  ▀  ▀ ▀ ▀▀▀ ▀▀▀ */
+
+    void Install() {
+        if (g_installed) {
+            return;
+        }
+        g_boundProgram = UNKNOWN_BINDING;
+        g_boundVertexArray = UNKNOWN_BINDING;
+        g_boundDrawFrameBuffer = UNKNOWN_BINDING;
+        g_boundReadFrameBuffer = UNKNOWN_BINDING;
+        g_boundTextures.clear();
+        GLint activeTexture = GL_TEXTURE0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+        g_activeTextureUnit = activeTexture - GL_TEXTURE0;
+
+        OpenGLUtil::HookEntryPoint(glad_glDrawArrays, g_original.drawArrays, DrawArrays);
+        OpenGLUtil::HookEntryPoint(glad_glDrawArraysInstanced, g_original.drawArraysInstanced, DrawArraysInstanced);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElements, g_original.drawElements, DrawElements);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstanced, g_original.drawElementsInstanced, DrawElementsInstanced);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsBaseVertex, g_original.drawElementsBaseVertex, DrawElementsBaseVertex);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstancedBaseVertex, g_original.drawElementsInstancedBaseVertex, DrawElementsInstancedBaseVertex);
+        OpenGLUtil::HookEntryPoint(glad_glDrawElementsInstancedBaseVertexBaseInstance, g_original.drawElementsInstancedBaseVertexBaseInstance, DrawElementsInstancedBaseVertexBaseInstance);
+        OpenGLUtil::HookEntryPoint(glad_glMultiDrawElementsIndirect, g_original.multiDrawElementsIndirect, MultiDrawElementsIndirect);
+        OpenGLUtil::HookEntryPoint(glad_glMultiDrawElementsIndirectCount, g_original.multiDrawElementsIndirectCount, MultiDrawElementsIndirectCount);
+        OpenGLUtil::HookEntryPoint(glad_glDispatchCompute, g_original.dispatchCompute, DispatchCompute);
+        OpenGLUtil::HookEntryPoint(glad_glDispatchComputeIndirect, g_original.dispatchComputeIndirect, DispatchComputeIndirect);
+        OpenGLUtil::HookEntryPoint(glad_glUseProgram, g_original.useProgram, UseProgram);
+        OpenGLUtil::HookEntryPoint(glad_glActiveTexture, g_original.activeTexture, ActiveTexture);
+        OpenGLUtil::HookEntryPoint(glad_glBindTexture, g_original.bindTexture, BindTexture);
+        OpenGLUtil::HookEntryPoint(glad_glBindTextureUnit, g_original.bindTextureUnit, BindTextureUnit);
+        OpenGLUtil::HookEntryPoint(glad_glBindVertexArray, g_original.bindVertexArray, BindVertexArray);
+        OpenGLUtil::HookEntryPoint(glad_glBindFramebuffer, g_original.bindFramebuffer, BindFramebuffer);
+        OpenGLUtil::HookEntryPoint(glad_glDeleteTextures, g_original.deleteTextures, DeleteTextures);
+        OpenGLUtil::HookEntryPoint(glad_glDeleteVertexArrays, g_original.deleteVertexArrays, DeleteVertexArrays);
+        OpenGLUtil::HookEntryPoint(glad_glDeleteFramebuffers, g_original.deleteFramebuffers, DeleteFramebuffers);
+        OpenGLUtil::HookEntryPoint(glad_glBufferData, g_original.bufferData, BufferData);
+        OpenGLUtil::HookEntryPoint(glad_glBufferSubData, g_original.bufferSubData, BufferSubData);
+        OpenGLUtil::HookEntryPoint(glad_glBufferStorage, g_original.bufferStorage, BufferStorage);
+        OpenGLUtil::HookEntryPoint(glad_glNamedBufferData, g_original.namedBufferData, NamedBufferData);
+        OpenGLUtil::HookEntryPoint(glad_glNamedBufferSubData, g_original.namedBufferSubData, NamedBufferSubData);
+        OpenGLUtil::HookEntryPoint(glad_glNamedBufferStorage, g_original.namedBufferStorage, NamedBufferStorage);
+        OpenGLUtil::HookEntryPoint(glad_glMapBufferRange, g_original.mapBufferRange, MapBufferRange);
+        OpenGLUtil::HookEntryPoint(glad_glMapNamedBufferRange, g_original.mapNamedBufferRange, MapNamedBufferRange);
+        OpenGLUtil::HookEntryPoint(glad_glTexImage2D, g_original.texImage2D, TexImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glTexSubImage2D, g_original.texSubImage2D, TexSubImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glCompressedTexImage2D, g_original.compressedTexImage2D, CompressedTexImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glCompressedTexSubImage2D, g_original.compressedTexSubImage2D, CompressedTexSubImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glTextureSubImage2D, g_original.textureSubImage2D, TextureSubImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glCompressedTextureSubImage2D, g_original.compressedTextureSubImage2D, CompressedTextureSubImage2D);
+        OpenGLUtil::HookEntryPoint(glad_glBlitFramebuffer, g_original.blitFramebuffer, BlitFramebuffer);
+        OpenGLUtil::HookEntryPoint(glad_glBlitNamedFramebuffer, g_original.blitNamedFramebuffer, BlitNamedFramebuffer);
+
+        g_currentFrame = GLCommandCounters();
+        g_lastFrame = GLCommandCounters();
+        g_installed = true;
+        std::cout << "GL command stats enabled\n";
+    }
+
+    void Uninstall() {
+        if (!g_installed) {
+            return;
+        }
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawArrays, g_original.drawArrays);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawArraysInstanced, g_original.drawArraysInstanced);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElements, g_original.drawElements);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstanced, g_original.drawElementsInstanced);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsBaseVertex, g_original.drawElementsBaseVertex);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstancedBaseVertex, g_original.drawElementsInstancedBaseVertex);
+        OpenGLUtil::UnhookEntryPoint(glad_glDrawElementsInstancedBaseVertexBaseInstance, g_original.drawElementsInstancedBaseVertexBaseInstance);
+        OpenGLUtil::UnhookEntryPoint(glad_glMultiDrawElementsIndirect, g_original.multiDrawElementsIndirect);
+        OpenGLUtil::UnhookEntryPoint(glad_glMultiDrawElementsIndirectCount, g_original.multiDrawElementsIndirectCount);
+        OpenGLUtil::UnhookEntryPoint(glad_glDispatchCompute, g_original.dispatchCompute);
+        OpenGLUtil::UnhookEntryPoint(glad_glDispatchComputeIndirect, g_original.dispatchComputeIndirect);
+        OpenGLUtil::UnhookEntryPoint(glad_glUseProgram, g_original.useProgram);
+        OpenGLUtil::UnhookEntryPoint(glad_glActiveTexture, g_original.activeTexture);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindTexture, g_original.bindTexture);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindTextureUnit, g_original.bindTextureUnit);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindVertexArray, g_original.bindVertexArray);
+        OpenGLUtil::UnhookEntryPoint(glad_glBindFramebuffer, g_original.bindFramebuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glDeleteTextures, g_original.deleteTextures);
+        OpenGLUtil::UnhookEntryPoint(glad_glDeleteVertexArrays, g_original.deleteVertexArrays);
+        OpenGLUtil::UnhookEntryPoint(glad_glDeleteFramebuffers, g_original.deleteFramebuffers);
+        OpenGLUtil::UnhookEntryPoint(glad_glBufferData, g_original.bufferData);
+        OpenGLUtil::UnhookEntryPoint(glad_glBufferSubData, g_original.bufferSubData);
+        OpenGLUtil::UnhookEntryPoint(glad_glBufferStorage, g_original.bufferStorage);
+        OpenGLUtil::UnhookEntryPoint(glad_glNamedBufferData, g_original.namedBufferData);
+        OpenGLUtil::UnhookEntryPoint(glad_glNamedBufferSubData, g_original.namedBufferSubData);
+        OpenGLUtil::UnhookEntryPoint(glad_glNamedBufferStorage, g_original.namedBufferStorage);
+        OpenGLUtil::UnhookEntryPoint(glad_glMapBufferRange, g_original.mapBufferRange);
+        OpenGLUtil::UnhookEntryPoint(glad_glMapNamedBufferRange, g_original.mapNamedBufferRange);
+        OpenGLUtil::UnhookEntryPoint(glad_glTexImage2D, g_original.texImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glTexSubImage2D, g_original.texSubImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glCompressedTexImage2D, g_original.compressedTexImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glCompressedTexSubImage2D, g_original.compressedTexSubImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glTextureSubImage2D, g_original.textureSubImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glCompressedTextureSubImage2D, g_original.compressedTextureSubImage2D);
+        OpenGLUtil::UnhookEntryPoint(glad_glBlitFramebuffer, g_original.blitFramebuffer);
+        OpenGLUtil::UnhookEntryPoint(glad_glBlitNamedFramebuffer, g_original.blitNamedFramebuffer);
+        g_installed = false;
+        std::cout << "GL command stats disabled\n";
+    }
+
+    void ToggleInstalled() {
+        if (g_installed) {
+            Uninstall();
+        }
+        else {
+            Install();
+        }
+    }
+
+    bool IsInstalled() {
+        return g_installed;
+    }
+
+    void EndFrame() {
+        g_lastFrame = g_currentFrame;
+        g_currentFrame = GLCommandCounters();
+    }
+
+    const GLCommandCounters& GetCurrentFrameCounters() {
+        return g_currentFrame;
+    }
+
+    const GLCommandCounters& GetLastFrameCounters() {
+        return g_lastFrame;
+    }
+
+    std::string GetHUDText() {
+        const GLCommandCounters& counters = g_lastFrame;
+        std::string text;
+        text += "Draws: " + std::to_string(counters.drawCalls) + "  Dispatches: " + std::to_string(counters.dispatches) + "\n";
+        text += "Programs: " + std::to_string(counters.programBinds) + " / " + std::to_string(counters.redundantProgramBinds) + " redundant\n";
+        text += "Textures: " + std::to_string(counters.textureBinds) + " / " + std::to_string(counters.redundantTextureBinds) + " redundant\n";
+        text += "VAOs: " + std::to_string(counters.vertexArrayBinds) + " / " + std::to_string(counters.redundantVertexArrayBinds) + " redundant\n";
+        text += "FBOs: " + std::to_string(counters.frameBufferBinds) + " / " + std::to_string(counters.redundantFrameBufferBinds) + " redundant\n";
+        text += "Buffer upload: " + std::format("{:.1f}", counters.bufferUploadBytes / 1024.0) + " KB\n";
+        text += "Texture upload: " + std::format("{:.1f}", counters.textureUploadBytes / 1024.0) + " KB\n";
+        text += "Blit: " + std::format("{:.1f}", counters.blitBytes / 1024.0) + " KB\n";
+        return text;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct GLCommandCounters {
+    uint32_t drawCalls = 0;
+    uint32_t dispatches = 0;
+    uint32_t programBinds = 0;
+    uint32_t redundantProgramBinds = 0;
+    uint32_t textureBinds = 0;
+    uint32_t redundantTextureBinds = 0;
+    uint32_t vertexArrayBinds = 0;
+    uint32_t redundantVertexArrayBinds = 0;
+    uint32_t frameBufferBinds = 0;
+    uint32_t redundantFrameBufferBinds = 0;
+    uint64_t bufferUploadBytes = 0;
+    uint64_t textureUploadBytes = 0;
+    uint64_t blitBytes = 0;
+};
+
+namespace OpenGLStats {
+    // Swaps the glad entry points for counting wrappers, call after glad has loaded
+    void Install();
+    void Uninstall();
+    void ToggleInstalled();
+    bool IsInstalled();
+    void EndFrame();
+    const GLCommandCounters& GetCurrentFrameCounters();
+    const GLCommandCounters& GetLastFrameCounters();
+    std::string GetHUDText();
+}
@@ -6,6 +6,23 @@
 
 namespace OpenGLUtil {
 
+    // Swaps a glad entry point for a wrapper, remembering the original so it can be forwarded to and restored
+    template <typename T>
+    inline void HookEntryPoint(T& entryPoint, T& original, T wrapper) {
+        original = entryPoint;
+        if (entryPoint) {
+            entryPoint = wrapper;
+        }
+    }
+
+    template <typename T>
+    inline void UnhookEntryPoint(T& entryPoint, T& original) {
+        if (original) {
+            entryPoint = original;
+        }
+        original = nullptr;
+    }
+
     inline bool ExtensionExists(const std::string& extensionName) {
         static std::vector<std::string> extensionsCache;
         if (extensionsCache.empty()) {
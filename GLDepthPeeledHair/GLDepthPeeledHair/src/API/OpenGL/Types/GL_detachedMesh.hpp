@@ -1,9 +1,13 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include "Types.h"
+#include "../GL_geometryArena.h"
+#include "../../../Common/VertexCompression.hpp"
+#include "../../../File/FileFormats.h"
 
 struct OpenGLDetachedMesh {
 
@@ -12,6 +16,9 @@ private:
     unsigned int VAO = 0;
     unsigned int EBO = 0;
     std::string m_name;
+    GeometryAllocation m_arenaAllocation;
+    std::vector<MeshLod> m_lods;
+    std::vector<MeshCluster> m_clusters;
 
 public:
     std::vector<Vertex> vertices;
@@ -28,13 +35,82 @@ public:
     }
 
     int GetVertexCount() {
-        return vertices.size();
+        return m_arenaAllocation.IsValid() ? m_arenaAllocation.vertexCount : vertices.size();
     }
     int GetIndexCount() {
-        return indices.size();
+        return GetLod(0).indexCount;
+    }
+    int GetLodCount() {
+        return std::max((int)m_lods.size(), 1);
+    }
+    // Meshes without a LOD table are a single level covering every index
+    MeshLod GetLod(int lodIndex) {
+        uint32_t indexCount = m_arenaAllocation.IsValid() ? m_arenaAllocation.indexCount : (uint32_t)indices.size();
+        return m_lods.empty() ? MeshLod{ 0, indexCount, 0.0f, 1.0f } : m_lods[std::clamp(lodIndex, 0, (int)m_lods.size() - 1)];
     }
     int GetVAO() {
-        return VAO;
+        return m_arenaAllocation.IsValid() ? OpenGLGeometryArena::GetVAO() : VAO;
+    }
+    int GetBaseVertex() {
+        return m_arenaAllocation.IsValid() ? m_arenaAllocation.baseVertex : 0;
+    }
+    int GetFirstIndex() {
+        return m_arenaAllocation.IsValid() ? m_arenaAllocation.firstIndex : 0;
+    }
+    int GetIndexCount(int lodIndex) {
+        return GetLod(lodIndex).indexCount;
+    }
+    int GetFirstIndex(int lodIndex) {
+        return GetFirstIndex() + GetLod(lodIndex).firstIndex;
+    }
+    // Cluster ranges are relative to LOD 0, only hair meshes have them
+    void SetClusters(const std::vector<MeshCluster>& clusters) {
+        m_clusters = clusters;
+    }
+    const std::vector<MeshCluster>& GetClusters() {
+        return m_clusters;
+    }
+    // Static meshes suballocate from the shared geometry arena instead of owning a VAO, draw them with GetBaseVertex() and GetFirstIndex().
+    // With LODs the indices are every level back to back and lods gives each level's range, empty means a single level.
+    // The GPU copy is the only one unless keepCPUData asks for vertices and indices to stay around too.
+    void UploadToArena(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, const std::vector<MeshLod>& lods = {}, bool keepCPUData = false) {
+        this->vertices = keepCPUData ? vertices : std::vector<Vertex>();
+        this->indices = keepCPUData ? indices : std::vector<uint32_t>();
+        m_lods = lods;
+        OpenGLGeometryArena::Free(m_arenaAllocation);
+        m_arenaAllocation = OpenGLGeometryArena::Allocate(vertices, indices);
+    }
+    // Same, but straight from a mapped .model file
+    void UploadToArena(const MappedMeshView& meshView, bool keepCPUData = false) {
+        vertices.clear();
+        indices.clear();
+        if (keepCPUData) {
+            vertices.resize(meshView.vertexCount);
+            for (uint32_t i = 0; i < meshView.vertexCount; i++) {
+                vertices[i] = VertexCompression::Unpack(meshView.vertices[i]);
+            }
+            indices.resize(meshView.indexCount);
+            for (uint32_t i = 0; i < meshView.indexCount; i++) {
+                indices[i] = (meshView.indexSize == 2) ? static_cast<const uint16_t*>(meshView.indices)[i] : static_cast<const uint32_t*>(meshView.indices)[i];
+            }
+        }
+        m_lods.assign(meshView.lods, meshView.lods + meshView.lodCount);
+        m_clusters.assign(meshView.clusters, meshView.clusters + meshView.clusterCount);
+        OpenGLGeometryArena::Free(m_arenaAllocation);
+        m_arenaAllocation = OpenGLGeometryArena::Allocate(meshView.vertices, meshView.vertexCount, meshView.indices, meshView.indexCount, meshView.indexSize);
+    }
+    void CleanUp() {
+        OpenGLGeometryArena::Free(m_arenaAllocation);
+        m_lods.clear();
+        m_clusters.clear();
+        if (VAO != 0) {
+            glDeleteVertexArrays(1, &VAO);
+            glDeleteBuffers(1, &VBO);
+            glDeleteBuffers(1, &EBO);
+            VAO = VBO = EBO = 0;
+        }
+        vertices.clear();
+        indices.clear();
     }
     void UpdateVertexBuffer(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
         this->indices = indices;
@@ -53,24 +129,25 @@ public:
             glDeleteBuffers(1, &VBO);
             glDeleteBuffers(1, &EBO);
         }
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), &indices[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, uv));
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        // DSA so rebuilding the debug meshes mid frame leaves the state cache bindings untouched
+        glCreateVertexArrays(1, &VAO);
+        glCreateBuffers(1, &VBO);
+        glCreateBuffers(1, &EBO);
+        glNamedBufferData(VBO, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+        glNamedBufferData(EBO, indices.size() * sizeof(uint32_t), &indices[0], GL_STATIC_DRAW);
+        glVertexArrayVertexBuffer(VAO, 0, VBO, 0, sizeof(Vertex));
+        glVertexArrayElementBuffer(VAO, EBO);
+        glEnableVertexArrayAttrib(VAO, 0);
+        glEnableVertexArrayAttrib(VAO, 1);
+        glEnableVertexArrayAttrib(VAO, 2);
+        glEnableVertexArrayAttrib(VAO, 3);
+        glVertexArrayAttribFormat(VAO, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+        glVertexArrayAttribFormat(VAO, 1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
+        glVertexArrayAttribFormat(VAO, 2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv));
+        glVertexArrayAttribFormat(VAO, 3, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, tangent));
+        glVertexArrayAttribBinding(VAO, 0, 0);
+        glVertexArrayAttribBinding(VAO, 1, 0);
+        glVertexArrayAttribBinding(VAO, 2, 0);
+        glVertexArrayAttribBinding(VAO, 3, 0);
     }
 };
\ No newline at end of file
@@ -25,26 +25,22 @@ public:
             Create();
             m_vertexBufferSize = vertexBufferSize;
             m_indexBufferSize = indexBufferSize;
-            glBindVertexArray(m_vao);
-            glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-            glBufferData(GL_ARRAY_BUFFER, vertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            glNamedBufferData(m_vbo, vertexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            glNamedBufferData(m_ebo, indexBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            glVertexArrayVertexBuffer(m_vao, 0, m_vbo, 0, sizeof(FontVertex));
+            glVertexArrayElementBuffer(m_vao, m_ebo);
+            glEnableVertexArrayAttrib(m_vao, 0);
+            glEnableVertexArrayAttrib(m_vao, 1);
+            glEnableVertexArrayAttrib(m_vao, 2);
+            glVertexArrayAttribFormat(m_vao, 0, 2, GL_FLOAT, GL_FALSE, offsetof(FontVertex, position));
+            glVertexArrayAttribFormat(m_vao, 1, 2, GL_FLOAT, GL_FALSE, offsetof(FontVertex, uv));
+            glVertexArrayAttribFormat(m_vao, 2, 3, GL_FLOAT, GL_FALSE, offsetof(FontVertex, color));
+            glVertexArrayAttribBinding(m_vao, 0, 0);
+            glVertexArrayAttribBinding(m_vao, 1, 0);
+            glVertexArrayAttribBinding(m_vao, 2, 0);
         }
-        glBindVertexArray(m_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBufferSize, vertices.data());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexBufferSize, indices.data());
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(FontVertex), (void*)0);
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(FontVertex), (void*)offsetof(FontVertex, uv));
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(FontVertex), (void*)offsetof(FontVertex, color));
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glNamedBufferSubData(m_vbo, 0, vertexBufferSize, vertices.data());
+        glNamedBufferSubData(m_ebo, 0, indexBufferSize, indices.data());
     }
 
     int GetVAO() {
@@ -56,9 +52,9 @@ public:
     }
 
     void Create() {
-        glGenVertexArrays(1, &m_vao);
-        glGenBuffers(1, &m_vbo);
-        glGenBuffers(1, &m_ebo);
+        glCreateVertexArrays(1, &m_vao);
+        glCreateBuffers(1, &m_vbo);
+        glCreateBuffers(1, &m_ebo);
     }
 
     void CleanUp() {
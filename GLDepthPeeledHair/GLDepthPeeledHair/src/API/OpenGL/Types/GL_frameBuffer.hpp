@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include "../GL_backend.h"
 
 struct ColorAttachment {
     const char* name = "undefined";
@@ -40,7 +41,14 @@ public:
     }
 
     void CleanUp() {
+        for (ColorAttachment& colorAttachment : colorAttachments) {
+            glDeleteTextures(1, &colorAttachment.handle);
+        }
         colorAttachments.clear();
+        if (depthAttachment.handle != 0) {
+            glDeleteTextures(1, &depthAttachment.handle);
+            depthAttachment.handle = 0;
+        }
         glDeleteFramebuffers(1, &handle);
     }
 
@@ -75,11 +83,11 @@ public:
     }
 
     void Bind() {
-        glBindFramebuffer(GL_FRAMEBUFFER, handle);
+        OpenGLBackend::BindFrameBuffer(GL_FRAMEBUFFER, handle);
     }
 
     void SetViewport() {
-        glViewport(0, 0, width, height);
+        OpenGLBackend::SetViewport(0, 0, width, height);
     }
 
     void DrawBuffers(std::vector<const char*> attachmentNames) {
@@ -152,8 +160,8 @@ public:
     }
 
     void BlitToDefaultFrameBuffer(const char* srcName, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, GetHandle());
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        OpenGLBackend::BindFrameBuffer(GL_READ_FRAMEBUFFER, GetHandle());
+        OpenGLBackend::BindFrameBuffer(GL_DRAW_FRAMEBUFFER, 0);
         glReadBuffer(GetColorAttachmentSlotByName(srcName));
         glDrawBuffer(GL_BACK);
         glBlitFramebuffer(0, 0, GetWidth(), GetHeight(), dstX0, dstY0, dstX1, dstY1, mask, filter);
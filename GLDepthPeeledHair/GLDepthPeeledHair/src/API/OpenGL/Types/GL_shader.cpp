@@ -1,5 +1,7 @@
 #include "GL_shader.h"
+#include "../GL_backend.h"
 #include <glad/glad.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
@@ -12,7 +14,7 @@ std::string GetLinkingErrors(unsigned int shader);
 std::string GetShaderCompileErrors(unsigned int shader, const std::string& filename, const std::vector<std::string>& lineToFile);
 
 void Shader::Use() {
-    glUseProgram(m_handle);
+    OpenGLBackend::UseProgram(m_handle);
 }
 
 bool Shader::Load(std::vector<std::string> shaderPaths) {
@@ -72,7 +74,7 @@ bool Shader::Load(std::vector<std::string> shaderPaths) {
             glDeleteProgram(m_handle);
         }
         m_handle = tempHandle;
-        m_uniformLocations.clear();
+        ReflectUniforms();
     }
     for (ShaderModule& module : modules) {
         glDeleteShader(tempHandle);
@@ -80,88 +82,105 @@ bool Shader::Load(std::vector<std::string> shaderPaths) {
     return true;
 }
 
-void Shader::SetBool(const std::string& name, bool value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform1i(m_uniformLocations[name], (int)value);
+void Shader::SetBool(UniformName name, bool value) {
+    glProgramUniform1i(m_handle, FindUniformLocation(name.hash), (int)value);
 }
 
-void Shader::SetInt(const std::string& name, int value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform1i(m_uniformLocations[name], value);
+void Shader::SetInt(UniformName name, int value) {
+    glProgramUniform1i(m_handle, FindUniformLocation(name.hash), value);
 }
 
-void Shader::SetFloat(const std::string& name, float value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform1f(m_uniformLocations[name], value);
+void Shader::SetFloat(UniformName name, float value) {
+    glProgramUniform1f(m_handle, FindUniformLocation(name.hash), value);
 }
 
-void Shader::SetMat2(const std::string& name, const glm::mat2& mat) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniformMatrix2fv(m_uniformLocations[name], 1, GL_FALSE, &mat[0][0]);
+void Shader::SetMat2(UniformName name, const glm::mat2& mat) {
+    glProgramUniformMatrix2fv(m_handle, FindUniformLocation(name.hash), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::SetMat3(const std::string& name, const glm::mat3& mat) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniformMatrix3fv(m_uniformLocations[name], 1, GL_FALSE, &mat[0][0]);
+void Shader::SetMat3(UniformName name, const glm::mat3& mat) {
+    glProgramUniformMatrix3fv(m_handle, FindUniformLocation(name.hash), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::SetMat4(const std::string& name, glm::mat4 value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniformMatrix4fv(m_uniformLocations[name], 1, GL_FALSE, &value[0][0]);
+void Shader::SetMat4(UniformName name, const glm::mat4& value) {
+    glProgramUniformMatrix4fv(m_handle, FindUniformLocation(name.hash), 1, GL_FALSE, &value[0][0]);
 }
 
-void Shader::SetVec2(const std::string& name, const glm::vec2& value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform2fv(m_uniformLocations[name], 1, &value[0]);
+void Shader::SetVec2(UniformName name, const glm::vec2& value) {
+    glProgramUniform2fv(m_handle, FindUniformLocation(name.hash), 1, &value[0]);
 }
 
-void Shader::SetVec3(const std::string& name, const glm::vec3& value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform3fv(m_uniformLocations[name], 1, &value[0]);
+void Shader::SetVec3(UniformName name, const glm::vec3& value) {
+    glProgramUniform3fv(m_handle, FindUniformLocation(name.hash), 1, &value[0]);
 }
 
-void Shader::SetVec4(const std::string& name, const glm::vec4& value) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform4fv(m_uniformLocations[name], 1, &value[0]);
+void Shader::SetVec4(UniformName name, const glm::vec4& value) {
+    glProgramUniform4fv(m_handle, FindUniformLocation(name.hash), 1, &value[0]);
 }
 
-void Shader::SetVec2(const std::string& name, float x, float y) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform2f(m_uniformLocations[name], x, y);
+void Shader::SetVec2(UniformName name, float x, float y) {
+    SetVec2(name, glm::vec2(x, y));
 }
 
-void Shader::SetVec3(const std::string& name, float x, float y, float z) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
-    }
-    glUniform3f(m_uniformLocations[name], x, y, z);
+void Shader::SetVec3(UniformName name, float x, float y, float z) {
+    SetVec3(name, glm::vec3(x, y, z));
+}
+
+void Shader::SetVec4(UniformName name, float x, float y, float z, float w) {
+    SetVec4(name, glm::vec4(x, y, z, w));
 }
 
-void Shader::SetVec4(const std::string& name, float x, float y, float z, float w) {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end()) {
-        m_uniformLocations[name] = glGetUniformLocation(m_handle, name.c_str());
+int Shader::GetUniformLocation(UniformName name) {
+    return FindUniformLocation(name.hash);
+}
+
+int Shader::GetUniformLocation(const std::string& name) {
+    return FindUniformLocation(UniformName::Hash(name));
+}
+
+const std::vector<ShaderUniform>& Shader::GetUniforms() {
+    return m_uniforms;
+}
+
+int Shader::FindUniformLocation(uint32_t hash) {
+    auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), hash, [](const ShaderUniform& uniform, uint32_t hash) {
+        return uniform.hash < hash;
+    });
+    return (it != m_uniforms.end() && it->hash == hash) ? it->location : -1;
+}
+
+// Block members have no location and are skipped, arrays are stored under their base name
+void Shader::ReflectUniforms() {
+    m_uniforms.clear();
+    GLint uniformCount = 0;
+    glGetProgramInterfaceiv(m_handle, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+    const GLenum properties[] = { GL_NAME_LENGTH, GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE };
+    for (int i = 0; i < uniformCount; i++) {
+        GLint values[4];
+        glGetProgramResourceiv(m_handle, GL_UNIFORM, i, 4, properties, 4, nullptr, values);
+        if (values[1] == -1) {
+            continue;
+        }
+        ShaderUniform& uniform = m_uniforms.emplace_back();
+        uniform.name.resize(values[0]);
+        glGetProgramResourceName(m_handle, GL_UNIFORM, i, values[0], nullptr, uniform.name.data());
+        uniform.name.resize(values[0] - 1); // Drop the null terminator
+        if (uniform.name.ends_with("[0]")) {
+            uniform.name.resize(uniform.name.size() - 3);
+        }
+        uniform.hash = UniformName::Hash(uniform.name);
+        uniform.location = values[1];
+        uniform.type = values[2];
+        uniform.arraySize = values[3];
+    }
+    std::sort(m_uniforms.begin(), m_uniforms.end(), [](const ShaderUniform& a, const ShaderUniform& b) {
+        return a.hash < b.hash;
+    });
+    for (int i = 1; i < m_uniforms.size(); i++) {
+        if (m_uniforms[i].hash == m_uniforms[i - 1].hash) {
+            std::cout << "Shader::ReflectUniforms() failed because '" << m_uniforms[i - 1].name << "' and '" << m_uniforms[i].name << "' hash to the same value\n";
+        }
     }
-    glUniform4f(m_uniformLocations[name], x, y, z, w);
 }
 
 int Shader::GetHandle() {
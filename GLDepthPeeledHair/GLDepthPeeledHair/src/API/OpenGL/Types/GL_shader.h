@@ -1,7 +1,9 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct ShaderModule {
@@ -19,24 +21,55 @@ private:
     std::vector<std::string> m_lineMap;
 };
 
+// FNV-1a of a uniform name. The constructor is consteval, so a literal at a call site is hashed by the compiler.
+struct UniformName {
+    consteval UniformName(const char* name) : hash(Hash(name)), name(name) {}
+
+    static constexpr uint32_t Hash(std::string_view name) {
+        uint32_t hash = 2166136261u;
+        for (char c : name) {
+            hash ^= (uint8_t)c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    uint32_t hash;
+    const char* name;
+};
+
+struct ShaderUniform {
+    std::string name;
+    uint32_t hash = 0;
+    int location = -1;
+    uint32_t type = 0;
+    int arraySize = 0;
+};
+
 struct Shader {
 public:
     void Use();
     bool Load(std::vector<std::string> shaderPaths);
-    void SetInt(const std::string& name, int value);
-    void SetBool(const std::string& name, bool value);
-    void SetFloat(const std::string& name, float value);
-    void SetMat2(const std::string& name, const glm::mat2& mat);
-    void SetMat3(const std::string& name, const glm::mat3& mat);
-    void SetMat4(const std::string& name, glm::mat4 value);
-    void SetVec2(const std::string& name, const glm::vec2& value);
-    void SetVec4(const std::string& name, const glm::vec4& value);
-    void SetVec3(const std::string& name, const glm::vec3& value);
-    void SetVec2(const std::string& name, float x, float y);
-    void SetVec3(const std::string& name, float x, float y, float z);
-    void SetVec4(const std::string& name, float x, float y, float z, float w);
+    // Setters write straight into the program with glProgramUniform*, the shader does not need to be bound
+    void SetInt(UniformName name, int value);
+    void SetBool(UniformName name, bool value);
+    void SetFloat(UniformName name, float value);
+    void SetMat2(UniformName name, const glm::mat2& mat);
+    void SetMat3(UniformName name, const glm::mat3& mat);
+    void SetMat4(UniformName name, const glm::mat4& value);
+    void SetVec2(UniformName name, const glm::vec2& value);
+    void SetVec4(UniformName name, const glm::vec4& value);
+    void SetVec3(UniformName name, const glm::vec3& value);
+    void SetVec2(UniformName name, float x, float y);
+    void SetVec3(UniformName name, float x, float y, float z);
+    void SetVec4(UniformName name, float x, float y, float z, float w);
+    int GetUniformLocation(UniformName name);
+    int GetUniformLocation(const std::string& name);
+    const std::vector<ShaderUniform>& GetUniforms();
     int GetHandle();
 private:
-    std::unordered_map<std::string, int> m_uniformLocations;
+    void ReflectUniforms();
+    int FindUniformLocation(uint32_t hash);
+    std::vector<ShaderUniform> m_uniforms; // Sorted by hash
     int m_handle = -1;
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+
+// Immutable storage buffer that is reallocated whenever an update outgrows it. Also used as the indirect draw buffer.
+struct SSBO {
+public:
+    void Update(size_t size, const void* data) {
+        if (size == 0) {
+            return;
+        }
+        if (size > m_capacity) {
+            CleanUp();
+            m_capacity = size + size / 2;
+            glCreateBuffers(1, &m_handle);
+            glNamedBufferStorage(m_handle, m_capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        }
+        glNamedBufferSubData(m_handle, 0, size, data);
+        m_size = size;
+    }
+
+    // Grows the storage without uploading anything, for buffers the GPU fills itself
+    void Reserve(size_t size) {
+        if (size > m_capacity) {
+            CleanUp();
+            m_capacity = size + size / 2;
+            glCreateBuffers(1, &m_handle);
+            glNamedBufferStorage(m_handle, m_capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        }
+        m_size = size;
+    }
+
+    void Bind(unsigned int index) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, m_handle);
+    }
+
+    uint32_t GetHandle() const {
+        return m_handle;
+    }
+
+    size_t GetSize() const {
+        return m_size;
+    }
+
+    void CleanUp() {
+        if (m_handle != 0) {
+            glDeleteBuffers(1, &m_handle);
+            m_handle = 0;
+        }
+        m_capacity = 0;
+        m_size = 0;
+    }
+
+private:
+    uint32_t m_handle = 0;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// One persistently mapped upload buffer used as a ring. Allocations are handed out back to back from the head, Fence() closes
+// everything allocated since the last fence behind a single sync object, and Reclaim() frees fenced regions strictly in order.
+struct StagingRing {
+public:
+    void Init(size_t size) {
+        m_size = size;
+        glCreateBuffers(1, &m_handle);
+        glNamedBufferStorage(m_handle, size, nullptr, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        m_persistentBuffer = (GLubyte*)glMapNamedBufferRange(m_handle, 0, size, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+    }
+
+    // Returns nullptr when the free part of the ring can't hold the allocation yet. Padding skipped for alignment, or at the
+    // end of the buffer when the allocation has to wrap, counts as used until its region is reclaimed.
+    GLubyte* Allocate(size_t size, size_t alignment, size_t& offset) {
+        if (size == 0 || size > m_size) {
+            return nullptr;
+        }
+        if (m_usedSize == 0) {
+            m_head = 0;
+        }
+        offset = (m_head + alignment - 1) / alignment * alignment;
+        if (offset + size > m_size) {
+            offset = 0;
+        }
+        size_t padding = (offset >= m_head) ? offset - m_head : m_size - m_head;
+        if (m_usedSize + padding + size > m_size) {
+            return nullptr;
+        }
+        m_head = offset + size;
+        m_usedSize += padding + size;
+        m_openRegionSize += padding + size;
+        m_peakUsedSize = std::max(m_peakUsedSize, m_usedSize);
+        return m_persistentBuffer + offset;
+    }
+
+    // The values come back out of Reclaim() once the GPU has consumed every allocation made before this call
+    void Fence(const std::vector<int>& values) {
+        if (m_openRegionSize == 0 && values.empty()) {
+            return;
+        }
+        FencedRegion& region = m_fencedRegions.emplace_back();
+        region.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region.size = m_openRegionSize;
+        region.values = values;
+        m_openRegionSize = 0;
+    }
+
+    void Reclaim(std::vector<int>& signaledValues) {
+        while (m_fencedRegions.size()) {
+            FencedRegion& region = m_fencedRegions.front();
+            GLenum result = glClientWaitSync(region.sync, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                break;
+            }
+            glDeleteSync(region.sync);
+            m_usedSize -= region.size;
+            signaledValues.insert(signaledValues.end(), region.values.begin(), region.values.end());
+            m_fencedRegions.pop_front();
+        }
+    }
+
+    uint32_t GetHandle() const {
+        return m_handle;
+    }
+
+    size_t GetSize() const {
+        return m_size;
+    }
+
+    size_t GetUsedSize() const {
+        return m_usedSize;
+    }
+
+    size_t GetPeakUsedSize() const {
+        return m_peakUsedSize;
+    }
+
+    size_t GetFenceCount() const {
+        return m_fencedRegions.size();
+    }
+
+    void CleanUp() {
+        for (FencedRegion& region : m_fencedRegions) {
+            glDeleteSync(region.sync);
+        }
+        m_fencedRegions.clear();
+        if (m_persistentBuffer) {
+            glUnmapNamedBuffer(m_handle);
+            m_persistentBuffer = nullptr;
+        }
+        if (m_handle != 0) {
+            glDeleteBuffers(1, &m_handle);
+            m_handle = 0;
+        }
+        m_size = 0;
+        m_head = 0;
+        m_usedSize = 0;
+        m_openRegionSize = 0;
+    }
+
+private:
+    struct FencedRegion {
+        GLsync sync = nullptr;
+        size_t size = 0;
+        std::vector<int> values;
+    };
+
+    GLubyte* m_persistentBuffer = nullptr;
+    uint32_t m_handle = 0;
+    size_t m_size = 0;
+    size_t m_head = 0;
+    size_t m_usedSize = 0;
+    size_t m_openRegionSize = 0;
+    size_t m_peakUsedSize = 0;
+    std::deque<FencedRegion> m_fencedRegions;
+};
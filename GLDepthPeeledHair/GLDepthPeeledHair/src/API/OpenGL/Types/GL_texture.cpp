@@ -7,10 +7,11 @@
 #include "../GL_util.hpp"
 #include "tinyexr.h"
 
-#define ALLOW_BINDLESS_TEXTURES 0
+#define ALLOW_BINDLESS_TEXTURES 1
 
+// Zero unless the handle is currently resident, so callers can fall back to binding
 GLuint64 OpenGLTexture::GetBindlessID() {
-    return m_bindlessID;
+    return m_bindlessResident ? m_bindlessID : 0;
 }
 
 TextureData LoadEXRData(std::string filepath) {
@@ -194,17 +195,22 @@ void OpenGLTexture::SetMagFilter(TextureFilter filter) {
 
 void OpenGLTexture::MakeBindlessTextureResident() {
 #if ALLOW_BINDLESS_TEXTURES
+    if (m_bindlessResident || m_handle == 0 || !GLAD_GL_ARB_bindless_texture) {
+        return;
+    }
     if (m_bindlessID == 0) {
         m_bindlessID = glGetTextureHandleARB(m_handle);
     }
     glMakeTextureHandleResidentARB(m_bindlessID);
+    m_bindlessResident = true;
 #endif
 }
 
 void OpenGLTexture::MakeBindlessTextureNonResident() {
 #if ALLOW_BINDLESS_TEXTURES
-    if (m_bindlessID == 0) {
+    if (m_bindlessResident) {
         glMakeTextureHandleNonResidentARB(m_bindlessID);
+        m_bindlessResident = false;
     }
 #endif
 }
\ No newline at end of file
@@ -36,6 +36,7 @@ public:
 private:
     GLuint m_handle = 0;
     GLuint64 m_bindlessID = 0;
+    bool m_bindlessResident = false;
     int m_width = 0;
     int m_height = 0;
     int m_channelCount = 0;
@@ -0,0 +1,40 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+
+// Fixed size uniform buffer, allocated on the first update and rewritten in place after that
+struct UBO {
+public:
+    void Update(size_t size, const void* data) {
+        if (size == 0) {
+            return;
+        }
+        if (size != m_size) {
+            CleanUp();
+            glCreateBuffers(1, &m_handle);
+            glNamedBufferStorage(m_handle, size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+            m_size = size;
+        }
+        glNamedBufferSubData(m_handle, 0, size, data);
+    }
+
+    void Bind(unsigned int index) {
+        glBindBufferBase(GL_UNIFORM_BUFFER, index, m_handle);
+    }
+
+    uint32_t GetHandle() const {
+        return m_handle;
+    }
+
+    void CleanUp() {
+        if (m_handle != 0) {
+            glDeleteBuffers(1, &m_handle);
+            m_handle = 0;
+        }
+        m_size = 0;
+    }
+
+private:
+    uint32_t m_handle = 0;
+    size_t m_size = 0;
+};
@@ -1,9 +1,16 @@
 ﻿#pragma once
 #include "AssetManager.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include "../AssetManagement/BakeQueue.h"
 #include "../API/OpenGL/GL_backend.h"
 #include "../API/OpenGL/GL_util.hpp"
+#include "../Common/Primtives.hpp"
+#include "../Core/JobSystem.h"
 #include "../File/AssimpImporter.h"
 #include "../Tools/ImageTools.h"
 #include "../Util.hpp"
@@ -17,28 +24,67 @@ namespace AssetManager {
     std::unordered_map<std::string, int> g_textureIndexMap;
     std::unordered_map<std::string, int> g_materialIndexMap;
     std::unordered_map<std::string, int> g_modelIndexMap;
+    bool g_keepCPUMeshData = false;
+    int g_placeholderMeshIndex = -1;
+
+    // Read on a worker, uploaded on the main thread by FinalizeLoadedModels()
+    struct LoadedModel {
+        int modelIndex = -1;
+        bool mapped = false;
+        MappedModel mappedModel;
+        ModelData modelData;            // Only for files older than the mapped format
+        size_t nextMeshIndex = 0;
+        std::vector<uint32_t> meshIndices;
+    };
+
+    constexpr double MODEL_FINALIZE_BUDGET_MS = 2.0;
+
+    std::mutex g_loadedModelsMutex;
+    std::deque<std::unique_ptr<LoadedModel>> g_loadedModels;
+    std::unique_ptr<LoadedModel> g_finalizingModel;
+    std::atomic<int> g_pendingModelCount = 0;
+
+    // Decoded on a worker, allocated and queued for baking on the main thread by FinalizeDecodedTextures()
+    std::mutex g_decodedTexturesMutex;
+    std::vector<int> g_decodedTextureIndices;
+    JobCounter g_textureCounter;
+    int g_minimumTextureCount = 0;  // Fonts and load_at_init textures come first in g_textures and upload as UI
 
     void LoadMinimum();
+    void CreatePlaceholderMesh();
     void LoadModelsAsync();
+    void FinalizeLoadedModels(double budgetMs);
     void LoadTexturesAsync();
     void LoadTexture(Texture* texture);
     void BuildMaterials();
-    void LoadPendingTexturesAsync();
-    void CompressMissingDDSTexutres();
+    void LoadPendingTexturesAsync(JobPriority priority, JobCounter& counter);
+    void SubmitTextureJob(int textureIndex, const std::string& compressFromPath, JobPriority priority, JobCounter& counter);
+    void FinalizeDecodedTextures();
     bool FileInfoIsAlbedoTexture(const FileInfo& fileInfo);
     std::string GetMaterialNameFromFileInfo(const FileInfo& fileInfo);
 
+    // Only the minimum is resident when this returns, models and textures stream in over the following frames
     void Init() {
-        CompressMissingDDSTexutres();
         LoadMinimum();
+        CreatePlaceholderMesh();
         LoadModelsAsync();
         LoadTexturesAsync();
         BuildMaterials();
     }
 
     void Update() {
+        FinalizeLoadedModels(MODEL_FINALIZE_BUDGET_MS);
+        FinalizeDecodedTextures();
         for (Texture& texture : g_textures) {
+            // No handle means a worker may still be decoding it, its state isn't safe to read until it's allocated
+            if (texture.GetGLTexture().GetHandle() == 0) {
+                continue;
+            }
             texture.CheckForBakeCompletion();
+            // Handles can only be taken once every level is baked, the texture state is frozen from then on
+            if (texture.BakeComplete()) {
+                texture.GetGLTexture().MakeBindlessTextureResident();
+            }
         }
     }
 
@@ -53,32 +99,58 @@ namespace AssetManager {
     █ █ █ █ █ █ █ █▀▀ █
     ▀   ▀ ▀▀▀ ▀▀  ▀▀▀ ▀▀▀ */
 
-    void LoadModelsAsync() {
-        // Scan for new obj and fbx and export custom model format
-        for (FileInfo& fileInfo : Util::IterateDirectory("res/models_raw", { "obj", "fbx" })) {
-            std::string assetPath = "res/models/" + fileInfo.name + ".model";
-
-            // If the file exists but timestamps don't match, re-export
-            if (Util::FileExists(assetPath)) {
-                uint64_t lastModified = File::GetLastModifiedTime(fileInfo.path);
-                ModelHeader modelHeader = File::ReadModelHeader(assetPath);
-                if (modelHeader.timestamp != lastModified) {
-                    File::DeleteFile(assetPath);
-                    ModelData modelData = AssimpImporter::ImportFbx(fileInfo.path);
-                    File::ExportModel(modelData);
-                }
+    // Runs on a worker. Re-exports the .model if its source changed or the format moved on, then reads it back for FinalizeLoadedModels()
+    void ImportModelFromDisk(int modelIndex, const std::string& rawPath, const std::string& modelPath) {
+        if (rawPath.length()) {
+            bool exportRequired = !Util::FileExists(modelPath);
+            if (!exportRequired) {
+                ModelHeader modelHeader = File::ReadModelHeader(modelPath);
+                exportRequired = modelHeader.timestamp != File::GetLastModifiedTime(rawPath) || modelHeader.version != MODEL_FILE_VERSION;
             }
-            // File doesn't even exist yet, so export it
-            else {
-                ModelData modelData = AssimpImporter::ImportFbx(fileInfo.path);
+            if (exportRequired) {
+                File::DeleteFile(modelPath);
+                ModelData modelData = AssimpImporter::ImportFbx(rawPath);
                 File::ExportModel(modelData);
             }
         }
-        // Find and import all .model files
+        std::unique_ptr<LoadedModel> loadedModel = std::make_unique<LoadedModel>();
+        loadedModel->modelIndex = modelIndex;
+        loadedModel->mapped = File::MapModel(modelPath, loadedModel->mappedModel);
+        if (!loadedModel->mapped) {
+            loadedModel->modelData = File::ImportModel(modelPath);
+        }
+        std::lock_guard<std::mutex> lock(g_loadedModelsMutex);
+        g_loadedModels.push_back(std::move(loadedModel));
+    }
+
+    // Every model gets its slot and name up front so game objects can reference it, and draw a placeholder, while it loads
+    void LoadModelsAsync() {
+        std::vector<std::pair<std::string, std::string>> modelSources;
+        for (FileInfo& fileInfo : Util::IterateDirectory("res/models_raw", { "obj", "fbx" })) {
+            modelSources.emplace_back(fileInfo.name, fileInfo.path);
+        }
         for (FileInfo& fileInfo : Util::IterateDirectory("res/models")) {
+            auto hasSource = [&fileInfo](const std::pair<std::string, std::string>& source) { return source.first == fileInfo.name; };
+            if (std::find_if(modelSources.begin(), modelSources.end(), hasSource) == modelSources.end()) {
+                modelSources.emplace_back(fileInfo.name, "");
+            }
+        }
+        for (auto& [name, rawPath] : modelSources) {
+            std::string modelPath = "res/models/" + name + ".model";
             Model& model = g_models.emplace_back();
-            ModelData modelData = File::ImportModel("res/models/" + fileInfo.GetFileNameWithExtension());
-            LoadModelFromData(model, modelData);
+            model.SetName(name);
+            // Current files already know their bounds, which sizes the placeholder
+            if (Util::FileExists(modelPath)) {
+                ModelHeader modelHeader = File::ReadModelHeader(modelPath);
+                if (modelHeader.version == MODEL_FILE_VERSION) {
+                    model.SetAABB(modelHeader.aabbMin, modelHeader.aabbMax);
+                }
+            }
+            int modelIndex = g_models.size() - 1;
+            g_pendingModelCount++;
+            JobSystem::Submit([modelIndex, rawPath, modelPath]() {
+                ImportModelFromDisk(modelIndex, rawPath, modelPath);
+            }, JobPriority::NORMAL);
         }
 
         // Build index map
@@ -87,6 +159,65 @@ namespace AssetManager {
         }
     }
 
+    // Uploads mesh by mesh until the budget is spent, at least one per call so loading always moves forward.
+    // A model only drops its placeholder once every mesh is in.
+    void FinalizeLoadedModels(double budgetMs) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        int uploadedMeshCount = 0;
+        while (true) {
+            if (!g_finalizingModel) {
+                std::lock_guard<std::mutex> lock(g_loadedModelsMutex);
+                if (g_loadedModels.empty()) {
+                    return;
+                }
+                g_finalizingModel = std::move(g_loadedModels.front());
+                g_loadedModels.pop_front();
+            }
+            LoadedModel& loadedModel = *g_finalizingModel;
+            size_t meshCount = loadedModel.mapped ? loadedModel.mappedModel.meshes.size() : loadedModel.modelData.meshes.size();
+            while (loadedModel.nextMeshIndex < meshCount) {
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+                if (uploadedMeshCount > 0 && elapsed.count() >= budgetMs) {
+                    return;
+                }
+                int meshIndex = loadedModel.mapped
+                    ? CreateMeshFromMapping(loadedModel.mappedModel.meshes[loadedModel.nextMeshIndex])
+                    : CreateMeshFromData(loadedModel.modelData.meshes[loadedModel.nextMeshIndex]);
+                loadedModel.meshIndices.push_back(meshIndex);
+                loadedModel.nextMeshIndex++;
+                uploadedMeshCount++;
+            }
+            Model& model = g_models[loadedModel.modelIndex];
+            for (uint32_t meshIndex : loadedModel.meshIndices) {
+                model.AddMeshIndex(meshIndex);
+            }
+            if (loadedModel.mapped) {
+                model.SetAABB(loadedModel.mappedModel.aabbMin, loadedModel.mappedModel.aabbMax);
+                File::UnmapModel(loadedModel.mappedModel);
+            }
+            else {
+                model.SetAABB(loadedModel.modelData.aabbMin, loadedModel.modelData.aabbMax);
+            }
+            model.m_awaitingLoadingFromDisk = false;
+            model.m_loadedFromDisk = true;
+            g_finalizingModel.reset();
+            g_pendingModelCount--;
+        }
+    }
+
+    void WaitForModels() {
+        while (g_pendingModelCount > 0) {
+            FinalizeLoadedModels(std::numeric_limits<double>::max());
+            if (g_pendingModelCount > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    bool ModelsLoading() {
+        return g_pendingModelCount > 0;
+    }
+
     /*
     █▄ ▄█ █▀▀ █▀▀ █ █
     █ █ █ █▀▀ ▀▀█ █▀█
@@ -95,12 +226,30 @@ namespace AssetManager {
     int CreateMesh(const std::string& name, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, glm::vec3 aabbMin, glm::vec3 aabbMax) {
         OpenGLDetachedMesh& mesh = g_meshes.emplace_back();
         mesh.SetName(name);
-        mesh.UpdateVertexBuffer(vertices, indices);
+        mesh.UploadToArena(vertices, indices, {}, g_keepCPUMeshData);
         mesh.aabbMin = aabbMin;
         mesh.aabbMax = aabbMax;
         return g_meshes.size() - 1;
     }
 
+    // Every level goes into one index allocation back to back, so they all share the mesh's base vertex
+    int CreateMeshWithLods(MeshData& meshData) {
+        std::vector<uint32_t> indices = meshData.indices;
+        std::vector<MeshLod> lods;
+        lods.push_back(MeshLod{ 0, (uint32_t)meshData.indices.size(), 0.0f, 1.0f });
+        for (MeshLodData& lodData : meshData.lods) {
+            lods.push_back(MeshLod{ (uint32_t)indices.size(), (uint32_t)lodData.indices.size(), lodData.error, lodData.alphaScale });
+            indices.insert(indices.end(), lodData.indices.begin(), lodData.indices.end());
+        }
+        OpenGLDetachedMesh& mesh = g_meshes.emplace_back();
+        mesh.SetName(meshData.name);
+        mesh.UploadToArena(meshData.vertices, indices, lods, g_keepCPUMeshData);
+        mesh.SetClusters(meshData.clusters);
+        mesh.aabbMin = meshData.aabbMin;
+        mesh.aabbMax = meshData.aabbMax;
+        return g_meshes.size() - 1;
+    }
+
     int CreateMesh(const std::string& name, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
         glm::vec3 aabbMin = glm::vec3(std::numeric_limits<float>::max());
         glm::vec3 aabbMax = glm::vec3(-std::numeric_limits<float>::max());
@@ -127,12 +276,33 @@ namespace AssetManager {
         }
         OpenGLDetachedMesh& mesh = g_meshes.emplace_back();
         mesh.SetName(name);
-        mesh.UpdateVertexBuffer(vertices, indices);
+        mesh.UploadToArena(vertices, indices, {}, g_keepCPUMeshData);
         mesh.aabbMin = aabbMin;
         mesh.aabbMax = aabbMax;
         return g_meshes.size() - 1;
     }
 
+    // Unit cube drawn in place of a model that is still loading
+    void CreatePlaceholderMesh() {
+        std::vector<Vertex> vertices;
+        std::vector<glm::vec3> positions = Primitves::CreateCubeVertices(0.5f);
+        for (size_t i = 0; i < positions.size(); i += 4) {
+            glm::vec3 normal = glm::normalize(positions[i] + positions[i + 1] + positions[i + 2] + positions[i + 3]);
+            for (size_t j = i; j < i + 4; j++) {
+                Vertex& vertex = vertices.emplace_back();
+                vertex.position = positions[j];
+                vertex.normal = normal;
+                vertex.uv = glm::vec2((j & 2) ? 1.0f : 0.0f, ((j + 1) & 2) ? 1.0f : 0.0f);
+            }
+        }
+        std::vector<uint32_t> indices = Primitves::CreateCubeIndices();
+        g_placeholderMeshIndex = CreateMesh("Placeholder", vertices, indices);
+    }
+
+    int GetPlaceholderMeshIndex() {
+        return g_placeholderMeshIndex;
+    }
+
     int GetMeshIndexByName(const std::string& name) {
         for (int i = 0; i < g_meshes.size(); i++) {
             if (g_meshes[i].GetName() == name)
@@ -161,6 +331,10 @@ namespace AssetManager {
         }
     }
 
+    int GetMeshCount() {
+        return g_meshes.size();
+    }
+
     /*
      ▀█▀ █▀▀ █ █ ▀█▀ █ █ █▀▄ █▀▀
       █  █▀▀ ▄▀▄  █  █ █ █▀▄ █▀▀
@@ -193,8 +367,12 @@ namespace AssetManager {
             texture.SetMinFilter(TextureFilter::NEAREST);
             texture.SetMagFilter(TextureFilter::NEAREST);
         }
-        // Async load them all
-        LoadPendingTexturesAsync();
+        // Async load them all, ahead of anything else in the job queues since the first frame needs them
+        g_minimumTextureCount = g_textures.size();
+        JobCounter counter;
+        LoadPendingTexturesAsync(JobPriority::HIGH, counter);
+        JobSystem::Wait(counter);
+        FinalizeDecodedTextures();
 
         // Immediate bake them
         BakeQueue::ImmediateBakeAllTextures();
@@ -233,8 +411,32 @@ namespace AssetManager {
             texture.SetMinFilter(TextureFilter::NEAREST);
             texture.SetMagFilter(TextureFilter::NEAREST);
         }
-        // Async load them all
-        LoadPendingTexturesAsync();
+        // DDS files that don't exist yet get a texture now, the job that decodes it compresses it first
+        std::vector<std::pair<int, std::string>> compressJobs;
+        for (FileInfo& fileInfo : Util::IterateDirectory("res/textures/compress_me", { "png", "jpg", "tga" })) {
+            FileInfo ddsFileInfo;
+            ddsFileInfo.dir = "res/textures/compressed";
+            ddsFileInfo.name = fileInfo.name;
+            ddsFileInfo.ext = "dds";
+            ddsFileInfo.path = ddsFileInfo.dir + "/" + ddsFileInfo.GetFileNameWithExtension();
+            if (Util::FileExists(ddsFileInfo.path)) {
+                continue;
+            }
+            Texture& texture = g_textures.emplace_back();
+            texture.SetFileInfo(ddsFileInfo);
+            texture.SetImageDataType(ImageDataType::COMPRESSED);
+            texture.SetTextureWrapMode(TextureWrapMode::REPEAT);
+            texture.SetMinFilter(TextureFilter::LINEAR_MIPMAP);
+            texture.SetMagFilter(TextureFilter::LINEAR);
+            texture.RequestMipmaps();
+            texture.SetLoadingState(LoadingState::LOADING_FROM_DISK);
+            compressJobs.emplace_back(g_textures.size() - 1, fileInfo.path);
+        }
+        // Jobs hold texture pointers, so nothing is submitted until g_textures has stopped growing. Init doesn't wait for any of them
+        LoadPendingTexturesAsync(JobPriority::NORMAL, g_textureCounter);
+        for (auto& [textureIndex, inputPath] : compressJobs) {
+            SubmitTextureJob(textureIndex, inputPath, JobPriority::LOW, g_textureCounter);
+        }
 
         // Build index maps
         for (int i = 0; i < g_textures.size(); i++) {
@@ -242,38 +444,62 @@ namespace AssetManager {
         }
     }
 
-    void CompressMissingDDSTexutres() {
-        for (FileInfo& fileInfo : Util::IterateDirectory("res/textures/compress_me", { "png", "jpg", "tga" })) {
-            std::string inputPath = fileInfo.path;
-            std::string outputPath = "res/textures/compressed/" + fileInfo.name + ".dds";
-            if (!Util::FileExists(outputPath)) {
-                ImageTools::CreateAndExportDDS(inputPath, outputPath, true);
-                std::cout << "Exported " << outputPath << "\n";
+    void LoadPendingTexturesAsync(JobPriority priority, JobCounter& counter) {
+        for (int i = 0; i < g_textures.size(); i++) {
+            if (g_textures[i].GetLoadingState() == LoadingState::AWAITING_LOADING_FROM_DISK) {
+                g_textures[i].SetLoadingState(LoadingState::LOADING_FROM_DISK);
+                SubmitTextureJob(i, "", priority, counter);
             }
         }
     }
 
-    void LoadPendingTexturesAsync() {
-        std::vector<std::future<void>> futures;
-        for (Texture& texture : g_textures) {
-            if (texture.GetLoadingState() == LoadingState::AWAITING_LOADING_FROM_DISK) {
-                texture.SetLoadingState(LoadingState::LOADING_FROM_DISK);
-                futures.emplace_back(std::async(std::launch::async, LoadTexture, &texture));
+    // The worker owns the texture until its continuation hands the index back. The compressor runs single threaded so it doesn't fight the pool for cores
+    void SubmitTextureJob(int textureIndex, const std::string& compressFromPath, JobPriority priority, JobCounter& counter) {
+        Texture* texture = &g_textures[textureIndex];
+        std::string outputPath = texture->GetFilePath();
+        JobSystem::Submit([texture, compressFromPath, outputPath]() {
+            if (compressFromPath.length()) {
+                ImageTools::CreateAndExportDDS(compressFromPath, outputPath, true);
+                std::cout << "Exported " << outputPath << "\n";
+            }
+            LoadTexture(texture);
+        }, [textureIndex]() {
+            std::lock_guard<std::mutex> lock(g_decodedTexturesMutex);
+            g_decodedTextureIndices.push_back(textureIndex);
+        }, priority, JobPriority::HIGH, &counter);
+    }
+
+    // GL allocation has to happen on the main thread, and before the bake queue can upload into the texture
+    void FinalizeDecodedTextures() {
+        std::vector<int> textureIndices;
+        {
+            std::lock_guard<std::mutex> lock(g_decodedTexturesMutex);
+            textureIndices.swap(g_decodedTextureIndices);
+        }
+        for (int textureIndex : textureIndices) {
+            Texture& texture = g_textures[textureIndex];
+            if (texture.GetTextureDataCount() == 0) {
+                std::cout << "AssetManager::FinalizeDecodedTextures() failed because '" << texture.GetFilePath() << "' has no image data\n";
+                continue;
             }
-        }
-        for (auto& future : futures) {
-            future.get();
-        }
-        // Allocate gpu memory
-        for (Texture& texture : g_textures) {
             OpenGLBackend::AllocateTextureMemory(texture);
+            BakeQueue::QueueTextureForBaking(&texture, textureIndex < g_minimumTextureCount ? UploadPriority::UI : UploadPriority::BACKGROUND);
         }
     }
 
+    void WaitForTextures() {
+        JobSystem::Wait(g_textureCounter);
+        FinalizeDecodedTextures();
+    }
+
+    bool TexturesLoading() {
+        std::lock_guard<std::mutex> lock(g_decodedTexturesMutex);
+        return g_textureCounter.count > 0 || g_decodedTextureIndices.size();
+    }
+
     void LoadTexture(Texture* texture) {
         if (texture) {
             texture->Load();
-            BakeQueue::QueueTextureForBaking(texture);
         }
     }
 
@@ -363,16 +589,39 @@ namespace AssetManager {
         g_models.emplace_back();
         Model* model = &g_models[g_models.size() - 1];
         model->SetName(name);
+        model->m_awaitingLoadingFromDisk = false;
         return model;
     }
 
-    void LoadModelFromData(Model& model, ModelData& modelData) {
-        model.SetName(modelData.name);
-        model.SetAABB(modelData.aabbMin, modelData.aabbMax);
-        for (MeshData& meshData : modelData.meshes) {
-            int meshIndex = CreateMesh(meshData.name, meshData.vertices, meshData.indices, meshData.aabbMin, meshData.aabbMax);
-            model.AddMeshIndex(meshIndex);
+    int CreateMeshFromMapping(const MappedMeshView& meshView) {
+        OpenGLDetachedMesh& mesh = g_meshes.emplace_back();
+        mesh.SetName(std::string(meshView.name));
+        mesh.UploadToArena(meshView, g_keepCPUMeshData);
+        mesh.aabbMin = meshView.aabbMin;
+        mesh.aabbMax = meshView.aabbMax;
+        return g_meshes.size() - 1;
+    }
+
+    int CreateMeshFromData(MeshData& meshData) {
+        return meshData.lods.empty() && meshData.clusters.empty()
+            ? CreateMesh(meshData.name, meshData.vertices, meshData.indices, meshData.aabbMin, meshData.aabbMax)
+            : CreateMeshWithLods(meshData);
+    }
+
+    void SetKeepCPUMeshData(bool keepCPUMeshData) {
+        g_keepCPUMeshData = keepCPUMeshData;
+    }
+
+    // Returns the model's geometry to the arena. Mesh slots stay put so indices held elsewhere remain valid, they just draw nothing.
+    void UnloadModel(int modelIndex) {
+        Model* model = GetModelByIndex(modelIndex);
+        if (!model) {
+            return;
+        }
+        for (uint32_t meshIndex : model->GetMeshIndices()) {
+            g_meshes[meshIndex].CleanUp();
         }
+        model->m_loadedFromDisk = false;
     }
 
     int GetModelIndexByName(const std::string& name) {
@@ -389,6 +638,18 @@ namespace AssetManager {
         return GetMaterialByIndex(index);
     }
 
+    void MarkMaterialVisible(int index) {
+        if (index < 0 || index >= g_materials.size()) {
+            return;
+        }
+        Material& material = g_materials[index];
+        for (int textureIndex : { material.m_basecolor, material.m_normal, material.m_rma }) {
+            if (textureIndex != -1 && !g_textures[textureIndex].BakeComplete()) {
+                BakeQueue::MarkTextureVisible(&g_textures[textureIndex]);
+            }
+        }
+    }
+
     Material* GetMaterialByIndex(int index) {
         if (index >= 0 && index < g_materials.size()) {
             Material* material = &g_materials[index];
@@ -15,24 +15,35 @@ namespace AssetManager {
     int GetTextureCount();
     Texture* GetTextureByName(const std::string& name);
     Texture* GetTextureByIndex(int index);
+    void WaitForTextures();         // Decodes every texture still loading in the background and queues it for baking
+    bool TexturesLoading();
 
     // Models
-    void LoadModelFromData(Model& model, ModelData& modelData);
+    void WaitForModels();           // Finalizes every model still loading in the background
+    bool ModelsLoading();
     int GetModelIndexByName(const std::string& name);
     Model* CreateModel(const std::string& name);
     Model* GetModelByIndex(int index);
+    void UnloadModel(int modelIndex);
+    void SetKeepCPUMeshData(bool keepCPUMeshData);  // Call before Init(), meshes only keep the GPU copy otherwise
 
     // Mesh
     int CreateMesh(const std::string& name, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, glm::vec3 aabbMin, glm::vec3 aabbMax);
     int CreateMesh(const std::string& name, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    int CreateMeshWithLods(MeshData& meshData);
+    int CreateMeshFromMapping(const MappedMeshView& meshView);
+    int CreateMeshFromData(MeshData& meshData);
+    int GetPlaceholderMeshIndex();
     int GetMeshIndexByName(const std::string& name);
     int GetMeshIndexByName(const std::string& name);
     OpenGLDetachedMesh* GetDetachedMeshByName(const std::string& name);
     OpenGLDetachedMesh* GetMeshByIndex(int index);
+    int GetMeshCount();
 
     // Materials
     Material* GetDefaultMaterial();
     Material* GetMaterialByIndex(int index);
+    void MarkMaterialVisible(int index);    // Its textures jump the upload queue while it still draws with the default material
     int GetMaterialIndex(const std::string& name);
     std::string& GetMaterialNameByIndex(int index);
 }
\ No newline at end of file
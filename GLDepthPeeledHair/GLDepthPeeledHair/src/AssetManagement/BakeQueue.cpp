@@ -1,13 +1,16 @@
 #include "BakeQueue.h"
 #include "AssetManager.h"
 #include "../API/OpenGL/GL_backend.h"
+#include <algorithm>
+#include <unordered_set>
 
 namespace BakeQueue {
 
     std::vector<QueuedTextureBake> g_queuedTextureBakes;
     int g_textureBakeJobID = 0;
+    std::unordered_set<void*> g_visibleTextures;
 
-    void QueueTextureForBaking(Texture* texture) {
+    void QueueTextureForBaking(Texture* texture, UploadPriority priority) {
         static std::mutex mutex;
         std::lock_guard<std::mutex> lock(mutex);
         for (int i = 0; i < texture->GetTextureDataCount(); i++) {
@@ -21,9 +24,32 @@ namespace BakeQueue {
             queuedTextureBake.data = texture->GetData(i);
             queuedTextureBake.dataSize = texture->GetDataSize(i);
             queuedTextureBake.mipmapLevel = i;
+            queuedTextureBake.priority = priority;
         }
     }
 
+    void MarkTextureVisible(Texture* texture) {
+        g_visibleTextures.insert(texture);
+    }
+
+    // Visible marks come from the renderer and last until the next gather, a promoted bake stays promoted
+    void GatherPendingBakes(std::vector<QueuedTextureBake*>& pendingBakes) {
+        pendingBakes.clear();
+        for (QueuedTextureBake& queuedTextureBake : g_queuedTextureBakes) {
+            if (queuedTextureBake.inProgress) {
+                continue;
+            }
+            if (queuedTextureBake.priority == UploadPriority::BACKGROUND && g_visibleTextures.contains(queuedTextureBake.texture)) {
+                queuedTextureBake.priority = UploadPriority::VISIBLE;
+            }
+            pendingBakes.push_back(&queuedTextureBake);
+        }
+        g_visibleTextures.clear();
+        std::stable_sort(pendingBakes.begin(), pendingBakes.end(), [](const QueuedTextureBake* a, const QueuedTextureBake* b) {
+            return a->priority < b->priority;
+        });
+    }
+
     void RemoveQueuedTextureBakeByJobID(int jobID) {
         static std::mutex mutex;
         std::lock_guard<std::mutex> lock(mutex);
@@ -41,16 +67,6 @@ namespace BakeQueue {
         }
     }
 
-    QueuedTextureBake* GetNextQueuedTextureBake() {
-        for (QueuedTextureBake& queuedTextureBake : g_queuedTextureBakes) {
-            if (!queuedTextureBake.inProgress) {
-                //OpenGLBackend::AsyncBakeQueuedTextureBake(queuedTextureBake);
-                return &queuedTextureBake;
-            }
-        }
-        return nullptr;
-    }
-
     const int GetQueuedTextureBakeJobCount() {
         return g_queuedTextureBakes.size();
     }
@@ -62,5 +78,6 @@ namespace BakeQueue {
             }
         }
         std::cout << "BakeQueue::GetQueuedTextureBakeByJobID(int jobID) failed. '" << jobID << "' did not exist\n";
+        return nullptr;
     }
 }
\ No newline at end of file
@@ -4,10 +4,11 @@
 
 namespace BakeQueue {
     // Textures
-    void QueueTextureForBaking(Texture* texture);
+    void QueueTextureForBaking(Texture* texture, UploadPriority priority = UploadPriority::BACKGROUND);
+    void MarkTextureVisible(Texture* texture);     // Promotes the texture's bakes to VISIBLE next time they are gathered
+    void GatherPendingBakes(std::vector<QueuedTextureBake*>& pendingBakes); // Bakes not fully staged yet, highest priority first
     void RemoveQueuedTextureBakeByJobID(int jobID);
     void ImmediateBakeAllTextures();
     const int GetQueuedTextureBakeJobCount();
-    QueuedTextureBake* GetNextQueuedTextureBake();
     QueuedTextureBake* GetQueuedTextureBakeByJobID(int jobID);
 }
\ No newline at end of file
@@ -42,4 +42,18 @@ enum class TextureFilter {
     LINEAR,
     LINEAR_MIPMAP,
     UNDEFINED
+};
+
+// Higher runs first, every worker drains all HIGH jobs it can find before it looks at NORMAL ones
+enum class JobPriority {
+    HIGH,
+    NORMAL,
+    LOW
+};
+
+// Texture bakes are staged in this order, within a class they keep queue order so mips of a texture stay together
+enum class UploadPriority {
+    UI,
+    VISIBLE,
+    BACKGROUND
 };
\ No newline at end of file
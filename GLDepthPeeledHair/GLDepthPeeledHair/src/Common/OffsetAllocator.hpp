@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <map>
+
+// First fit allocator over the abstract range [0, capacity). Hands out offsets only, the caller owns the memory.
+// Freed ranges are merged with their neighbours so unloading and reloading doesn't fragment the range over time.
+struct OffsetAllocator {
+public:
+    static constexpr uint32_t INVALID_OFFSET = 0xFFFFFFFF;
+
+    void Init(uint32_t capacity) {
+        m_freeRanges.clear();
+        m_capacity = 0;
+        m_usedSize = 0;
+        Grow(capacity);
+    }
+
+    uint32_t Allocate(uint32_t size) {
+        if (size == 0) {
+            return INVALID_OFFSET;
+        }
+        for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); it++) {
+            if (it->second >= size) {
+                uint32_t offset = it->first;
+                uint32_t remainingSize = it->second - size;
+                m_freeRanges.erase(it);
+                if (remainingSize > 0) {
+                    m_freeRanges[offset + size] = remainingSize;
+                }
+                m_usedSize += size;
+                return offset;
+            }
+        }
+        return INVALID_OFFSET;
+    }
+
+    void Free(uint32_t offset, uint32_t size) {
+        if (offset == INVALID_OFFSET || size == 0) {
+            return;
+        }
+        m_usedSize -= size;
+        auto next = m_freeRanges.lower_bound(offset);
+        if (next != m_freeRanges.end() && offset + size == next->first) {
+            size += next->second;
+            next = m_freeRanges.erase(next);
+        }
+        if (next != m_freeRanges.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                previous->second += size;
+                return;
+            }
+        }
+        m_freeRanges[offset] = size;
+    }
+
+    // New space is appended to the end of the range, existing offsets stay valid
+    void Grow(uint32_t newCapacity) {
+        if (newCapacity <= m_capacity) {
+            return;
+        }
+        uint32_t oldCapacity = m_capacity;
+        m_capacity = newCapacity;
+        m_usedSize += newCapacity - oldCapacity;
+        Free(oldCapacity, newCapacity - oldCapacity);
+    }
+
+    uint32_t GetCapacity() const {
+        return m_capacity;
+    }
+
+    uint32_t GetUsedSize() const {
+        return m_usedSize;
+    }
+
+    uint32_t GetFreeRangeCount() const {
+        return (uint32_t)m_freeRanges.size();
+    }
+
+private:
+    std::map<uint32_t, uint32_t> m_freeRanges; // offset -> size
+    uint32_t m_capacity = 0;
+    uint32_t m_usedSize = 0;
+};
@@ -12,8 +12,89 @@ struct RenderItem {
     int baseColorTextureIndex;
     int normalTextureIndex;
     int rmaTextureIndex;
+    int materialIndex = -1;
+    int lodIndex = 0;       // Picked from projected screen size in GameObject::UpdateRenderItems()
+    uint64_t sortKey = 0;   // Written by RenderQueue::Sort()
 };
 
+// Index range of one level of detail inside a mesh's index allocation, LOD 0 is the full mesh
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;
+    float alphaScale = 1.0f;
+};
+
+// Mirrors CameraData in res/shaders/common/camera_data.glsl, std140
+struct CameraData {
+    glm::mat4 projection;
+    glm::mat4 projectionInverse;
+    glm::mat4 view;
+    glm::mat4 viewInverse;
+    glm::vec4 viewPos;
+    float viewportWidth = 0;
+    float viewportHeight = 0;
+    float hairViewportWidth = 0;
+    float hairViewportHeight = 0;
+    float nearPlane = 0;
+    float farPlane = 0;
+    float time = 0;
+    float padding = 0;
+};
+
+// Contiguous run of a hair mesh's full detail indices with the bounds the GPU cull pass tests it by
+struct MeshCluster {
+    uint32_t firstIndex = 0;    // Relative to the mesh's first index
+    uint32_t indexCount = 0;
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.0f;
+    glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    float coneCutoff = 1.0f;    // Sine of the widened cone angle, 1 means the normals spread too far to ever cull
+};
+
+// Mirrors InstanceData in res/shaders/common/instance_data.glsl, std430, indexed by gl_BaseInstance
+struct InstanceData {
+    glm::mat4 modelMatrix;
+    glm::mat4 normalMatrix;
+    float alphaScale = 1.0f;
+    float padding0 = 0.0f;
+    float padding1 = 0.0f;
+    float padding2 = 0.0f;
+};
+
+// Mirrors RenderItem in res/shaders/common/render_items.glsl, std430, parallel to InstanceData
+struct GPURenderItem {
+    uint64_t baseColorHandle = 0;
+    uint64_t normalHandle = 0;
+    uint64_t rmaHandle = 0;
+    uint64_t padding = 0;
+};
+
+struct DrawElementsIndirectCommand {
+    uint32_t count = 0;
+    uint32_t instanceCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t baseInstance = 0;
+};
+
+// Mirrors CullItem in res/shaders/OpenGL/gl_gpu_cull.comp, std430. One per indirect draw candidate, hair meshes get one per cluster.
+struct GPUCullItem {
+    glm::vec4 aabbMin;              // Mesh space, w unused
+    glm::vec4 aabbMax;
+    glm::vec4 cone = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);  // Mesh space backface cone of a hair cluster, w is MeshCluster::coneCutoff
+    uint32_t instanceIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t commandSlot = 0;       // First command of the list, or the item's own command when the list keeps its order
+    uint32_t drawCountIndex = 0;    // Counter the item is compacted through, GPU_CULL_KEEP_ORDER writes in place instead
+    uint32_t padding0 = 0;
+    uint32_t padding1 = 0;
+};
+
+constexpr uint32_t GPU_CULL_KEEP_ORDER = 0xFFFFFFFF;
+
 struct FontVertex {
     glm::vec2 position;
     glm::vec2 uv;
@@ -46,6 +127,14 @@ struct Vertex {
     glm::vec3 tangent = glm::vec3(0);
 };
 
+// 24 byte GPU and .model layout, see VertexCompression.hpp. Normal and tangent are octahedral snorm16x2, uv is half2
+struct CompactVertex {
+    glm::vec3 position = glm::vec3(0);
+    uint32_t normal = 0;
+    uint32_t tangent = 0;
+    uint32_t uv = 0;
+};
+
 struct TextureData {
     int m_width = 0;
     int m_height = 0;
@@ -110,5 +199,7 @@ struct QueuedTextureBake {
     int mipmapLevel = 0;
     int dataSize = 0;
     const void* data = nullptr;
+    int uploadedRowCount = 0;   // Rows (block rows when compressed) already copied to staging, big levels go up over several calls
+    UploadPriority priority = UploadPriority::BACKGROUND;
     bool inProgress = false;
 };
\ No newline at end of file
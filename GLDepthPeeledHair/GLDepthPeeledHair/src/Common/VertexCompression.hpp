@@ -0,0 +1,57 @@
+#pragma once
+#include "Common.h"
+#include "Types.h"
+#include <glm/gtc/packing.hpp>
+
+namespace VertexCompression {
+
+    // Projects the unit sphere onto an octahedron and unfolds it into [-1, 1]^2, the lower hemisphere folds over the diagonals
+    inline glm::vec2 OctahedralEncode(glm::vec3 n) {
+        float sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (sum == 0.0f) {
+            return glm::vec2(0.0f);
+        }
+        n /= sum;
+        glm::vec2 e(n.x, n.y);
+        if (n.z < 0.0f) {
+            glm::vec2 signs(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+            e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * signs;
+        }
+        return e;
+    }
+
+    // Mirrors OctahedralDecode() in octahedral.glsl
+    inline glm::vec3 OctahedralDecode(glm::vec2 e) {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    inline CompactVertex Pack(const Vertex& vertex) {
+        CompactVertex compactVertex;
+        compactVertex.position = vertex.position;
+        compactVertex.normal = glm::packSnorm2x16(OctahedralEncode(vertex.normal));
+        compactVertex.tangent = glm::packSnorm2x16(OctahedralEncode(vertex.tangent));
+        compactVertex.uv = glm::packHalf2x16(vertex.uv);
+        return compactVertex;
+    }
+
+    inline Vertex Unpack(const CompactVertex& compactVertex) {
+        Vertex vertex;
+        vertex.position = compactVertex.position;
+        vertex.normal = OctahedralDecode(glm::unpackSnorm2x16(compactVertex.normal));
+        vertex.tangent = OctahedralDecode(glm::unpackSnorm2x16(compactVertex.tangent));
+        vertex.uv = glm::unpackHalf2x16(compactVertex.uv);
+        return vertex;
+    }
+
+    inline std::vector<CompactVertex> Pack(const std::vector<Vertex>& vertices) {
+        std::vector<CompactVertex> compactVertices(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            compactVertices[i] = Pack(vertices[i]);
+        }
+        return compactVertices;
+    }
+}
@@ -1,5 +1,6 @@
 #include "Camera.h"
 #include "../Input/Input.h"
+#include "../API/OpenGL/GL_backend.h"
 
 #define NEAR_PLANE 0.01f
 #define FAR_PLANE 5000.0f
@@ -23,6 +24,10 @@ namespace Camera {
         g_transform.position = glm::vec3(3.18, 0.55, 6.06);
         g_transform.rotation = glm::vec3(-0.40, 3.34, 0.00);
 
+        // Headless contexts have no window to read the cursor from
+        if (!g_window) {
+            return;
+        }
         double x, y;
         glfwGetCursorPos(g_window, &x, &y);
         g_mouseOffsetX = x;
@@ -32,6 +37,9 @@ namespace Camera {
     }
 
     void Update(float deltaTime) {
+        if (!g_window) {
+            return;
+        }
         // Mouselook
         double x, y;
         glfwGetCursorPos(g_window, &x, &y);
@@ -80,8 +88,8 @@ namespace Camera {
     }
 
     glm::mat4 GetProjectionMatrix() {
-        int width, height;
-        glfwGetWindowSize(g_window, &width, &height);
+        int width = OpenGLBackend::GetWindowWidth();
+        int height = OpenGLBackend::GetWindowHeight();
         return glm::perspective(1.0f, float(width) / float(height), NEAR_PLANE, FAR_PLANE);
     }
 
@@ -105,6 +113,10 @@ namespace Camera {
         return g_transform;
     }
 
+    void SetTransform(const Transform& transform) {
+        g_transform = transform;
+    }
+
     glm::vec3 GetForward() {
        return -glm::vec3(GetViewMatrix()[0][2], GetViewMatrix()[1][2], GetViewMatrix()[2][2]);
     }
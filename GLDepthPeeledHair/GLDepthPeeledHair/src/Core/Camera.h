@@ -14,6 +14,7 @@ namespace Camera {
     glm::mat4 GetInverseViewMatrix();
     glm::vec3 GetViewPos();
     Transform GetTransform(); 
+    void SetTransform(const Transform& transform);
     glm::vec3 GetViewRotation();
     glm::vec3 GetForward();
     glm::vec3 GetRight();
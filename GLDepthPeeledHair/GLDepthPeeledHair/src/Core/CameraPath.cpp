@@ -0,0 +1,222 @@
+#include "CameraPath.h"
+#include "Camera.h"
+#include "../File/File.h"
+#include "../Util.hpp"
+
+namespace CameraPath {
+
+    struct RecordedSample {
+        double time;
+        CameraPathFrame frame;
+    };
+
+    const std::string g_cameraPathDirectory = "res/camera_paths/";
+    const float g_fixedDeltaTime = 1.0f / 60.0f;
+
+    bool g_recording = false;
+    double g_recordingTime = 0;
+    std::vector<RecordedSample> g_recordedSamples;
+
+    bool g_replaying = false;
+    int g_replayFrameIndex = 0;
+    CameraPathData g_replay;
+
+    void CreateStockPaths();
+    CameraPathFrame CreateLookAtFrame(glm::vec3 position, glm::vec3 target);
+
+    void Init() {
+        CreateStockPaths();
+    }
+
+    void Update(float deltaTime) {
+        if (g_replaying) {
+            if (g_replayFrameIndex < g_replay.frames.size()) {
+                CameraPathFrame& frame = g_replay.frames[g_replayFrameIndex];
+                Transform transform;
+                transform.position = frame.position;
+                transform.rotation = frame.rotation;
+                Camera::SetTransform(transform);
+                g_replayFrameIndex++;
+            }
+            return;
+        }
+        if (g_recording) {
+            Transform transform = Camera::GetTransform();
+            RecordedSample& sample = g_recordedSamples.emplace_back();
+            sample.time = g_recordingTime;
+            sample.frame.position = transform.position;
+            sample.frame.rotation = transform.rotation;
+            g_recordingTime += deltaTime;
+        }
+    }
+
+    /*
+    █▀▄ █▀▀ █▀▀ █▀█ █▀▄ █▀▄ ▀█▀ █▀█ █▀▀
+    █▀▄ █▀▀ █   █ █ █▀▄ █ █  █  █ █ █ █
+    ▀ ▀ ▀▀▀ ▀▀▀ ▀▀▀ ▀ ▀ ▀▀  ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    void StartRecording() {
+        g_recordedSamples.clear();
+        g_recordingTime = 0;
+        g_recording = true;
+        std::cout << "Camera path recording started\n";
+    }
+
+    void StopRecording() {
+        if (!g_recording) {
+            return;
+        }
+        g_recording = false;
+        if (g_recordedSamples.size() < 2) {
+            std::cout << "Camera path recording discarded, too short\n";
+            return;
+        }
+        // Live frames arrive at whatever rate the machine manages, so resample onto the fixed replay timestep
+        CameraPathData cameraPathData;
+        cameraPathData.deltaTime = g_fixedDeltaTime;
+        double duration = g_recordedSamples.back().time;
+        int frameCount = std::max(1, (int)(duration / g_fixedDeltaTime) + 1);
+        int sampleIndex = 0;
+        for (int i = 0; i < frameCount; i++) {
+            double time = i * g_fixedDeltaTime;
+            while (sampleIndex + 2 < g_recordedSamples.size() && g_recordedSamples[sampleIndex + 1].time < time) {
+                sampleIndex++;
+            }
+            RecordedSample& a = g_recordedSamples[sampleIndex];
+            RecordedSample& b = g_recordedSamples[sampleIndex + 1];
+            float t = (b.time > a.time) ? (float)glm::clamp((time - a.time) / (b.time - a.time), 0.0, 1.0) : 0.0f;
+            CameraPathFrame& frame = cameraPathData.frames.emplace_back();
+            frame.position = glm::mix(a.frame.position, b.frame.position, t);
+            frame.rotation = glm::mix(a.frame.rotation, b.frame.rotation, t);
+        }
+        std::filesystem::create_directories(g_cameraPathDirectory);
+        std::string filepath = g_cameraPathDirectory + "recording_" + std::to_string(File::GetCurrentTimestamp()) + ".campath";
+        File::ExportCameraPath(filepath, cameraPathData);
+        std::cout << "Camera path recording saved (" << frameCount << " frames)\n";
+    }
+
+    void ToggleRecording() {
+        if (g_recording) {
+            StopRecording();
+        }
+        else {
+            StartRecording();
+        }
+    }
+
+    bool IsRecording() {
+        return g_recording;
+    }
+
+    /*
+    █▀▄ █▀▀ █▀█ █   █▀█ █ █
+    █▀▄ █▀▀ █▀▀ █   █▀█  █
+    ▀ ▀ ▀▀▀ ▀   ▀▀▀ ▀ ▀  ▀  */
+
+    bool LoadReplay(const std::string& nameOrPath) {
+        // Accept either a path on disk or the name of a path in res/camera_paths
+        std::string filepath = nameOrPath;
+        if (!Util::FileExists(filepath)) {
+            filepath = g_cameraPathDirectory + nameOrPath + ".campath";
+        }
+        if (!Util::FileExists(filepath)) {
+            std::cout << "CameraPath::LoadReplay() failed because '" << nameOrPath << "' does not exist\n";
+            return false;
+        }
+        CameraPathData cameraPathData;
+        if (!File::ImportCameraPath(filepath, cameraPathData) || cameraPathData.frames.empty()) {
+            return false;
+        }
+        g_replay = cameraPathData;
+        g_replayFrameIndex = 0;
+        return true;
+    }
+
+    void BeginReplay() {
+        g_recording = false;
+        g_replaying = true;
+        g_replayFrameIndex = 0;
+    }
+
+    void EndReplay() {
+        g_replaying = false;
+    }
+
+    void SeekReplay(int frameIndex) {
+        g_replayFrameIndex = glm::clamp(frameIndex, 0, std::max(0, (int)g_replay.frames.size() - 1));
+    }
+
+    bool IsReplaying() {
+        return g_replaying;
+    }
+
+    bool ReplayFinished() {
+        return g_replayFrameIndex >= g_replay.frames.size();
+    }
+
+    int GetReplayFrameCount() {
+        return g_replay.frames.size();
+    }
+
+    float GetReplayDeltaTime() {
+        return g_replay.deltaTime;
+    }
+
+    const std::string& GetReplayName() {
+        return g_replay.name;
+    }
+
+    /*
+    █▀▀ ▀█▀ █▀█ █▀▀ █ █   █▀█ █▀█ ▀█▀ █ █ █▀▀
+    ▀▀█  █  █ █ █   █▀▄   █▀▀ █▀█  █  █▀█ ▀▀█
+    ▀▀▀  ▀  ▀▀▀ ▀▀▀ ▀ ▀   ▀   ▀ ▀  ▀  ▀ ▀ ▀▀▀ */
+
+    CameraPathFrame CreateLookAtFrame(glm::vec3 position, glm::vec3 target) {
+        // Inverse of the camera's yaw/pitch convention: forward = (-cos(p)sin(y), sin(p), -cos(p)cos(y))
+        glm::vec3 direction = glm::normalize(target - position);
+        CameraPathFrame frame;
+        frame.position = position;
+        frame.rotation.x = std::asin(glm::clamp(direction.y, -1.0f, 1.0f));
+        frame.rotation.y = std::atan2(-direction.x, -direction.z);
+        frame.rotation.z = 0.0f;
+        return frame;
+    }
+
+    void CreateStockPaths() {
+        std::filesystem::create_directories(g_cameraPathDirectory);
+        const glm::vec3 hairCenter = glm::vec3(3.5f, 0.0f, 7.5f);
+
+        // Close-up orbit around the mermaid's head, this is where the peel passes are most expensive
+        std::string hairOrbitPath = g_cameraPathDirectory + "hair_orbit.campath";
+        if (!Util::FileExists(hairOrbitPath)) {
+            CameraPathData cameraPathData;
+            cameraPathData.deltaTime = g_fixedDeltaTime;
+            const int frameCount = 600;
+            const float radius = 1.1f;
+            for (int i = 0; i < frameCount; i++) {
+                float angle = (float)i / frameCount * 6.2831853f;
+                float height = 0.35f + 0.15f * std::sin(angle * 2.0f);
+                glm::vec3 position = hairCenter + glm::vec3(std::sin(angle) * radius, height, -std::cos(angle) * radius);
+                cameraPathData.frames.push_back(CreateLookAtFrame(position, hairCenter));
+            }
+            File::ExportCameraPath(hairOrbitPath, cameraPathData);
+        }
+        // Slow dolly across the room with the whole mermaid in frame
+        std::string roomWidePath = g_cameraPathDirectory + "room_wide.campath";
+        if (!Util::FileExists(roomWidePath)) {
+            CameraPathData cameraPathData;
+            cameraPathData.deltaTime = g_fixedDeltaTime;
+            const int frameCount = 600;
+            const glm::vec3 dollyStart = glm::vec3(0.75f, 0.6f, 1.0f);
+            const glm::vec3 dollyEnd = glm::vec3(6.25f, 0.6f, 1.0f);
+            const glm::vec3 target = hairCenter + glm::vec3(0.0f, -0.5f, 0.0f);
+            for (int i = 0; i < frameCount; i++) {
+                float t = (float)i / (frameCount - 1);
+                t = t * t * (3.0f - 2.0f * t);
+                glm::vec3 position = glm::mix(dollyStart, dollyEnd, t);
+                cameraPathData.frames.push_back(CreateLookAtFrame(position, target));
+            }
+            File::ExportCameraPath(roomWidePath, cameraPathData);
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+
+namespace CameraPath {
+    void Init();
+    void Update(float deltaTime);
+
+    // Recording
+    void StartRecording();
+    void StopRecording();
+    void ToggleRecording();
+    bool IsRecording();
+
+    // Replay
+    bool LoadReplay(const std::string& nameOrPath);
+    void BeginReplay();
+    void EndReplay();
+    void SeekReplay(int frameIndex);
+    bool IsReplaying();
+    bool ReplayFinished();
+    int GetReplayFrameCount();
+    float GetReplayDeltaTime();
+    const std::string& GetReplayName();
+}
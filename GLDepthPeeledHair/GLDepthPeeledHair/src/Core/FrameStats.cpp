@@ -0,0 +1,242 @@
+#include "FrameStats.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <format>
+
+namespace FrameStats {
+
+    struct PendingQuery {
+        GLuint handle = 0;
+        int recordIndex = -1;
+    };
+
+    // GPU timer results lag a few frames behind, so queries live in a ring and are only read back once the slot comes around again
+    constexpr int QUERY_RING_SIZE = 8;
+    PendingQuery g_queries[QUERY_RING_SIZE];
+    int g_queryRingIndex = 0;
+    bool g_initialized = false;
+    bool g_frameInProgress = false;
+    std::chrono::high_resolution_clock::time_point g_frameStartTime;
+    std::vector<FrameRecord> g_frameRecords;
+
+    void ResolveQuery(PendingQuery& query, bool wait);
+
+    void Init() {
+        if (g_initialized) {
+            return;
+        }
+        for (PendingQuery& query : g_queries) {
+            glGenQueries(1, &query.handle);
+            query.recordIndex = -1;
+        }
+        g_initialized = true;
+    }
+
+    void CleanUp() {
+        if (!g_initialized) {
+            return;
+        }
+        for (PendingQuery& query : g_queries) {
+            glDeleteQueries(1, &query.handle);
+            query.handle = 0;
+            query.recordIndex = -1;
+        }
+        g_initialized = false;
+    }
+
+    void Reset() {
+        ResolveOutstandingQueries();
+        g_frameRecords.clear();
+    }
+
+    void BeginFrame() {
+        Init();
+        PendingQuery& query = g_queries[g_queryRingIndex];
+        ResolveQuery(query, true);
+        query.recordIndex = (int)g_frameRecords.size();
+        FrameRecord& record = g_frameRecords.emplace_back();
+        record.frameIndex = (uint32_t)query.recordIndex;
+        glBeginQuery(GL_TIME_ELAPSED, query.handle);
+        g_frameStartTime = std::chrono::high_resolution_clock::now();
+        g_frameInProgress = true;
+    }
+
+    void EndFrame() {
+        if (!g_frameInProgress) {
+            return;
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        auto frameEndTime = std::chrono::high_resolution_clock::now();
+        FrameRecord& record = g_frameRecords.back();
+        record.cpuTimeMs = std::chrono::duration<double, std::milli>(frameEndTime - g_frameStartTime).count();
+        if (OpenGLStats::IsInstalled()) {
+            record.glCounters = OpenGLStats::GetLastFrameCounters();
+        }
+        g_queryRingIndex = (g_queryRingIndex + 1) % QUERY_RING_SIZE;
+        g_frameInProgress = false;
+
+        // Opportunistically pick up any results that are already available
+        for (PendingQuery& query : g_queries) {
+            ResolveQuery(query, false);
+        }
+    }
+
+    void ResolveQuery(PendingQuery& query, bool wait) {
+        if (query.recordIndex == -1 || query.recordIndex >= (int)g_frameRecords.size()) {
+            query.recordIndex = -1;
+            return;
+        }
+        if (!wait) {
+            GLint available = 0;
+            glGetQueryObjectiv(query.handle, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                return;
+            }
+        }
+        GLuint64 elapsedNanoseconds = 0;
+        glGetQueryObjectui64v(query.handle, GL_QUERY_RESULT, &elapsedNanoseconds);
+        g_frameRecords[query.recordIndex].gpuTimeMs = elapsedNanoseconds / 1000000.0;
+        query.recordIndex = -1;
+    }
+
+    void ResolveOutstandingQueries() {
+        if (!g_initialized) {
+            return;
+        }
+        for (PendingQuery& query : g_queries) {
+            ResolveQuery(query, true);
+        }
+    }
+
+    int GetRecordedFrameCount() {
+        return (int)g_frameRecords.size();
+    }
+
+    double GetLastCpuTimeMs() {
+        return g_frameRecords.empty() ? 0.0 : g_frameRecords.back().cpuTimeMs;
+    }
+
+    double GetLastGpuTimeMs() {
+        // Walk back to the most recent frame whose query has landed
+        for (int i = (int)g_frameRecords.size() - 1; i >= 0; i--) {
+            if (g_frameRecords[i].gpuTimeMs >= 0) {
+                return g_frameRecords[i].gpuTimeMs;
+            }
+        }
+        return 0.0;
+    }
+
+    std::vector<FrameRecord>& GetFrameRecords() {
+        return g_frameRecords;
+    }
+
+    double Percentile(std::vector<double>& sortedValues, double percentile) {
+        if (sortedValues.empty()) {
+            return 0.0;
+        }
+        size_t index = std::min(sortedValues.size() - 1, (size_t)(percentile * (sortedValues.size() - 1) + 0.5));
+        return sortedValues[index];
+    }
+
+    void PrintTimingRow(const char* name, std::vector<double>& values) {
+        if (values.empty()) {
+            std::cout << " " << name << ": no samples\n";
+            return;
+        }
+        std::sort(values.begin(), values.end());
+        double total = 0;
+        for (double value : values) {
+            total += value;
+        }
+        double average = total / values.size();
+        std::cout << " " << name << ": "
+            << "avg " << std::format("{:.3f}", average) << "ms  "
+            << "min " << std::format("{:.3f}", values.front()) << "ms  "
+            << "p50 " << std::format("{:.3f}", Percentile(values, 0.50)) << "ms  "
+            << "p95 " << std::format("{:.3f}", Percentile(values, 0.95)) << "ms  "
+            << "p99 " << std::format("{:.3f}", Percentile(values, 0.99)) << "ms  "
+            << "max " << std::format("{:.3f}", values.back()) << "ms\n";
+    }
+
+    void PrintSummary(const std::string& label) {
+        ResolveOutstandingQueries();
+        std::vector<double> cpuTimes;
+        std::vector<double> gpuTimes;
+        for (FrameRecord& record : g_frameRecords) {
+            cpuTimes.push_back(record.cpuTimeMs);
+            if (record.gpuTimeMs >= 0) {
+                gpuTimes.push_back(record.gpuTimeMs);
+            }
+        }
+        double totalCpuTime = 0;
+        for (double cpuTime : cpuTimes) {
+            totalCpuTime += cpuTime;
+        }
+        std::cout << "\n" << label << " (" << g_frameRecords.size() << " frames";
+        if (totalCpuTime > 0) {
+            std::cout << ", " << std::format("{:.1f}", g_frameRecords.size() * 1000.0 / totalCpuTime) << " fps";
+        }
+        std::cout << ")\n";
+        PrintTimingRow("Frame", cpuTimes);
+        PrintTimingRow("GPU  ", gpuTimes);
+        if (OpenGLStats::IsInstalled() && g_frameRecords.size()) {
+            double frameCount = (double)g_frameRecords.size();
+            GLCommandCounters totals;
+            for (FrameRecord& record : g_frameRecords) {
+                const GLCommandCounters& counters = record.glCounters;
+                totals.drawCalls += counters.drawCalls;
+                totals.dispatches += counters.dispatches;
+                totals.programBinds += counters.programBinds;
+                totals.redundantProgramBinds += counters.redundantProgramBinds;
+                totals.textureBinds += counters.textureBinds;
+                totals.redundantTextureBinds += counters.redundantTextureBinds;
+                totals.vertexArrayBinds += counters.vertexArrayBinds;
+                totals.redundantVertexArrayBinds += counters.redundantVertexArrayBinds;
+                totals.frameBufferBinds += counters.frameBufferBinds;
+                totals.redundantFrameBufferBinds += counters.redundantFrameBufferBinds;
+                totals.bufferUploadBytes += counters.bufferUploadBytes;
+                totals.textureUploadBytes += counters.textureUploadBytes;
+                totals.blitBytes += counters.blitBytes;
+            }
+            std::cout << " GL per frame: "
+                << std::format("{:.1f}", totals.drawCalls / frameCount) << " draws  "
+                << std::format("{:.1f}", totals.dispatches / frameCount) << " dispatches\n"
+                << " Binds per frame (redundant): "
+                << "program " << std::format("{:.1f} ({:.1f})", totals.programBinds / frameCount, totals.redundantProgramBinds / frameCount) << "  "
+                << "texture " << std::format("{:.1f} ({:.1f})", totals.textureBinds / frameCount, totals.redundantTextureBinds / frameCount) << "  "
+                << "vao " << std::format("{:.1f} ({:.1f})", totals.vertexArrayBinds / frameCount, totals.redundantVertexArrayBinds / frameCount) << "  "
+                << "fbo " << std::format("{:.1f} ({:.1f})", totals.frameBufferBinds / frameCount, totals.redundantFrameBufferBinds / frameCount) << "\n"
+                << " Bytes per frame: "
+                << "buffer upload " << std::format("{:.1f}", totals.bufferUploadBytes / frameCount / 1024.0) << "KB  "
+                << "texture upload " << std::format("{:.1f}", totals.textureUploadBytes / frameCount / 1024.0) << "KB  "
+                << "blit " << std::format("{:.1f}", totals.blitBytes / frameCount / 1024.0) << "KB\n";
+        }
+        std::cout << "\n";
+    }
+
+    void ExportCSV(const std::string& filepath) {
+        ResolveOutstandingQueries();
+        std::ofstream file(filepath);
+        if (!file.is_open()) {
+            std::cout << "FrameStats::ExportCSV() failed to open '" << filepath << "' for writing\n";
+            return;
+        }
+        file << "frame,cpu_ms,gpu_ms,draws,dispatches,program_binds,redundant_program_binds,texture_binds,redundant_texture_binds,"
+            << "vao_binds,redundant_vao_binds,fbo_binds,redundant_fbo_binds,buffer_upload_bytes,texture_upload_bytes,blit_bytes\n";
+        for (FrameRecord& record : g_frameRecords) {
+            const GLCommandCounters& counters = record.glCounters;
+            file << record.frameIndex << "," << record.cpuTimeMs << "," << record.gpuTimeMs << ","
+                << counters.drawCalls << "," << counters.dispatches << ","
+                << counters.programBinds << "," << counters.redundantProgramBinds << ","
+                << counters.textureBinds << "," << counters.redundantTextureBinds << ","
+                << counters.vertexArrayBinds << "," << counters.redundantVertexArrayBinds << ","
+                << counters.frameBufferBinds << "," << counters.redundantFrameBufferBinds << ","
+                << counters.bufferUploadBytes << "," << counters.textureUploadBytes << "," << counters.blitBytes << "\n";
+        }
+        file.close();
+        std::cout << "Exported frame stats: " << filepath << "\n";
+    }
+}
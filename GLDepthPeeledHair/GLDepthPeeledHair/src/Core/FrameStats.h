@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "../API/OpenGL/GL_stats.h"
+
+struct FrameRecord {
+    uint32_t frameIndex = 0;
+    double cpuTimeMs = 0;
+    double gpuTimeMs = -1;  // -1 until the timer query result has been read back
+    GLCommandCounters glCounters;
+};
+
+namespace FrameStats {
+    void Init();
+    void CleanUp();
+    void Reset();
+    void BeginFrame();
+    void EndFrame();
+    void ResolveOutstandingQueries();
+    int GetRecordedFrameCount();
+    double GetLastCpuTimeMs();
+    double GetLastGpuTimeMs();
+    std::vector<FrameRecord>& GetFrameRecords();
+    void PrintSummary(const std::string& label);
+    void ExportCSV(const std::string& filepath);
+}
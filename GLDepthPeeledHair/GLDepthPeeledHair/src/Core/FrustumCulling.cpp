@@ -0,0 +1,179 @@
+#include "FrustumCulling.h"
+#include "../AssetManagement/AssetManager.h"
+#include <cmath>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLING_SSE
+#endif
+
+namespace FrustumCulling {
+
+    constexpr int PLANE_COUNT = 6;
+    constexpr int BATCH_SIZE = 4;
+
+    struct FrustumPlanes {
+        float normalX[PLANE_COUNT];
+        float normalY[PLANE_COUNT];
+        float normalZ[PLANE_COUNT];
+        float absNormalX[PLANE_COUNT];
+        float absNormalY[PLANE_COUNT];
+        float absNormalZ[PLANE_COUNT];
+        float distance[PLANE_COUNT];
+    };
+
+    // World space boxes as center and half extent, one array per component so a batch is a single load each
+    struct BoundsSoA {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+
+        void Resize(size_t size) {
+            centerX.assign(size, 0.0f);
+            centerY.assign(size, 0.0f);
+            centerZ.assign(size, 0.0f);
+            extentX.assign(size, 0.0f);
+            extentY.assign(size, 0.0f);
+            extentZ.assign(size, 0.0f);
+        }
+    };
+
+    struct ListStats {
+        const char* name;
+        uint32_t visibleCount;
+        uint32_t culledCount;
+    };
+
+    FrustumPlanes g_planes;
+    BoundsSoA g_bounds;
+    std::vector<uint8_t> g_visible;
+    std::vector<uint8_t> g_alwaysVisible;
+    std::vector<ListStats> g_listStats;
+
+    // Gribb/Hartmann, the planes are left unnormalized since the box test only looks at the sign
+    void BeginFrame(const glm::mat4& projectionView) {
+        glm::vec4 row0(projectionView[0][0], projectionView[1][0], projectionView[2][0], projectionView[3][0]);
+        glm::vec4 row1(projectionView[0][1], projectionView[1][1], projectionView[2][1], projectionView[3][1]);
+        glm::vec4 row2(projectionView[0][2], projectionView[1][2], projectionView[2][2], projectionView[3][2]);
+        glm::vec4 row3(projectionView[0][3], projectionView[1][3], projectionView[2][3], projectionView[3][3]);
+        glm::vec4 planes[PLANE_COUNT] = {
+            row3 + row0,
+            row3 - row0,
+            row3 + row1,
+            row3 - row1,
+            row3 + row2,
+            row3 - row2
+        };
+        for (int i = 0; i < PLANE_COUNT; i++) {
+            g_planes.normalX[i] = planes[i].x;
+            g_planes.normalY[i] = planes[i].y;
+            g_planes.normalZ[i] = planes[i].z;
+            g_planes.absNormalX[i] = std::abs(planes[i].x);
+            g_planes.absNormalY[i] = std::abs(planes[i].y);
+            g_planes.absNormalZ[i] = std::abs(planes[i].z);
+            g_planes.distance[i] = planes[i].w;
+        }
+        g_listStats.clear();
+    }
+
+    // Arvo's method, the transformed extent is the absolute rotation/scale part applied to the local extent
+    void GatherBounds(std::vector<RenderItem>& renderItems) {
+        size_t paddedCount = (renderItems.size() + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+        g_bounds.Resize(paddedCount);
+        g_visible.assign(paddedCount, 0);
+        g_alwaysVisible.assign(paddedCount, 0);
+        for (size_t i = 0; i < renderItems.size(); i++) {
+            RenderItem& renderItem = renderItems[i];
+            OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
+            if (!mesh || mesh->aabbMin.x > mesh->aabbMax.x) {
+                g_alwaysVisible[i] = 1;
+                continue;
+            }
+            const glm::mat4& m = renderItem.modelMatrix;
+            glm::vec3 localCenter = (mesh->aabbMin + mesh->aabbMax) * 0.5f;
+            glm::vec3 localExtent = (mesh->aabbMax - mesh->aabbMin) * 0.5f;
+            glm::vec3 center = glm::vec3(m * glm::vec4(localCenter, 1.0f));
+            glm::mat3 absRotation(glm::abs(glm::vec3(m[0])), glm::abs(glm::vec3(m[1])), glm::abs(glm::vec3(m[2])));
+            glm::vec3 extent = absRotation * localExtent;
+            g_bounds.centerX[i] = center.x;
+            g_bounds.centerY[i] = center.y;
+            g_bounds.centerZ[i] = center.z;
+            g_bounds.extentX[i] = extent.x;
+            g_bounds.extentY[i] = extent.y;
+            g_bounds.extentZ[i] = extent.z;
+        }
+    }
+
+#ifdef FRUSTUM_CULLING_SSE
+    void TestBounds(size_t count) {
+        const __m128 zero = _mm_setzero_ps();
+        for (size_t i = 0; i < count; i += BATCH_SIZE) {
+            __m128 centerX = _mm_loadu_ps(&g_bounds.centerX[i]);
+            __m128 centerY = _mm_loadu_ps(&g_bounds.centerY[i]);
+            __m128 centerZ = _mm_loadu_ps(&g_bounds.centerZ[i]);
+            __m128 extentX = _mm_loadu_ps(&g_bounds.extentX[i]);
+            __m128 extentY = _mm_loadu_ps(&g_bounds.extentY[i]);
+            __m128 extentZ = _mm_loadu_ps(&g_bounds.extentZ[i]);
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+            for (int p = 0; p < PLANE_COUNT; p++) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(g_planes.normalX[p]), centerX), _mm_set1_ps(g_planes.distance[p]));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(g_planes.normalY[p]), centerY));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(g_planes.normalZ[p]), centerZ));
+                __m128 radius = _mm_mul_ps(_mm_set1_ps(g_planes.absNormalX[p]), extentX);
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(g_planes.absNormalY[p]), extentY));
+                radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(g_planes.absNormalZ[p]), extentZ));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            int mask = _mm_movemask_ps(inside);
+            for (int lane = 0; lane < BATCH_SIZE; lane++) {
+                g_visible[i + lane] = (mask >> lane) & 1;
+            }
+        }
+    }
+#else
+    void TestBounds(size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            bool inside = true;
+            for (int p = 0; p < PLANE_COUNT; p++) {
+                float distance = g_planes.normalX[p] * g_bounds.centerX[i] + g_planes.normalY[p] * g_bounds.centerY[i] + g_planes.normalZ[p] * g_bounds.centerZ[i] + g_planes.distance[p];
+                float radius = g_planes.absNormalX[p] * g_bounds.extentX[i] + g_planes.absNormalY[p] * g_bounds.extentY[i] + g_planes.absNormalZ[p] * g_bounds.extentZ[i];
+                inside &= distance + radius >= 0.0f;
+            }
+            g_visible[i] = inside;
+        }
+    }
+#endif
+
+    // Compacts the list in place, survivors keep their relative order
+    void Cull(std::vector<RenderItem>& renderItems, const char* listName) {
+        size_t totalCount = renderItems.size();
+        if (totalCount > 0) {
+            GatherBounds(renderItems);
+            TestBounds(g_visible.size());
+            size_t visibleCount = 0;
+            for (size_t i = 0; i < totalCount; i++) {
+                if (g_visible[i] || g_alwaysVisible[i]) {
+                    if (visibleCount != i) {
+                        renderItems[visibleCount] = renderItems[i];
+                    }
+                    visibleCount++;
+                }
+            }
+            renderItems.resize(visibleCount);
+        }
+        ListStats& stats = g_listStats.emplace_back();
+        stats.name = listName;
+        stats.visibleCount = (uint32_t)renderItems.size();
+        stats.culledCount = (uint32_t)(totalCount - renderItems.size());
+    }
+
+    std::string GetDebugText() {
+        std::string text = "Frustum culling\n";
+        for (ListStats& stats : g_listStats) {
+            text += std::string(stats.name) + ": " + std::to_string(stats.visibleCount) + " visible, " + std::to_string(stats.culledCount) + " culled\n";
+        }
+        return text;
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Types.h"
+
+// Tests world space mesh AABBs against the camera frustum four at a time with SSE and drops the render items that are outside
+namespace FrustumCulling {
+    void BeginFrame(const glm::mat4& projectionView);
+    void Cull(std::vector<RenderItem>& renderItems, const char* listName);
+    std::string GetDebugText();
+}
@@ -0,0 +1,261 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace JobSystem {
+
+    constexpr int PRIORITY_COUNT = 3;
+
+    struct Job {
+        std::function<void()> function;
+        std::function<void()> continuation;
+        JobPriority continuationPriority = JobPriority::NORMAL;
+        JobCounter* counter = nullptr;
+    };
+
+    // A short mutex per deque rather than a lock free Chase-Lev deque, jobs here are file loads and mesh work, not microtasks
+    struct JobQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs[PRIORITY_COUNT];
+    };
+
+    // The last queue belongs to threads outside the pool, the main thread mostly, workers steal from it like from each other
+    std::vector<std::unique_ptr<JobQueue>> g_queues;
+    std::vector<std::jthread> g_workers;
+    std::mutex g_sleepMutex;
+    std::condition_variable_any g_jobAvailable;
+    std::atomic<int> g_queuedJobCount = 0;
+    std::atomic<uint64_t> g_executedJobCount = 0;
+    std::atomic<uint64_t> g_stolenJobCount = 0;
+    std::once_flag g_initFlag;
+    bool g_workersPinned = false;
+    thread_local int t_queueIndex = -1;
+
+    int GetExternalQueueIndex() {
+        return (int)g_queues.size() - 1;
+    }
+
+    int GetCurrentQueueIndex() {
+        return t_queueIndex != -1 ? t_queueIndex : GetExternalQueueIndex();
+    }
+
+    void Push(int queueIndex, Job&& job, JobPriority priority) {
+        {
+            std::lock_guard<std::mutex> lock(g_queues[queueIndex]->mutex);
+            g_queues[queueIndex]->jobs[(int)priority].push_back(std::move(job));
+        }
+        g_queuedJobCount++;
+        // Taking the sleep lock orders this against a worker that just found nothing and is about to wait
+        std::lock_guard<std::mutex> lock(g_sleepMutex);
+        g_jobAvailable.notify_one();
+    }
+
+    // Own queue newest first for cache warmth, other queues oldest first
+    bool Pop(int queueIndex, Job& job) {
+        for (int priority = 0; priority < PRIORITY_COUNT; priority++) {
+            {
+                JobQueue& queue = *g_queues[queueIndex];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.jobs[priority].empty()) {
+                    job = std::move(queue.jobs[priority].back());
+                    queue.jobs[priority].pop_back();
+                    g_queuedJobCount--;
+                    return true;
+                }
+            }
+            for (size_t i = 1; i < g_queues.size(); i++) {
+                JobQueue& queue = *g_queues[(queueIndex + i) % g_queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.jobs[priority].empty()) {
+                    job = std::move(queue.jobs[priority].front());
+                    queue.jobs[priority].pop_front();
+                    g_queuedJobCount--;
+                    g_stolenJobCount++;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void Execute(int queueIndex, Job& job) {
+        job.function();
+        g_executedJobCount++;
+        if (job.continuation) {
+            Job continuation;
+            continuation.function = std::move(job.continuation);
+            continuation.counter = job.counter;
+            Push(queueIndex, std::move(continuation), job.continuationPriority);
+        }
+        else if (job.counter) {
+            job.counter->count--;
+        }
+    }
+
+    bool RunOneJob() {
+        int queueIndex = GetCurrentQueueIndex();
+        Job job;
+        if (!Pop(queueIndex, job)) {
+            return false;
+        }
+        Execute(queueIndex, job);
+        return true;
+    }
+
+    void WorkerLoop(std::stop_token stopToken, int queueIndex) {
+        t_queueIndex = queueIndex;
+        while (!stopToken.stop_requested()) {
+            if (RunOneJob()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(g_sleepMutex);
+            g_jobAvailable.wait(lock, stopToken, [] { return g_queuedJobCount > 0; });
+        }
+    }
+
+    /*
+    ▀█▀ █ █ █▀▄ █▀▀ █▀█ █▀▄ █▀▀
+     █  █▀█ █▀▄ █▀▀ █▀█ █ █ ▀▀█
+     ▀  ▀ ▀ ▀ ▀ ▀▀▀ ▀ ▀ ▀▀  ▀▀▀ */
+
+    // Keeps core 0 for the calling thread, which is the render thread, and spreads the workers over the rest
+    void PinThreads() {
+        int coreCount = (int)std::thread::hardware_concurrency();
+        if (coreCount < 2) {
+            std::cout << "JobSystem::PinThreads() failed because there is only one core\n";
+            return;
+        }
+#ifdef _WIN32
+        DWORD_PTR renderMask = 1;
+        DWORD_PTR workerMask = (coreCount >= 64 ? ~(DWORD_PTR)0 : (((DWORD_PTR)1 << coreCount) - 1)) & ~renderMask;
+        SetThreadAffinityMask(GetCurrentThread(), renderMask);
+        for (std::jthread& worker : g_workers) {
+            SetThreadAffinityMask(worker.native_handle(), workerMask);
+        }
+#else
+        cpu_set_t renderSet;
+        CPU_ZERO(&renderSet);
+        CPU_SET(0, &renderSet);
+        cpu_set_t workerSet;
+        CPU_ZERO(&workerSet);
+        for (int i = 1; i < coreCount; i++) {
+            CPU_SET(i, &workerSet);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(renderSet), &renderSet);
+        for (std::jthread& worker : g_workers) {
+            pthread_setaffinity_np(worker.native_handle(), sizeof(workerSet), &workerSet);
+        }
+#endif
+        g_workersPinned = true;
+    }
+
+    // Registered with atexit after every static is constructed, so the workers are joined before any of those are destroyed
+    void Init(int workerCount, bool pinWorkers) {
+        std::call_once(g_initFlag, [workerCount, pinWorkers]() {
+            int count = workerCount > 0 ? workerCount : std::max((int)std::thread::hardware_concurrency() - 1, 1);
+            for (int i = 0; i < count + 1; i++) {
+                g_queues.push_back(std::make_unique<JobQueue>());
+            }
+            for (int i = 0; i < count; i++) {
+                g_workers.emplace_back(WorkerLoop, i);
+            }
+            if (pinWorkers) {
+                PinThreads();
+            }
+            std::atexit(CleanUp);
+        });
+    }
+
+    // Queued jobs are dropped, running ones finish first since they may still be writing into other systems' globals
+    void CleanUp() {
+        for (std::jthread& worker : g_workers) {
+            worker.request_stop();
+        }
+        g_workers.clear();
+        for (std::unique_ptr<JobQueue>& queue : g_queues) {
+            for (std::deque<Job>& jobs : queue->jobs) {
+                jobs.clear();
+            }
+        }
+        g_queuedJobCount = 0;
+    }
+
+    /*
+    █▀▀ █ █ █▀▄ █▄ ▄█ ▀█▀ ▀█▀
+    ▀▀█ █ █ █▀▄ █ █ █  █   █
+    ▀▀▀ ▀▀▀ ▀▀  ▀   ▀ ▀▀▀  ▀ */
+
+    void Submit(std::function<void()> function, JobPriority priority, JobCounter* counter) {
+        Submit(std::move(function), nullptr, priority, JobPriority::NORMAL, counter);
+    }
+
+    void Submit(std::function<void()> function, std::function<void()> continuation, JobPriority priority, JobPriority continuationPriority, JobCounter* counter) {
+        Init();
+        if (counter) {
+            counter->count++;
+        }
+        Job job;
+        job.function = std::move(function);
+        job.continuation = std::move(continuation);
+        job.continuationPriority = continuationPriority;
+        job.counter = counter;
+        Push(GetCurrentQueueIndex(), std::move(job), priority);
+    }
+
+    void Wait(JobCounter& counter) {
+        Init();
+        while (counter.count > 0) {
+            if (!RunOneJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // A handful of jobs claim indices from a shared counter, so a large count doesn't mean a large number of jobs
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function, JobPriority priority) {
+        if (count == 0) {
+            return;
+        }
+        std::atomic<uint32_t> nextIndex = 0;
+        auto claimIndices = [&nextIndex, count, &function]() {
+            for (uint32_t i = nextIndex++; i < count; i = nextIndex++) {
+                function(i);
+            }
+        };
+        JobCounter counter;
+        uint32_t helperCount = std::min(count - 1, (uint32_t)GetWorkerCount());
+        for (uint32_t i = 0; i < helperCount; i++) {
+            Submit(claimIndices, priority, &counter);
+        }
+        claimIndices();
+        Wait(counter);
+    }
+
+    int GetWorkerCount() {
+        Init();
+        return (int)g_workers.size();
+    }
+
+    std::string GetDebugText() {
+        std::string text = "Job system\n";
+        text += "Workers: " + std::to_string(g_workers.size()) + (g_workersPinned ? " (pinned)" : "") + "\n";
+        text += "Queued: " + std::to_string(g_queuedJobCount.load()) + "\n";
+        text += "Executed: " + std::to_string(g_executedJobCount.load()) + " (" + std::to_string(g_stolenJobCount.load()) + " stolen)\n";
+        return text;
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "Enums.h"
+
+// Jobs still pending under a counter, Submit() increments it and it drops once the job and its continuation have both run
+struct JobCounter {
+    std::atomic<int> count = 0;
+};
+
+// Work-stealing pool for CPU only work, nothing submitted here may touch GL. Each worker owns a deque per priority,
+// pops its own newest job and steals the oldest from the others when it runs dry.
+namespace JobSystem {
+    void Init(int workerCount = 0, bool pinWorkers = false);   // 0 leaves one core to the main thread. Optional, first use inits with defaults
+    void CleanUp();
+    void Submit(std::function<void()> function, JobPriority priority = JobPriority::NORMAL, JobCounter* counter = nullptr);
+    // The continuation is queued on the same worker once function returns, e.g. decode then queue for bake
+    void Submit(std::function<void()> function, std::function<void()> continuation, JobPriority priority = JobPriority::NORMAL, JobPriority continuationPriority = JobPriority::NORMAL, JobCounter* counter = nullptr);
+    // Runs other jobs on the calling thread until the counter reaches zero, so waiting from inside a job can't deadlock
+    void Wait(JobCounter& counter);
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function, JobPriority priority = JobPriority::NORMAL);
+    int GetWorkerCount();
+    std::string GetDebugText();
+}
@@ -0,0 +1,108 @@
+#include "RenderQueue.h"
+#include "../AssetManagement/AssetManager.h"
+#include <algorithm>
+#include <bit>
+
+namespace RenderQueue {
+
+    struct RenderQueueEntry {
+        uint64_t sortKey;
+        uint32_t renderItemIndex;
+    };
+
+    constexpr uint64_t FIELD_MASK_4 = 0xF;
+    constexpr uint64_t FIELD_MASK_8 = 0xFF;
+    constexpr uint64_t FIELD_MASK_24 = 0xFFFFFF;
+    constexpr int RADIX_BITS = 8;
+    constexpr int RADIX_BUCKETS = 1 << RADIX_BITS;
+    constexpr int RADIX_PASSES = 64 / RADIX_BITS;
+
+    std::vector<RenderQueueEntry> g_entries;
+    std::vector<RenderQueueEntry> g_scratch;
+    std::vector<RenderItem> g_sortedRenderItems;
+
+    uint64_t CreateSortKey(RenderPass pass, uint32_t shaderVariant, const RenderItem& renderItem, float viewDepth) {
+        // -1 means no material, shift everything up one so it still packs as unsigned
+        uint64_t material = (uint64_t)(renderItem.materialIndex + 1) & FIELD_MASK_24;
+        uint64_t key = ((uint64_t)pass & FIELD_MASK_4) << 60;
+        key |= ((uint64_t)shaderVariant & FIELD_MASK_4) << 56;
+        if (pass == RenderPass::BLENDED) {
+            // Positive floats order the same as their bit patterns, inverting them puts the farthest item first
+            uint32_t depthBits = std::bit_cast<uint32_t>(std::max(viewDepth, 0.0f));
+            key |= (uint64_t)(~depthBits) << 24;
+            key |= material;
+        }
+        else {
+            uint64_t mesh = (uint64_t)renderItem.meshIndex & FIELD_MASK_24;
+            key |= material << 32;
+            key |= mesh << 8;
+            key |= (uint64_t)renderItem.lodIndex & FIELD_MASK_8;
+        }
+        return key;
+    }
+
+    uint32_t GetMaterialBits(uint64_t sortKey) {
+        RenderPass pass = (RenderPass)(sortKey >> 60);
+        if (pass == RenderPass::BLENDED) {
+            return (uint32_t)(sortKey & FIELD_MASK_24);
+        }
+        return (uint32_t)((sortKey >> 32) & FIELD_MASK_24);
+    }
+
+    float GetViewDepth(const RenderItem& renderItem, const glm::mat4& viewMatrix) {
+        OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(renderItem.meshIndex);
+        glm::vec3 localCenter = mesh ? (mesh->aabbMin + mesh->aabbMax) * 0.5f : glm::vec3(0.0f);
+        glm::vec4 viewPosition = viewMatrix * renderItem.modelMatrix * glm::vec4(localCenter, 1.0f);
+        return -viewPosition.z;
+    }
+
+    // LSD radix sort, one histogram sweep up front and any byte that is identical across every key is skipped
+    void RadixSort(std::vector<RenderQueueEntry>& entries) {
+        uint32_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+        for (const RenderQueueEntry& entry : entries) {
+            for (int pass = 0; pass < RADIX_PASSES; pass++) {
+                histograms[pass][(entry.sortKey >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+            }
+        }
+        g_scratch.resize(entries.size());
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            uint32_t* histogram = histograms[pass];
+            int shift = pass * RADIX_BITS;
+            if (histogram[(entries[0].sortKey >> shift) & (RADIX_BUCKETS - 1)] == entries.size()) {
+                continue;
+            }
+            uint32_t offset = 0;
+            for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+                uint32_t count = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += count;
+            }
+            for (const RenderQueueEntry& entry : entries) {
+                g_scratch[histogram[(entry.sortKey >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+            }
+            entries.swap(g_scratch);
+        }
+    }
+
+    void Sort(std::vector<RenderItem>& renderItems, RenderPass pass, const glm::mat4& viewMatrix, uint32_t shaderVariant) {
+        if (renderItems.empty()) {
+            return;
+        }
+        g_entries.resize(renderItems.size());
+        for (uint32_t i = 0; i < renderItems.size(); i++) {
+            RenderItem& renderItem = renderItems[i];
+            float viewDepth = (pass == RenderPass::BLENDED) ? GetViewDepth(renderItem, viewMatrix) : 0.0f;
+            renderItem.sortKey = CreateSortKey(pass, shaderVariant, renderItem, viewDepth);
+            g_entries[i].sortKey = renderItem.sortKey;
+            g_entries[i].renderItemIndex = i;
+        }
+        RadixSort(g_entries);
+
+        // Only the small key/index entries move during the sort, the render items are gathered once at the end
+        g_sortedRenderItems.clear();
+        for (const RenderQueueEntry& entry : g_entries) {
+            g_sortedRenderItems.push_back(renderItems[entry.renderItemIndex]);
+        }
+        renderItems.swap(g_sortedRenderItems);
+    }
+}
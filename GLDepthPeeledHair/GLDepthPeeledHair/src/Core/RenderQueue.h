@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Types.h"
+
+enum class RenderPass {
+    SOLID,
+    BLENDED,
+    HAIR_TOP_LAYER,
+    HAIR_BOTTOM_LAYER
+};
+
+// Sort key layout, most significant bits first
+//   63..60  pass
+//   59..56  shader variant
+//   Solid and hair:   55..32 material, 31..8 mesh, 7..0 LOD
+//   Blended:          55..24 inverted view depth (back to front), 23..0 material
+namespace RenderQueue {
+    uint64_t CreateSortKey(RenderPass pass, uint32_t shaderVariant, const RenderItem& renderItem, float viewDepth);
+    uint32_t GetMaterialBits(uint64_t sortKey);
+    void Sort(std::vector<RenderItem>& renderItems, RenderPass pass, const glm::mat4& viewMatrix, uint32_t shaderVariant = 0);
+}
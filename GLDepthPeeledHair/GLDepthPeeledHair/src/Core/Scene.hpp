@@ -67,43 +67,34 @@ namespace Scene {
             room->SetMeshMaterialByMeshName("WallXNeg", "BathroomWall");
         }
 
-        GameObject* mermaid = GetGameObjectByName("Mermaid");
-        if (mermaid) {
-            mermaid->SetMeshMaterialByMeshName("Rock", "Rock");
-            mermaid->SetMeshMaterialByMeshName("BoobTube", "BoobTube");
-            mermaid->SetMeshMaterialByMeshName("Face", "MermaidFace");
-            mermaid->SetMeshMaterialByMeshName("Body", "MermaidBody");
-            mermaid->SetMeshMaterialByMeshName("Arms", "MermaidArms");
-            mermaid->SetMeshMaterialByMeshName("HairInner", "MermaidHair");
-            mermaid->SetMeshMaterialByMeshName("HairOutta", "MermaidHair");
-            mermaid->SetMeshMaterialByMeshName("HairScalp", "MermaidScalp");
-            mermaid->SetMeshMaterialByMeshName("EyeLeft", "MermaidEye");
-            mermaid->SetMeshMaterialByMeshName("EyeRight", "MermaidEye");
-            mermaid->SetMeshMaterialByMeshName("Tail", "MermaidTail");
-            mermaid->SetMeshMaterialByMeshName("TailFin", "MermaidTail");
-            mermaid->SetMeshMaterialByMeshName("EyelashUpper_HP", "MermaidLashes");
-            mermaid->SetMeshMaterialByMeshName("EyelashLower_HP", "MermaidLashes");
-            mermaid->SetMeshMaterialByMeshName("Nails", "Nails");
+        // Every mermaid, the stress scene spawns more than one
+        for (GameObject& mermaid : g_gameObjects) {
+            if (mermaid.m_name != "Mermaid") {
+                continue;
+            }
+            mermaid.SetMeshMaterialByMeshName("Rock", "Rock");
+            mermaid.SetMeshMaterialByMeshName("BoobTube", "BoobTube");
+            mermaid.SetMeshMaterialByMeshName("Face", "MermaidFace");
+            mermaid.SetMeshMaterialByMeshName("Body", "MermaidBody");
+            mermaid.SetMeshMaterialByMeshName("Arms", "MermaidArms");
+            mermaid.SetMeshMaterialByMeshName("HairInner", "MermaidHair");
+            mermaid.SetMeshMaterialByMeshName("HairOutta", "MermaidHair");
+            mermaid.SetMeshMaterialByMeshName("HairScalp", "MermaidScalp");
+            mermaid.SetMeshMaterialByMeshName("EyeLeft", "MermaidEye");
+            mermaid.SetMeshMaterialByMeshName("EyeRight", "MermaidEye");
+            mermaid.SetMeshMaterialByMeshName("Tail", "MermaidTail");
+            mermaid.SetMeshMaterialByMeshName("TailFin", "MermaidTail");
+            mermaid.SetMeshMaterialByMeshName("EyelashUpper_HP", "MermaidLashes");
+            mermaid.SetMeshMaterialByMeshName("EyelashLower_HP", "MermaidLashes");
+            mermaid.SetMeshMaterialByMeshName("Nails", "Nails");
         }
     }
 
-    inline void CreateGameObjects() {
-        //CreateGameObject();
-        //GameObject* room = &g_gameObjects[g_gameObjects.size() - 1];
-        //room->SetModel("Room");
-        //room->SetMeshMaterialByMeshName("PlatformSide", "BathroomFloor");
-        //room->SetMeshMaterialByMeshName("PlatformTop", "BathroomFloor");
-        //room->SetMeshMaterialByMeshName("Floor", "BathroomFloor");
-        //room->SetMeshMaterialByMeshName("Ceiling", "Ceiling2");
-        //room->SetMeshMaterialByMeshName("WallZPos", "BathroomWall");
-        //room->SetMeshMaterialByMeshName("WallZNeg", "BathroomWall");
-        //room->SetMeshMaterialByMeshName("WallXPos", "BathroomWall");
-        //room->SetMeshMaterialByMeshName("WallXNeg", "BathroomWall");
-        
+    inline void CreateMermaid(glm::vec3 position, float rotationY) {
         CreateGameObject();
         GameObject* mermaid = &g_gameObjects[g_gameObjects.size() - 1];
-        mermaid->SetPosition(glm::vec3(3.5, -1.0f, 7.5f));
-        mermaid->SetRotationY(3.14f * 1.7f);
+        mermaid->SetPosition(position);
+        mermaid->SetRotationY(rotationY);
         mermaid->SetModel("Mermaid");
         mermaid->SetMeshMaterialByMeshName("Rock", "Rock");
         mermaid->SetMeshMaterialByMeshName("BoobTube", "BoobTube");
@@ -128,6 +119,33 @@ namespace Scene {
         mermaid->SetName("Mermaid");
     }
 
+    inline void CreateGameObjects() {
+        //CreateGameObject();
+        //GameObject* room = &g_gameObjects[g_gameObjects.size() - 1];
+        //room->SetModel("Room");
+        //room->SetMeshMaterialByMeshName("PlatformSide", "BathroomFloor");
+        //room->SetMeshMaterialByMeshName("PlatformTop", "BathroomFloor");
+        //room->SetMeshMaterialByMeshName("Floor", "BathroomFloor");
+        //room->SetMeshMaterialByMeshName("Ceiling", "Ceiling2");
+        //room->SetMeshMaterialByMeshName("WallZPos", "BathroomWall");
+        //room->SetMeshMaterialByMeshName("WallZNeg", "BathroomWall");
+        //room->SetMeshMaterialByMeshName("WallXPos", "BathroomWall");
+        //room->SetMeshMaterialByMeshName("WallXNeg", "BathroomWall");
+        
+        CreateMermaid(glm::vec3(3.5, -1.0f, 7.5f), 3.14f * 1.7f);
+    }
+
+    // Every extra mermaid shares the first one's model, so the stress scene measures how draws scale with instance count
+    inline void CreateMermaidStressScene(int mermaidCount) {
+        const int columns = 8;
+        const float spacing = 2.5f;
+        for (int i = 1; i < mermaidCount; i++) {
+            int column = i % columns;
+            int row = i / columns;
+            CreateMermaid(glm::vec3(3.5f + column * spacing, -1.0f, 7.5f + row * spacing), 3.14f * 1.7f);
+        }
+    }
+
     inline std::vector<RenderItem>& GetRenderItems() { return g_renderItems; }
     inline std::vector<RenderItem>& GetRenderItemsBlended() { return g_renderItemsBlended; }
     inline std::vector<RenderItem>& GetRenderItemsAlphaDiscarded() { return g_renderItemsAlphaDiscarded; }
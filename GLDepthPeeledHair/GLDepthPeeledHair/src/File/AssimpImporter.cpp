@@ -7,6 +7,8 @@
 #include <assimp/Scene.h>
 #include <assimp/PostProcess.h>
 #include "../Util.hpp"
+#include "../Tools/MeshTools.h"
+#include "../Core/JobSystem.h"
 
 ModelData AssimpImporter::ImportFbx(const std::string filepath) {
     ModelData modelData;
@@ -15,7 +17,6 @@ ModelData AssimpImporter::ImportFbx(const std::string filepath) {
     const aiScene* scene = importer.ReadFile(filepath,
         aiProcess_Triangulate |
         aiProcess_JoinIdenticalVertices |
-        aiProcess_ImproveCacheLocality |
         aiProcess_RemoveRedundantMaterials |
         aiProcess_FlipUVs
     );
@@ -40,8 +41,8 @@ ModelData AssimpImporter::ImportFbx(const std::string filepath) {
         // Remove blender naming mess
         meshData.name = meshData.name.substr(0, meshData.name.find('.'));
     }
-    // Populate vectors
-    for (int i = 0; i < modelData.meshes.size(); i++) {
+    // Populate vectors, meshes are independent so each one is processed on its own worker
+    JobSystem::ParallelFor((uint32_t)modelData.meshes.size(), [&modelData, scene](uint32_t i) {
         MeshData& meshData = modelData.meshes[i];
         const aiMesh* assimpMesh = scene->mMeshes[i];
         // Vertices
@@ -88,6 +89,14 @@ ModelData AssimpImporter::ImportFbx(const std::string filepath) {
             vert1->tangent = tangent;
             vert2->tangent = tangent;
         }
+        // Vertex cache, overdraw and vertex fetch order, replaces aiProcess_ImproveCacheLocality
+        MeshTools::OptimizeMesh(meshData);
+        if (MeshTools::IsHairCardMesh(meshData.indices, meshData.vertices)) {
+            MeshTools::BuildClusters(meshData);
+        }
+        MeshTools::GenerateLods(meshData);
+    });
+    for (MeshData& meshData : modelData.meshes) {
         modelData.aabbMin = Util::Vec3Min(modelData.aabbMin, meshData.aabbMin);
         modelData.aabbMax = Util::Vec3Max(modelData.aabbMax, meshData.aabbMax);
     }
@@ -4,7 +4,9 @@
 #include <string>
 #include <cstdint>
 #include <chrono>
+#include <cstring>
 #include "../Util.hpp"
+#include "../Common/VertexCompression.hpp"
 
 #define PRINT_MODEL_HEADERS_ON_READ 0
 #define PRINT_MODEL_HEADERS_ON_WRITE 0
@@ -16,6 +18,21 @@
 █ █ █ █ █ █ █ █▀▀ █   ▀▀█
 ▀   ▀ ▀▀▀ ▀▀  ▀▀▀ ▀▀▀ ▀▀▀ */
 
+namespace {
+    // Pads the buffer to the file alignment, appends the bytes and returns where they start
+    uint64_t AppendSection(std::vector<uint8_t>& buffer, const void* data, size_t size) {
+        buffer.resize((buffer.size() + MODEL_FILE_ALIGNMENT - 1) / MODEL_FILE_ALIGNMENT * MODEL_FILE_ALIGNMENT, 0);
+        uint64_t offset = buffer.size();
+        buffer.insert(buffer.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        return offset;
+    }
+
+    bool SectionInBounds(const MappedFile& file, uint64_t offset, uint64_t size) {
+        return offset % MODEL_FILE_ALIGNMENT == 0 && offset <= file.GetSize() && size <= file.GetSize() - offset;
+    }
+}
+
+// The whole file is assembled in memory so the header and table of contents can point at sections written after them
 void File::ExportModel(const ModelData& modelData) {
     std::string outputPath = "res/models/" + modelData.name + ".model";
     std::ofstream file(outputPath, std::ios::binary);
@@ -23,46 +40,137 @@ void File::ExportModel(const ModelData& modelData) {
         std::cout << "Failed to open file for writing: " << outputPath << "\n";
         return;
     }
-    ModelHeader modelHeader;
-    modelHeader.version = 1;
-    modelHeader.meshCount = modelData.meshCount;
-    modelHeader.nameLength = modelData.name.size();
-    modelHeader.timestamp = modelData.timestamp;
-    modelHeader.aabbMin = modelData.aabbMin;
-    modelHeader.aabbMax = modelData.aabbMax;
-    file.write((char*)&modelHeader.version, sizeof(modelHeader.version));
-    file.write((char*)&modelHeader.meshCount, sizeof(modelHeader.meshCount));
-    file.write((char*)&modelHeader.nameLength, sizeof(modelHeader.nameLength));
-    file.write(modelData.name.data(), modelHeader.nameLength);
-    file.write(reinterpret_cast<char*>(&modelHeader.timestamp), sizeof(modelHeader.timestamp));
-    file.write(reinterpret_cast<const char*>(&modelHeader.aabbMin), sizeof(glm::vec3));
-    file.write(reinterpret_cast<const char*>(&modelHeader.aabbMax), sizeof(glm::vec3));
-#if PRINT_MODEL_HEADERS_ON_WRITE
-    PrintModelHeader(modelHeader, "Wrote model header: " + modelData.name);
-#endif
-    for (const MeshData& meshData : modelData.meshes) {
-        MeshHeader meshHeader;
-        meshHeader.nameLength = (uint32_t)meshData.name.size();
-        meshHeader.vertexCount = (uint32_t)meshData.vertices.size();
-        meshHeader.indexCount = (uint32_t)meshData.indices.size();
-        meshHeader.aabbMin = meshData.aabbMin;
-        meshHeader.aabbMax = meshData.aabbMax;
-        file.write((char*)&meshHeader.nameLength, sizeof(meshHeader.nameLength));
-        file.write((char*)&meshHeader.vertexCount, sizeof(meshHeader.vertexCount));
-        file.write((char*)&meshHeader.indexCount, sizeof(meshHeader.indexCount));
-        file.write(meshData.name.data(), meshHeader.nameLength);
-        file.write(reinterpret_cast<const char*>(&meshHeader.aabbMin), sizeof(glm::vec3));
-        file.write(reinterpret_cast<const char*>(&meshHeader.aabbMax), sizeof(glm::vec3));
-        file.write(reinterpret_cast<const char*>(meshData.vertices.data()), meshData.vertices.size() * sizeof(Vertex));
-        file.write(reinterpret_cast<const char*>(meshData.indices.data()), meshData.indices.size() * sizeof(uint32_t));
+    ModelFileHeader fileHeader;
+    fileHeader.meshCount = (uint32_t)modelData.meshes.size();
+    fileHeader.nameLength = (uint32_t)modelData.name.size();
+    fileHeader.timestamp = modelData.timestamp;
+    fileHeader.aabbMin = modelData.aabbMin;
+    fileHeader.aabbMax = modelData.aabbMax;
+    std::vector<MeshTocEntry> toc(modelData.meshes.size());
+
+    std::vector<uint8_t> buffer;
+    AppendSection(buffer, &fileHeader, sizeof(fileHeader));
+    fileHeader.nameOffset = (uint32_t)AppendSection(buffer, modelData.name.data(), modelData.name.size());
+    fileHeader.tocOffset = AppendSection(buffer, toc.data(), toc.size() * sizeof(MeshTocEntry));
+    for (size_t i = 0; i < modelData.meshes.size(); i++) {
+        const MeshData& meshData = modelData.meshes[i];
+        MeshTocEntry& entry = toc[i];
+
+        // LOD 0 is the full mesh, the coarser levels follow it in the same index section
+        std::vector<uint32_t> indices = meshData.indices;
+        std::vector<MeshLod> lods;
+        lods.push_back(MeshLod{ 0, (uint32_t)meshData.indices.size(), 0.0f, 1.0f });
+        for (const MeshLodData& lodData : meshData.lods) {
+            lods.push_back(MeshLod{ (uint32_t)indices.size(), (uint32_t)lodData.indices.size(), lodData.error, lodData.alphaScale });
+            indices.insert(indices.end(), lodData.indices.begin(), lodData.indices.end());
+        }
+        std::vector<CompactVertex> compactVertices = VertexCompression::Pack(meshData.vertices);
+
+        entry.nameOffset = (uint32_t)AppendSection(buffer, meshData.name.data(), meshData.name.size());
+        entry.nameLength = (uint32_t)meshData.name.size();
+        entry.vertexCount = (uint32_t)compactVertices.size();
+        entry.indexCount = (uint32_t)indices.size();
+        entry.lodCount = (uint32_t)lods.size();
+        entry.clusterCount = (uint32_t)meshData.clusters.size();
+        entry.aabbMin = meshData.aabbMin;
+        entry.aabbMax = meshData.aabbMax;
+        entry.vertexOffset = AppendSection(buffer, compactVertices.data(), compactVertices.size() * sizeof(CompactVertex));
+        if (compactVertices.size() <= 0xFFFF) {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            entry.indexSize = sizeof(uint16_t);
+            entry.indexOffset = AppendSection(buffer, shortIndices.data(), shortIndices.size() * sizeof(uint16_t));
+        }
+        else {
+            entry.indexSize = sizeof(uint32_t);
+            entry.indexOffset = AppendSection(buffer, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+        entry.lodOffset = AppendSection(buffer, lods.data(), lods.size() * sizeof(MeshLod));
+        entry.clusterOffset = AppendSection(buffer, meshData.clusters.data(), meshData.clusters.size() * sizeof(MeshCluster));
 #if PRINT_MESH_HEADERS_ON_WRITE
-        PrintMeshHeader(meshHeader, "Wrote mesh: " + meshData.name);
+        PrintMeshHeader(MeshHeader{ entry.nameLength, entry.vertexCount, entry.indexCount, entry.aabbMin, entry.aabbMax }, "Wrote mesh: " + meshData.name);
 #endif
     }
+    std::memcpy(buffer.data(), &fileHeader, sizeof(fileHeader));
+    std::memcpy(buffer.data() + fileHeader.tocOffset, toc.data(), toc.size() * sizeof(MeshTocEntry));
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
     file.close();
+#if PRINT_MODEL_HEADERS_ON_WRITE
+    PrintModelHeader(ReadModelHeader(outputPath), "Wrote model header: " + modelData.name);
+#endif
     std::cout << "Exported: " << outputPath << "\n";
 }
 
+// Fails quietly on files older than version 6 so the caller can fall back to ImportModel()
+bool File::MapModel(const std::string& filepath, MappedModel& mappedModel) {
+    ModelHeader modelHeader = ReadModelHeader(filepath);
+    if (modelHeader.version < 6) {
+        return false;
+    }
+    MappedFile& file = mappedModel.file;
+    if (!file.Open(filepath)) {
+        return false;
+    }
+    if (file.GetSize() < sizeof(ModelFileHeader)) {
+        std::cout << "File::MapModel() failed because '" << filepath << "' is smaller than its header\n";
+        file.Close();
+        return false;
+    }
+    const uint8_t* data = file.GetData();
+    const ModelFileHeader* fileHeader = reinterpret_cast<const ModelFileHeader*>(data);
+    if (!SectionInBounds(file, fileHeader->nameOffset, fileHeader->nameLength) ||
+        !SectionInBounds(file, fileHeader->tocOffset, (uint64_t)fileHeader->meshCount * sizeof(MeshTocEntry))) {
+        std::cout << "File::MapModel() failed because the table of contents of '" << filepath << "' is out of bounds\n";
+        file.Close();
+        return false;
+    }
+    mappedModel.name.assign(reinterpret_cast<const char*>(data + fileHeader->nameOffset), fileHeader->nameLength);
+    mappedModel.timestamp = fileHeader->timestamp;
+    mappedModel.aabbMin = fileHeader->aabbMin;
+    mappedModel.aabbMax = fileHeader->aabbMax;
+    mappedModel.meshes.resize(fileHeader->meshCount);
+    const MeshTocEntry* toc = reinterpret_cast<const MeshTocEntry*>(data + fileHeader->tocOffset);
+    for (uint32_t i = 0; i < fileHeader->meshCount; i++) {
+        const MeshTocEntry& entry = toc[i];
+        bool inBounds = (entry.indexSize == 2 || entry.indexSize == 4);
+        inBounds &= SectionInBounds(file, entry.nameOffset, entry.nameLength);
+        inBounds &= SectionInBounds(file, entry.vertexOffset, (uint64_t)entry.vertexCount * sizeof(CompactVertex));
+        inBounds &= SectionInBounds(file, entry.indexOffset, (uint64_t)entry.indexCount * entry.indexSize);
+        inBounds &= SectionInBounds(file, entry.lodOffset, (uint64_t)entry.lodCount * sizeof(MeshLod));
+        inBounds &= SectionInBounds(file, entry.clusterOffset, (uint64_t)entry.clusterCount * sizeof(MeshCluster));
+        if (inBounds) {
+            // ImportModel slices each LOD out of the index data, so a LOD range past the end would read out of bounds
+            const MeshLod* lods = reinterpret_cast<const MeshLod*>(data + entry.lodOffset);
+            for (uint32_t j = 0; j < entry.lodCount && inBounds; j++) {
+                inBounds = (uint64_t)lods[j].firstIndex + lods[j].indexCount <= entry.indexCount;
+            }
+        }
+        if (!inBounds) {
+            std::cout << "File::MapModel() failed because mesh " << i << " of '" << filepath << "' is out of bounds\n";
+            UnmapModel(mappedModel);
+            return false;
+        }
+        MappedMeshView& meshView = mappedModel.meshes[i];
+        meshView.name = std::string_view(reinterpret_cast<const char*>(data + entry.nameOffset), entry.nameLength);
+        meshView.vertices = reinterpret_cast<const CompactVertex*>(data + entry.vertexOffset);
+        meshView.indices = data + entry.indexOffset;
+        meshView.lods = reinterpret_cast<const MeshLod*>(data + entry.lodOffset);
+        meshView.clusters = reinterpret_cast<const MeshCluster*>(data + entry.clusterOffset);
+        meshView.vertexCount = entry.vertexCount;
+        meshView.indexCount = entry.indexCount;
+        meshView.indexSize = entry.indexSize;
+        meshView.lodCount = entry.lodCount;
+        meshView.clusterCount = entry.clusterCount;
+        meshView.aabbMin = entry.aabbMin;
+        meshView.aabbMax = entry.aabbMax;
+    }
+    return true;
+}
+
+void File::UnmapModel(MappedModel& mappedModel) {
+    mappedModel.meshes.clear();
+    mappedModel.file.Close();
+}
+
 ModelHeader File::ReadModelHeader(const std::string& filepath) {
     ModelHeader header;
     std::ifstream file(filepath, std::ios::binary);
@@ -71,6 +179,17 @@ ModelHeader File::ReadModelHeader(const std::string& filepath) {
         return header;
     }
     file.read((char*)&header.version, sizeof(header.version));
+    if (header.version >= 6) {
+        ModelFileHeader fileHeader;
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+        header.meshCount = fileHeader.meshCount;
+        header.nameLength = fileHeader.nameLength;
+        header.timestamp = fileHeader.timestamp;
+        header.aabbMin = fileHeader.aabbMin;
+        header.aabbMax = fileHeader.aabbMax;
+        return header;
+    }
     file.read((char*)&header.meshCount, sizeof(header.meshCount));
     file.read((char*)&header.nameLength, sizeof(header.nameLength));
     std::string modelName(header.nameLength, '\0');
@@ -79,8 +198,49 @@ ModelHeader File::ReadModelHeader(const std::string& filepath) {
     return header;
 }
 
+// Version 6 files go through the mapping and are expanded into MeshData, anything older is read as a stream
 ModelData File::ImportModel(const std::string& filepath) {
     ModelData modelData;
+    MappedModel mappedModel;
+    if (MapModel(filepath, mappedModel)) {
+        modelData.name = mappedModel.name;
+        modelData.timestamp = mappedModel.timestamp;
+        modelData.aabbMin = mappedModel.aabbMin;
+        modelData.aabbMax = mappedModel.aabbMax;
+        modelData.meshCount = (uint32_t)mappedModel.meshes.size();
+        modelData.meshes.resize(mappedModel.meshes.size());
+        for (size_t i = 0; i < mappedModel.meshes.size(); i++) {
+            const MappedMeshView& meshView = mappedModel.meshes[i];
+            MeshData& meshData = modelData.meshes[i];
+            meshData.name = std::string(meshView.name);
+            meshData.aabbMin = meshView.aabbMin;
+            meshData.aabbMax = meshView.aabbMax;
+            meshData.vertices.resize(meshView.vertexCount);
+            for (uint32_t j = 0; j < meshView.vertexCount; j++) {
+                meshData.vertices[j] = VertexCompression::Unpack(meshView.vertices[j]);
+            }
+            std::vector<uint32_t> indices(meshView.indexCount);
+            for (uint32_t j = 0; j < meshView.indexCount; j++) {
+                indices[j] = (meshView.indexSize == 2) ? static_cast<const uint16_t*>(meshView.indices)[j] : static_cast<const uint32_t*>(meshView.indices)[j];
+            }
+            for (uint32_t j = 0; j < meshView.lodCount; j++) {
+                const MeshLod& lod = meshView.lods[j];
+                std::vector<uint32_t> lodIndices(indices.begin() + lod.firstIndex, indices.begin() + lod.firstIndex + lod.indexCount);
+                if (j == 0) {
+                    meshData.indices = std::move(lodIndices);
+                }
+                else {
+                    meshData.lods.push_back(MeshLodData{ std::move(lodIndices), lod.error, lod.alphaScale });
+                }
+            }
+            meshData.clusters.assign(meshView.clusters, meshView.clusters + meshView.clusterCount);
+            meshData.vertexCount = (int)meshData.vertices.size();
+            meshData.indexCount = (int)meshData.indices.size();
+        }
+        UnmapModel(mappedModel);
+        std::cout << "Loaded: " << filepath << "\n";
+        return modelData;
+    }
     std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Failed to open file for reading: " << filepath << "\n";
@@ -121,8 +281,36 @@ ModelData File::ImportModel(const std::string& filepath) {
         meshData.indices.resize(meshData.indexCount);
         meshData.aabbMin = meshHeader.aabbMin;
         meshData.aabbMax = meshHeader.aabbMax;
-        file.read(reinterpret_cast<char*>(meshData.vertices.data()), meshHeader.vertexCount * sizeof(Vertex));
+        if (modelHeader.version >= 2) {
+            std::vector<CompactVertex> compactVertices(meshHeader.vertexCount);
+            file.read(reinterpret_cast<char*>(compactVertices.data()), meshHeader.vertexCount * sizeof(CompactVertex));
+            for (uint32_t j = 0; j < meshHeader.vertexCount; j++) {
+                meshData.vertices[j] = VertexCompression::Unpack(compactVertices[j]);
+            }
+        }
+        else {
+            file.read(reinterpret_cast<char*>(meshData.vertices.data()), meshHeader.vertexCount * sizeof(Vertex));
+        }
         file.read(reinterpret_cast<char*>(meshData.indices.data()), meshHeader.indexCount * sizeof(uint32_t));
+        if (modelHeader.version >= 4) {
+            uint32_t lodCount = 0;
+            file.read((char*)&lodCount, sizeof(lodCount));
+            meshData.lods.resize(lodCount);
+            for (MeshLodData& lod : meshData.lods) {
+                uint32_t lodIndexCount = 0;
+                file.read((char*)&lodIndexCount, sizeof(lodIndexCount));
+                file.read((char*)&lod.error, sizeof(lod.error));
+                file.read((char*)&lod.alphaScale, sizeof(lod.alphaScale));
+                lod.indices.resize(lodIndexCount);
+                file.read(reinterpret_cast<char*>(lod.indices.data()), lodIndexCount * sizeof(uint32_t));
+            }
+        }
+        if (modelHeader.version >= 5) {
+            uint32_t clusterCount = 0;
+            file.read((char*)&clusterCount, sizeof(clusterCount));
+            meshData.clusters.resize(clusterCount);
+            file.read(reinterpret_cast<char*>(meshData.clusters.data()), clusterCount * sizeof(MeshCluster));
+        }
 #if PRINT_MESH_HEADERS_ON_READ
         PrintMeshHeader(meshHeader, "Read mesh: " + meshData.name);
 #endif
@@ -132,6 +320,347 @@ ModelData File::ImportModel(const std::string& filepath) {
     return modelData;
 }
 
+/*
+█▀▀ █▀█ █▄ ▄█ █▀▀ █▀▄ █▀█   █▀█ █▀█ ▀█▀ █ █
+█   █▀█ █ █ █ █▀▀ █▀▄ █▀█   █▀▀ █▀█  █  █▀█
+▀▀▀ ▀ ▀ ▀   ▀ ▀▀▀ ▀ ▀ ▀ ▀   ▀   ▀ ▀  ▀  ▀ ▀ */
+
+void File::ExportCameraPath(const std::string& filepath, const CameraPathData& cameraPathData) {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Failed to open file for writing: " << filepath << "\n";
+        return;
+    }
+    CameraPathHeader header;
+    header.version = 1;
+    header.frameCount = (uint32_t)cameraPathData.frames.size();
+    header.deltaTime = cameraPathData.deltaTime;
+    file.write(header.fileSignature, sizeof(header.fileSignature));
+    file.write((char*)&header.version, sizeof(header.version));
+    file.write((char*)&header.frameCount, sizeof(header.frameCount));
+    file.write((char*)&header.deltaTime, sizeof(header.deltaTime));
+    file.write(reinterpret_cast<const char*>(cameraPathData.frames.data()), cameraPathData.frames.size() * sizeof(CameraPathFrame));
+    file.close();
+    std::cout << "Exported: " << filepath << "\n";
+}
+
+bool File::ImportCameraPath(const std::string& filepath, CameraPathData& cameraPathData) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for reading: " << filepath << "\n";
+        return false;
+    }
+    CameraPathHeader header;
+    char signature[sizeof(header.fileSignature)];
+    file.read(signature, sizeof(signature));
+    if (std::memcmp(signature, header.fileSignature, sizeof(signature)) != 0) {
+        std::cerr << "File::ImportCameraPath() failed: '" << filepath << "' is not a camera path\n";
+        return false;
+    }
+    file.read((char*)&header.version, sizeof(header.version));
+    file.read((char*)&header.frameCount, sizeof(header.frameCount));
+    file.read((char*)&header.deltaTime, sizeof(header.deltaTime));
+    if (!file || header.version != 1) {
+        std::cerr << "File::ImportCameraPath() failed: '" << filepath << "' has unsupported version " << header.version << "\n";
+        return false;
+    }
+    // Check the frame count against what is actually left before allocating for it
+    std::streampos framesStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t remainingSize = (uint64_t)(file.tellg() - framesStart);
+    file.seekg(framesStart);
+    if ((uint64_t)header.frameCount * sizeof(CameraPathFrame) > remainingSize) {
+        std::cerr << "File::ImportCameraPath() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    cameraPathData.name = Util::GetFileName(filepath);
+    cameraPathData.deltaTime = header.deltaTime;
+    cameraPathData.frames.resize(header.frameCount);
+    file.read(reinterpret_cast<char*>(cameraPathData.frames.data()), header.frameCount * sizeof(CameraPathFrame));
+    if (!file) {
+        std::cerr << "File::ImportCameraPath() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    file.close();
+    return true;
+}
+
+/*
+█▀▀ █     █▀▀ █▀█ █▀█ ▀█▀ █ █ █▀▄ █▀▀
+█ █ █     █   █▀█ █▀▀  █  █ █ █▀▄ █▀▀
+▀▀▀ ▀▀▀   ▀▀▀ ▀ ▀ ▀    ▀  ▀▀▀ ▀ ▀ ▀▀▀ */
+
+namespace {
+    void WriteBytes(std::ofstream& file, const std::vector<uint8_t>& bytes) {
+        uint64_t size = bytes.size();
+        file.write((char*)&size, sizeof(size));
+        file.write(reinterpret_cast<const char*>(bytes.data()), size);
+    }
+
+    void WriteString(std::ofstream& file, const std::string& string) {
+        uint32_t length = (uint32_t)string.length();
+        file.write((char*)&length, sizeof(length));
+        file.write(string.data(), length);
+    }
+
+    // Counts and sizes come straight from the file, so anything claiming more than the bytes left is rejected before allocating
+    bool FitsInFile(std::ifstream& file, uint64_t fileSize, uint64_t count, uint64_t elementSize) {
+        if (!file) {
+            return false;
+        }
+        uint64_t position = (uint64_t)file.tellg();
+        return position <= fileSize && count <= (fileSize - position) / elementSize;
+    }
+
+    bool ReadBytes(std::ifstream& file, uint64_t fileSize, std::vector<uint8_t>& bytes) {
+        uint64_t size = 0;
+        file.read((char*)&size, sizeof(size));
+        if (!FitsInFile(file, fileSize, size, 1)) {
+            return false;
+        }
+        bytes.resize(size);
+        file.read(reinterpret_cast<char*>(bytes.data()), size);
+        return (bool)file;
+    }
+
+    bool ReadString(std::ifstream& file, uint64_t fileSize, std::string& string) {
+        uint32_t length = 0;
+        file.read((char*)&length, sizeof(length));
+        if (!FitsInFile(file, fileSize, length, 1)) {
+            return false;
+        }
+        string.resize(length);
+        file.read(string.data(), length);
+        return (bool)file;
+    }
+}
+
+void File::ExportGLCapture(const std::string& filepath, const GLCaptureData& captureData) {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Failed to open file for writing: " << filepath << "\n";
+        return;
+    }
+    GLCaptureHeader header;
+    header.version = 1;
+    header.width = captureData.width;
+    header.height = captureData.height;
+    header.callCount = (uint32_t)captureData.calls.size();
+    header.blobCount = (uint32_t)captureData.blobs.size();
+    header.textureCount = (uint32_t)captureData.textures.size();
+    header.bufferCount = (uint32_t)captureData.buffers.size();
+    header.vertexArrayCount = (uint32_t)captureData.vertexArrays.size();
+    header.programCount = (uint32_t)captureData.programs.size();
+    header.frameBufferCount = (uint32_t)captureData.frameBuffers.size();
+    file.write(header.fileSignature, sizeof(header.fileSignature));
+    file.write((char*)&header.version, sizeof(header.version));
+    file.write((char*)&header.width, sizeof(header.width));
+    file.write((char*)&header.height, sizeof(header.height));
+    file.write((char*)&header.callCount, sizeof(header.callCount));
+    file.write((char*)&header.blobCount, sizeof(header.blobCount));
+    file.write((char*)&header.textureCount, sizeof(header.textureCount));
+    file.write((char*)&header.bufferCount, sizeof(header.bufferCount));
+    file.write((char*)&header.vertexArrayCount, sizeof(header.vertexArrayCount));
+    file.write((char*)&header.programCount, sizeof(header.programCount));
+    file.write((char*)&header.frameBufferCount, sizeof(header.frameBufferCount));
+
+    file.write(reinterpret_cast<const char*>(captureData.calls.data()), captureData.calls.size() * sizeof(GLCapturedCall));
+    for (const std::vector<uint8_t>& blob : captureData.blobs) {
+        WriteBytes(file, blob);
+    }
+    for (const GLCapturedTexture& texture : captureData.textures) {
+        file.write((char*)&texture.name, sizeof(texture.name));
+        file.write((char*)&texture.internalFormat, sizeof(texture.internalFormat));
+        file.write((char*)&texture.width, sizeof(texture.width));
+        file.write((char*)&texture.height, sizeof(texture.height));
+        file.write((char*)&texture.compressed, sizeof(texture.compressed));
+        file.write((char*)&texture.minFilter, sizeof(texture.minFilter));
+        file.write((char*)&texture.magFilter, sizeof(texture.magFilter));
+        file.write((char*)&texture.wrapS, sizeof(texture.wrapS));
+        file.write((char*)&texture.wrapT, sizeof(texture.wrapT));
+        uint32_t levelCount = (uint32_t)texture.levels.size();
+        file.write((char*)&levelCount, sizeof(levelCount));
+        for (const std::vector<uint8_t>& level : texture.levels) {
+            WriteBytes(file, level);
+        }
+    }
+    for (const GLCapturedBuffer& buffer : captureData.buffers) {
+        file.write((char*)&buffer.name, sizeof(buffer.name));
+        file.write((char*)&buffer.size, sizeof(buffer.size));
+        WriteBytes(file, buffer.data);
+    }
+    file.write(reinterpret_cast<const char*>(captureData.vertexArrays.data()), captureData.vertexArrays.size() * sizeof(GLCapturedVertexArray));
+    for (const GLCapturedProgram& program : captureData.programs) {
+        file.write((char*)&program.name, sizeof(program.name));
+        uint32_t shaderCount = (uint32_t)program.shaders.size();
+        uint32_t uniformCount = (uint32_t)program.uniforms.size();
+        file.write((char*)&shaderCount, sizeof(shaderCount));
+        file.write((char*)&uniformCount, sizeof(uniformCount));
+        for (const GLCapturedShader& shader : program.shaders) {
+            file.write((char*)&shader.type, sizeof(shader.type));
+            WriteString(file, shader.source);
+        }
+        for (const GLCapturedUniform& uniform : program.uniforms) {
+            WriteString(file, uniform.name);
+            file.write((char*)&uniform.location, sizeof(uniform.location));
+            file.write((char*)&uniform.type, sizeof(uniform.type));
+            WriteBytes(file, uniform.value);
+        }
+    }
+    file.write(reinterpret_cast<const char*>(captureData.frameBuffers.data()), captureData.frameBuffers.size() * sizeof(GLCapturedFrameBuffer));
+    file.close();
+    std::cout << "Exported: " << filepath << "\n";
+}
+
+bool File::ImportGLCapture(const std::string& filepath, GLCaptureData& captureData) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for reading: " << filepath << "\n";
+        return false;
+    }
+    GLCaptureHeader header;
+    char signature[sizeof(header.fileSignature)];
+    file.read(signature, sizeof(signature));
+    if (std::memcmp(signature, header.fileSignature, sizeof(signature)) != 0) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is not a GL capture\n";
+        return false;
+    }
+    file.read((char*)&header.version, sizeof(header.version));
+    file.read((char*)&header.width, sizeof(header.width));
+    file.read((char*)&header.height, sizeof(header.height));
+    file.read((char*)&header.callCount, sizeof(header.callCount));
+    file.read((char*)&header.blobCount, sizeof(header.blobCount));
+    file.read((char*)&header.textureCount, sizeof(header.textureCount));
+    file.read((char*)&header.bufferCount, sizeof(header.bufferCount));
+    file.read((char*)&header.vertexArrayCount, sizeof(header.vertexArrayCount));
+    file.read((char*)&header.programCount, sizeof(header.programCount));
+    file.read((char*)&header.frameBufferCount, sizeof(header.frameBufferCount));
+    if (!file || header.version != 1) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' has an unsupported version\n";
+        return false;
+    }
+    std::streampos dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = (uint64_t)file.tellg();
+    file.seekg(dataStart);
+    captureData.name = Util::GetFileName(filepath);
+    captureData.width = header.width;
+    captureData.height = header.height;
+
+    // Variable sized entries are checked against their smallest encoding: the fixed fields plus empty counts and sizes
+    if (!FitsInFile(file, fileSize, header.callCount, sizeof(GLCapturedCall))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.calls.resize(header.callCount);
+    file.read(reinterpret_cast<char*>(captureData.calls.data()), header.callCount * sizeof(GLCapturedCall));
+    if (!FitsInFile(file, fileSize, header.blobCount, sizeof(uint64_t))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.blobs.resize(header.blobCount);
+    for (std::vector<uint8_t>& blob : captureData.blobs) {
+        if (!ReadBytes(file, fileSize, blob)) {
+            std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+            return false;
+        }
+    }
+    if (!FitsInFile(file, fileSize, header.textureCount, 10 * sizeof(uint32_t))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.textures.resize(header.textureCount);
+    for (GLCapturedTexture& texture : captureData.textures) {
+        file.read((char*)&texture.name, sizeof(texture.name));
+        file.read((char*)&texture.internalFormat, sizeof(texture.internalFormat));
+        file.read((char*)&texture.width, sizeof(texture.width));
+        file.read((char*)&texture.height, sizeof(texture.height));
+        file.read((char*)&texture.compressed, sizeof(texture.compressed));
+        file.read((char*)&texture.minFilter, sizeof(texture.minFilter));
+        file.read((char*)&texture.magFilter, sizeof(texture.magFilter));
+        file.read((char*)&texture.wrapS, sizeof(texture.wrapS));
+        file.read((char*)&texture.wrapT, sizeof(texture.wrapT));
+        uint32_t levelCount = 0;
+        file.read((char*)&levelCount, sizeof(levelCount));
+        if (!FitsInFile(file, fileSize, levelCount, sizeof(uint64_t))) {
+            std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+            return false;
+        }
+        texture.levels.resize(levelCount);
+        for (std::vector<uint8_t>& level : texture.levels) {
+            if (!ReadBytes(file, fileSize, level)) {
+                std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+                return false;
+            }
+        }
+    }
+    if (!FitsInFile(file, fileSize, header.bufferCount, sizeof(uint32_t) + 2 * sizeof(uint64_t))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.buffers.resize(header.bufferCount);
+    for (GLCapturedBuffer& buffer : captureData.buffers) {
+        file.read((char*)&buffer.name, sizeof(buffer.name));
+        file.read((char*)&buffer.size, sizeof(buffer.size));
+        if (!ReadBytes(file, fileSize, buffer.data)) {
+            std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+            return false;
+        }
+    }
+    if (!FitsInFile(file, fileSize, header.vertexArrayCount, sizeof(GLCapturedVertexArray))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.vertexArrays.resize(header.vertexArrayCount);
+    file.read(reinterpret_cast<char*>(captureData.vertexArrays.data()), header.vertexArrayCount * sizeof(GLCapturedVertexArray));
+    if (!FitsInFile(file, fileSize, header.programCount, 3 * sizeof(uint32_t))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.programs.resize(header.programCount);
+    for (GLCapturedProgram& program : captureData.programs) {
+        file.read((char*)&program.name, sizeof(program.name));
+        uint32_t shaderCount = 0;
+        uint32_t uniformCount = 0;
+        file.read((char*)&shaderCount, sizeof(shaderCount));
+        file.read((char*)&uniformCount, sizeof(uniformCount));
+        if (!FitsInFile(file, fileSize, (uint64_t)shaderCount + uniformCount, 2 * sizeof(uint32_t))) {
+            std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+            return false;
+        }
+        program.shaders.resize(shaderCount);
+        program.uniforms.resize(uniformCount);
+        for (GLCapturedShader& shader : program.shaders) {
+            file.read((char*)&shader.type, sizeof(shader.type));
+            if (!ReadString(file, fileSize, shader.source)) {
+                std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+                return false;
+            }
+        }
+        for (GLCapturedUniform& uniform : program.uniforms) {
+            bool read = ReadString(file, fileSize, uniform.name);
+            file.read((char*)&uniform.location, sizeof(uniform.location));
+            file.read((char*)&uniform.type, sizeof(uniform.type));
+            if (!read || !ReadBytes(file, fileSize, uniform.value)) {
+                std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+                return false;
+            }
+        }
+    }
+    if (!FitsInFile(file, fileSize, header.frameBufferCount, sizeof(GLCapturedFrameBuffer))) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    captureData.frameBuffers.resize(header.frameBufferCount);
+    file.read(reinterpret_cast<char*>(captureData.frameBuffers.data()), header.frameBufferCount * sizeof(GLCapturedFrameBuffer));
+    if (!file) {
+        std::cerr << "File::ImportGLCapture() failed: '" << filepath << "' is truncated\n";
+        return false;
+    }
+    file.close();
+    return true;
+}
+
 /*
  ▀█▀   █ █▀█
   █  ▄▀  █ █
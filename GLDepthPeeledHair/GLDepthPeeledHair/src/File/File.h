@@ -7,6 +7,16 @@ namespace File {
     void ExportModel(const ModelData& modelData);
     ModelData ImportModel(const std::string& filepath);
     ModelHeader ReadModelHeader(const std::string& filepath);
+    bool MapModel(const std::string& filepath, MappedModel& mappedModel);
+    void UnmapModel(MappedModel& mappedModel);
+
+    // Camera paths
+    void ExportCameraPath(const std::string& filepath, const CameraPathData& cameraPathData);
+    bool ImportCameraPath(const std::string& filepath, CameraPathData& cameraPathData);
+
+    // GL captures
+    void ExportGLCapture(const std::string& filepath, const GLCaptureData& captureData);
+    bool ImportGLCapture(const std::string& filepath, GLCaptureData& captureData);
     
     // I/O
     void DeleteFile(const std::string& filePath);
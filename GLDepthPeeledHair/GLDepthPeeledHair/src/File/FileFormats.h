@@ -1,9 +1,18 @@
 #pragma once
+#include <string_view>
 #include "Types.h"
+#include "MappedFile.h"
+
+// 1: raw Vertex array per mesh, 2: CompactVertex array per mesh, 3: same layout as 2 with MeshTools optimized index and vertex order,
+// 4: each mesh is followed by its LOD count and per LOD index count, error, alpha scale and indices,
+// 5: then by its cluster count and raw MeshCluster array, hair meshes only,
+// 6: ModelFileHeader and a MeshTocEntry table up front, every section 16 byte aligned so the file is used in place once mapped
+constexpr uint32_t MODEL_FILE_VERSION = 6;
+constexpr uint32_t MODEL_FILE_ALIGNMENT = 16;
 
 struct ModelHeader {
     char fileSignature[11] = "HELL_MODEL";
-    uint32_t version;
+    uint32_t version = 0;
     uint32_t meshCount;
     uint32_t nameLength; 
     uint64_t timestamp;
@@ -19,10 +28,79 @@ struct MeshHeader {
     glm::vec3 aabbMax;
 };
 
+// Version 6 and up. Version stays the first field so ReadModelHeader() can tell the layouts apart, offsets are from the start of the file
+struct ModelFileHeader {
+    uint32_t version = MODEL_FILE_VERSION;
+    uint32_t meshCount = 0;
+    uint32_t nameLength = 0;
+    uint32_t nameOffset = 0;
+    uint64_t timestamp = 0;
+    uint64_t tocOffset = 0;         // meshCount MeshTocEntry
+    glm::vec3 aabbMin = glm::vec3(0.0f);
+    float padding0 = 0.0f;
+    glm::vec3 aabbMax = glm::vec3(0.0f);
+    float padding1 = 0.0f;
+};
+
+struct MeshTocEntry {
+    uint64_t vertexOffset = 0;      // vertexCount CompactVertex
+    uint64_t indexOffset = 0;       // Every LOD back to back, indexSize bytes each
+    uint64_t lodOffset = 0;         // lodCount MeshLod, LOD 0 first
+    uint64_t clusterOffset = 0;     // clusterCount MeshCluster
+    uint32_t nameOffset = 0;
+    uint32_t nameLength = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;        // Summed over every LOD
+    uint32_t indexSize = 4;         // 2 when every vertex fits in 16 bits
+    uint32_t lodCount = 0;
+    uint32_t clusterCount = 0;
+    uint32_t padding = 0;
+    glm::vec3 aabbMin = glm::vec3(0.0f);
+    float padding0 = 0.0f;
+    glm::vec3 aabbMax = glm::vec3(0.0f);
+    float padding1 = 0.0f;
+};
+
+static_assert(sizeof(ModelFileHeader) % MODEL_FILE_ALIGNMENT == 0, "ModelFileHeader must keep the sections after it aligned");
+static_assert(sizeof(MeshTocEntry) % MODEL_FILE_ALIGNMENT == 0, "MeshTocEntry must keep the sections after it aligned");
+
+// Pointers into a mapped version 6 file, valid until File::UnmapModel()
+struct MappedMeshView {
+    std::string_view name;
+    const CompactVertex* vertices = nullptr;
+    const void* indices = nullptr;
+    const MeshLod* lods = nullptr;
+    const MeshCluster* clusters = nullptr;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t indexSize = 4;
+    uint32_t lodCount = 0;
+    uint32_t clusterCount = 0;
+    glm::vec3 aabbMin = glm::vec3(0.0f);
+    glm::vec3 aabbMax = glm::vec3(0.0f);
+};
+
+struct MappedModel {
+    std::string name;
+    uint64_t timestamp = 0;
+    glm::vec3 aabbMin = glm::vec3(0.0f);
+    glm::vec3 aabbMax = glm::vec3(0.0f);
+    std::vector<MappedMeshView> meshes;
+    MappedFile file;
+};
+
+struct MeshLodData {
+    std::vector<uint32_t> indices;  // Into the full mesh's vertices
+    float error = 0.0f;             // Mesh space distance the surface can move by
+    float alphaScale = 1.0f;        // Hair card LODs raise opacity to keep the same coverage
+};
+
 struct MeshData {
     std::string name;
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+    std::vector<MeshLodData> lods;  // Excludes the full mesh, coarsest last
+    std::vector<MeshCluster> clusters;
     int vertexCount;
     int indexCount;
     glm::vec3 aabbMin = glm::vec3(std::numeric_limits<float>::max());
@@ -36,4 +114,127 @@ struct ModelData {
     std::vector<MeshData> meshes;
     glm::vec3 aabbMin = glm::vec3(std::numeric_limits<float>::max());
     glm::vec3 aabbMax = glm::vec3(-std::numeric_limits<float>::max());
-};
\ No newline at end of file
+};
+
+struct CameraPathHeader {
+    char fileSignature[13] = "HELL_CAMPATH";
+    uint32_t version;
+    uint32_t frameCount;
+    float deltaTime;
+};
+
+struct CameraPathFrame {
+    glm::vec3 position = glm::vec3(0);
+    glm::vec3 rotation = glm::vec3(0);
+};
+
+struct CameraPathData {
+    std::string name;
+    float deltaTime = 1.0f / 60.0f;
+    std::vector<CameraPathFrame> frames;
+};
+
+struct GLCaptureHeader {
+    char fileSignature[15] = "HELL_GLCAPTURE";
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t callCount;
+    uint32_t blobCount;
+    uint32_t textureCount;
+    uint32_t bufferCount;
+    uint32_t vertexArrayCount;
+    uint32_t programCount;
+    uint32_t frameBufferCount;
+};
+
+struct GLCapturedCall {
+    uint32_t opcode = 0;
+    uint32_t argCount = 0;
+    uint64_t args[12] = {};
+    int32_t blobIndex = -1;
+};
+
+struct GLCapturedTexture {
+    uint32_t name = 0;
+    uint32_t internalFormat = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t compressed = 0;
+    uint32_t minFilter = 0;
+    uint32_t magFilter = 0;
+    uint32_t wrapS = 0;
+    uint32_t wrapT = 0;
+    std::vector<std::vector<uint8_t>> levels;
+};
+
+struct GLCapturedBuffer {
+    uint32_t name = 0;
+    uint64_t size = 0;
+    std::vector<uint8_t> data;
+};
+
+struct GLCapturedVertexAttribute {
+    uint32_t enabled = 0;
+    uint32_t size = 0;
+    uint32_t type = 0;
+    uint32_t normalized = 0;
+    uint32_t integer = 0;
+    uint32_t relativeOffset = 0;
+    uint32_t bindingIndex = 0;
+};
+
+struct GLCapturedVertexBinding {
+    uint32_t buffer = 0;
+    uint32_t stride = 0;
+    uint32_t divisor = 0;
+    uint64_t offset = 0;
+};
+
+struct GLCapturedVertexArray {
+    uint32_t name = 0;
+    uint32_t elementBuffer = 0;
+    GLCapturedVertexAttribute attributes[16];
+    GLCapturedVertexBinding bindings[16];
+};
+
+struct GLCapturedShader {
+    uint32_t type = 0;
+    std::string source;
+};
+
+struct GLCapturedUniform {
+    std::string name;
+    int32_t location = -1;
+    uint32_t type = 0;
+    std::vector<uint8_t> value;
+};
+
+struct GLCapturedProgram {
+    uint32_t name = 0;
+    std::vector<GLCapturedShader> shaders;
+    std::vector<GLCapturedUniform> uniforms;
+};
+
+struct GLCapturedFrameBuffer {
+    uint32_t name = 0;
+    uint32_t colorAttachments[8] = {};
+    uint32_t colorAttachmentLevels[8] = {};
+    uint32_t depthAttachment = 0;
+    uint32_t stencilAttachment = 0;
+    uint32_t drawBuffers[8] = {};
+    uint32_t readBuffer = 0;
+};
+
+struct GLCaptureData {
+    std::string name;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<GLCapturedCall> calls;
+    std::vector<std::vector<uint8_t>> blobs;
+    std::vector<GLCapturedTexture> textures;
+    std::vector<GLCapturedBuffer> buffers;
+    std::vector<GLCapturedVertexArray> vertexArrays;
+    std::vector<GLCapturedProgram> programs;
+    std::vector<GLCapturedFrameBuffer> frameBuffers;
+};
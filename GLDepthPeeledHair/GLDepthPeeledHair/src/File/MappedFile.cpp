@@ -0,0 +1,112 @@
+#include "MappedFile.h"
+#include <iostream>
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_fileHandle, other.m_fileHandle);
+        std::swap(m_mappingHandle, other.m_mappingHandle);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& filepath) {
+    Close();
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' could not be opened\n";
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' is empty\n";
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' could not be mapped, error " << GetLastError() << "\n";
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = (uint64_t)size.QuadPart;
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        CloseHandle((HANDLE)m_mappingHandle);
+        CloseHandle((HANDLE)m_fileHandle);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+#else
+bool MappedFile::Open(const std::string& filepath) {
+    Close();
+    int file = open(filepath.c_str(), O_RDONLY);
+    if (file == -1) {
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' could not be opened\n";
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(file);
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' is empty\n";
+        return false;
+    }
+    void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    close(file);
+    if (data == MAP_FAILED) {
+        std::cout << "MappedFile::Open() failed because '" << filepath << "' could not be mapped\n";
+        return false;
+    }
+    madvise(data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = (uint64_t)fileStat.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        munmap((void*)m_data, (size_t)m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Read only view of a whole file through the OS page cache, nothing is copied until the pages are touched
+struct MappedFile {
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    bool Open(const std::string& filepath);
+    void Close();
+
+    bool IsOpen() const {
+        return m_data != nullptr;
+    }
+    const uint8_t* GetData() const {
+        return m_data;
+    }
+    uint64_t GetSize() const {
+        return m_size;
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    uint64_t m_size = 0;
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+};
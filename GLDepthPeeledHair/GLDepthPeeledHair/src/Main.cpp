@@ -1,9 +1,22 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
 #include "AssetManagement/AssetManager.h"
+#include "AssetManagement/BakeQueue.h"
 #include "API/OpenGL/GL_backend.h"
 #include "API/OpenGL/GL_renderer.h"
+#include "API/OpenGL/GL_capture.h"
+#include "API/OpenGL/GL_stats.h"
 #include "Core/Audio.h"
+#include "Core/CameraPath.h"
+#include "Core/JobSystem.h"
+#include "Core/FrameStats.h"
 #include "Core/Scene.hpp"
 #include "Core/Camera.h"
 #include "Input/Input.h"
@@ -12,34 +25,203 @@
 #include "Tools/ImageTools.h"
 #include "Types.h"
 
-void Init(int width, int height, std::string title) {
-    OpenGLBackend::Init(width, height, title);
+struct LaunchOptions {
+    bool headless = false;
+    int width = 1920;
+    int height = 1080;
+    int frameCount = 300;
+    int warmupFrameCount = 30;
+    std::string statsOutputPath = "";
+    std::string benchmarkPath = "";
+    std::string hairComparisonPath = "";
+    int comparisonSampleCount = 16;
+    bool glStats = false;
+    std::string capturePath = "";
+    std::string replayCapturePath = "";
+    bool indirectDrawing = true;
+    int mermaidCount = 1;
+    bool keepMeshData = false;
+    bool pinWorkers = false;
+    int jobStressCount = 0;
+    int textureStagingMB = 128;
+    int uploadBudgetMB = 16;
+    double uploadBudgetMs = 2.0;
+};
+
+void PrintUsage() {
+    std::cout << "Usage: GLDepthPeeledHair [options]\n"
+        << "  --headless                  Render into an invisible window\n"
+        << "  --frames <n>                Frames to time\n"
+        << "  --warmup <n>                Frames to skip before timing\n"
+        << "  --width <n>, --height <n>   Render resolution\n"
+        << "  --stats <path>              Write per-frame timings as CSV\n"
+        << "  --benchmark <path>          Replay a recorded camera path\n"
+        << "  --compare-hair <path>       Compare hair peel variants and write a report\n"
+        << "  --compare-samples <n>       Camera samples for --compare-hair\n"
+        << "  --gl-stats                  Count GL calls per frame\n"
+        << "  --capture <path>            Capture one frame of GL calls\n"
+        << "  --replay-capture <path>     Replay a GL capture\n"
+        << "  --no-indirect               Draw without multi-draw indirect\n"
+        << "  --mermaids <n>              Mermaid instances in the scene\n"
+        << "  --keep-mesh-data            Keep CPU copies of uploaded meshes\n"
+        << "  --pin-workers               Pin job system workers to cores\n"
+        << "  --job-stress [n]            Run the job system stress test and exit\n"
+        << "  --staging-mb <n>            Texture staging ring size\n"
+        << "  --upload-budget-mb <n>      Texture upload bytes per frame\n"
+        << "  --upload-budget-ms <ms>     Texture upload time per frame\n";
+}
+
+// Every value is checked before it is used, so a typo in a CI script prints usage instead of throwing out of main
+bool ReadArgument(int argc, char* argv[], int& i, std::string& value) {
+    if (i + 1 >= argc) {
+        std::cout << "Missing value for argument: " << argv[i] << "\n";
+        return false;
+    }
+    i++;
+    value = argv[i];
+    return true;
+}
+
+template <typename T>
+bool ReadArgument(int argc, char* argv[], int& i, T& value) {
+    std::string text;
+    if (!ReadArgument(argc, argv, i, text)) {
+        return false;
+    }
+    T parsed = T();
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        std::cout << "Invalid value '" << text << "' for argument: " << argv[i - 1] << "\n";
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool ParseLaunchOptions(int argc, char* argv[], LaunchOptions& options) {
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            options.headless = true;
+        }
+        else if (arg == "--frames") {
+            valid = ReadArgument(argc, argv, i, options.frameCount);
+            options.frameCount = std::max(1, options.frameCount);
+        }
+        else if (arg == "--warmup") {
+            valid = ReadArgument(argc, argv, i, options.warmupFrameCount);
+            options.warmupFrameCount = std::max(0, options.warmupFrameCount);
+        }
+        else if (arg == "--width") {
+            valid = ReadArgument(argc, argv, i, options.width);
+            options.width = std::max(1, options.width);
+        }
+        else if (arg == "--height") {
+            valid = ReadArgument(argc, argv, i, options.height);
+            options.height = std::max(1, options.height);
+        }
+        else if (arg == "--stats") {
+            valid = ReadArgument(argc, argv, i, options.statsOutputPath);
+        }
+        else if (arg == "--benchmark") {
+            valid = ReadArgument(argc, argv, i, options.benchmarkPath);
+        }
+        else if (arg == "--gl-stats") {
+            options.glStats = true;
+        }
+        else if (arg == "--compare-hair") {
+            valid = ReadArgument(argc, argv, i, options.hairComparisonPath);
+        }
+        else if (arg == "--compare-samples") {
+            valid = ReadArgument(argc, argv, i, options.comparisonSampleCount);
+            options.comparisonSampleCount = std::max(1, options.comparisonSampleCount);
+        }
+        else if (arg == "--no-indirect") {
+            options.indirectDrawing = false;
+        }
+        else if (arg == "--mermaids") {
+            valid = ReadArgument(argc, argv, i, options.mermaidCount);
+            options.mermaidCount = std::max(1, options.mermaidCount);
+        }
+        else if (arg == "--keep-mesh-data") {
+            options.keepMeshData = true;
+        }
+        else if (arg == "--pin-workers") {
+            options.pinWorkers = true;
+        }
+        else if (arg == "--job-stress") {
+            options.jobStressCount = 1000;
+            if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0])) {
+                valid = ReadArgument(argc, argv, i, options.jobStressCount);
+                options.jobStressCount = std::max(1, options.jobStressCount);
+            }
+        }
+        else if (arg == "--staging-mb") {
+            valid = ReadArgument(argc, argv, i, options.textureStagingMB);
+            options.textureStagingMB = std::max(1, options.textureStagingMB);
+        }
+        else if (arg == "--upload-budget-mb") {
+            valid = ReadArgument(argc, argv, i, options.uploadBudgetMB);
+            options.uploadBudgetMB = std::max(1, options.uploadBudgetMB);
+        }
+        else if (arg == "--upload-budget-ms") {
+            valid = ReadArgument(argc, argv, i, options.uploadBudgetMs);
+            options.uploadBudgetMs = std::max(0.0, options.uploadBudgetMs);
+        }
+        else if (arg == "--capture") {
+            valid = ReadArgument(argc, argv, i, options.capturePath);
+        }
+        else if (arg == "--replay-capture") {
+            valid = ReadArgument(argc, argv, i, options.replayCapturePath);
+        }
+        else {
+            std::cout << "Unknown argument: " << arg << "\n";
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool Init(int width, int height, std::string title, bool headless) {
+    bool contextCreated = headless ? OpenGLBackend::InitHeadless(width, height) : OpenGLBackend::Init(width, height, title);
+    if (!contextCreated) {
+        return false;
+    }
     AssetManager::Init();
     TextBlitter::Init();
-    Audio::Init();
+    if (!headless) {
+        Audio::Init();
+    }
     Scene::Init();
-    Input::Init(OpenGLBackend::GetWindowPtr());
+    if (!headless) {
+        Input::Init(OpenGLBackend::GetWindowPtr());
+    }
     Camera::Init(OpenGLBackend::GetWindowPtr());
+    CameraPath::Init();
     Scene::CreateGameObjects();
     OpenGLRenderer::Init();
+    return true;
 }
 
-void Update() {
-    static float deltaTime = 0;
-    static double lastTime = glfwGetTime();
-    double currentTime = glfwGetTime();
-    deltaTime = static_cast<float>(currentTime - lastTime);
-    lastTime = currentTime;
+void Update(float deltaTime) {
     OpenGLBackend::UpdateTextureBaking();
     Scene::SetMaterials();
     AssetManager::Update();
     TextBlitter::Update();
-    Input::Update();
-    Camera::Update(deltaTime);
-    Audio::Update();
+    // Headless runs have no visible window, so no input, mouselook or audio device
+    if (!OpenGLBackend::IsHeadless()) {
+        Input::Update();
+        Audio::Update();
+    }
+    // A replaying camera path owns the camera, live mouselook would make runs incomparable
+    if (!OpenGLBackend::IsHeadless() && !CameraPath::IsReplaying()) {
+        Camera::Update(deltaTime);
+    }
+    CameraPath::Update(deltaTime);
     Scene::Update(deltaTime);
     if (Input::KeyPressed(HELL_KEY_ESCAPE)) {
-        glfwSetWindowShouldClose(OpenGLBackend::GetWindowPtr(), true);
+        OpenGLBackend::ForceCloseWindow();
     }
     if (Input::KeyPressed(HELL_KEY_F)) {
         OpenGLBackend::ToggleFullscreen();
@@ -47,18 +229,439 @@ void Update() {
     if (Input::KeyPressed(HELL_KEY_H)) {
         OpenGLRenderer::LoadShaders();
     }
+    if (Input::KeyPressed(HELL_KEY_F3)) {
+        OpenGLStats::ToggleInstalled();
+    }
+    if (Input::KeyPressed(HELL_KEY_F9)) {
+        CameraPath::ToggleRecording();
+    }
+    if (Input::KeyPressed(HELL_KEY_I)) {
+        OpenGLRenderer::SetIndirectDrawingEnabled(!OpenGLRenderer::IsIndirectDrawingEnabled());
+        std::cout << "Indirect drawing: " << (OpenGLRenderer::IsIndirectDrawingEnabled() ? "on" : "off") << "\n";
+    }
+    if (Input::KeyPressed(HELL_KEY_G)) {
+        OpenGLRenderer::SetGPUCullingEnabled(!OpenGLRenderer::IsGPUCullingEnabled());
+        std::cout << "GPU culling: " << (OpenGLRenderer::IsGPUCullingEnabled() ? "on" : "off") << "\n";
+    }
+    if (Input::KeyPressed(HELL_KEY_O)) {
+        OpenGLRenderer::SetHiZCullingEnabled(!OpenGLRenderer::IsHiZCullingEnabled());
+        std::cout << "Hi-Z occlusion culling: " << (OpenGLRenderer::IsHiZCullingEnabled() ? "on" : "off") << "\n";
+    }
+    if (Input::KeyPressed(HELL_KEY_F10)) {
+        OpenGLCapture::RequestCapture("");
+    }
 }
 
 void Render() {
     OpenGLRenderer::RenderFrame();
 }
 
-int main() {
-    Init(1920, 1080, "GL Depth Peeling");
+// Printed once when the first frame is submitted and once more when background streaming has caught up
+void ReportStartupTimes(std::chrono::high_resolution_clock::time_point startTime) {
+    static bool firstFrameReported = false;
+    static bool streamingReported = false;
+    if (streamingReported) {
+        return;
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+    bool streaming = AssetManager::ModelsLoading() || AssetManager::TexturesLoading() || BakeQueue::GetQueuedTextureBakeJobCount() > 0;
+    if (!firstFrameReported) {
+        std::cout << "Time to first frame: " << std::format("{:.1f}", elapsedMs) << "ms" << (streaming ? ", assets still streaming" : "") << "\n";
+        firstFrameReported = true;
+    }
+    if (!streaming) {
+        std::cout << "All assets resident after: " << std::format("{:.1f}", elapsedMs) << "ms\n";
+        std::cout << OpenGLBackend::GetTextureUploadText();
+        streamingReported = true;
+    }
+}
+
+int RunBenchmark(const LaunchOptions& options) {
+    // Make every model and texture resident up front so the measured frames aren't polluted by streaming
+    AssetManager::WaitForModels();
+    AssetManager::WaitForTextures();
+    BakeQueue::ImmediateBakeAllTextures();
+
+    // Fixed timestep keeps runs independent of wall clock and of how slow the software rasterizer is
+    float deltaTime = 1.0f / 60.0f;
+    int frameCount = options.frameCount;
+    std::string label = "Benchmark";
+    std::string statsOutputPath = options.statsOutputPath;
+    bool replaying = options.benchmarkPath.length();
+    if (replaying) {
+        if (!CameraPath::LoadReplay(options.benchmarkPath)) {
+            OpenGLBackend::CleanUp();
+            return 1;
+        }
+        CameraPath::BeginReplay();
+        deltaTime = CameraPath::GetReplayDeltaTime();
+        frameCount = CameraPath::GetReplayFrameCount();
+        label += " '" + CameraPath::GetReplayName() + "'";
+        if (statsOutputPath.empty()) {
+            statsOutputPath = CameraPath::GetReplayName() + "_frame_stats.csv";
+        }
+    }
+    label += " " + std::to_string(options.width) + "x" + std::to_string(options.height);
+    label += OpenGLBackend::IsHeadless() ? " (headless)" : "";
+    label += options.mermaidCount > 1 ? " " + std::to_string(options.mermaidCount) + " mermaids" : "";
+    label += OpenGLRenderer::IsIndirectDrawingEnabled() ? "" : " (no indirect)";
+    label += OpenGLRenderer::IsGPUCullingEnabled() ? "" : " (no GPU culling)";
+    label += OpenGLRenderer::IsHiZCullingEnabled() ? "" : " (no Hi-Z)";
+
+    // Warm up on the first frame of the path
+    for (int i = 0; i < options.warmupFrameCount; i++) {
+        CameraPath::SeekReplay(0);
+        Update(deltaTime);
+        Render();
+    }
+    glFinish();
+
+    // Capture the warmed up first frame, outside of the timed frames since snapshotting resources is slow
+    if (options.capturePath.length()) {
+        OpenGLCapture::RequestCapture(options.capturePath);
+        CameraPath::SeekReplay(0);
+        Update(deltaTime);
+        Render();
+        glFinish();
+    }
+
+    CameraPath::SeekReplay(0);
+    FrameStats::Reset();
+    for (int i = 0; i < frameCount && OpenGLBackend::WindowIsOpen(); i++) {
+        FrameStats::BeginFrame();
+        Update(deltaTime);
+        Render();
+        glFinish();
+        FrameStats::EndFrame();
+    }
+    CameraPath::EndReplay();
+    FrameStats::PrintSummary(label);
+    if (statsOutputPath.length()) {
+        FrameStats::ExportCSV(statsOutputPath);
+    }
+    FrameStats::CleanUp();
+    OpenGLBackend::CleanUp();
+    return 0;
+}
+
+// Replays a captured frame's GL calls with no assets or scene loaded, so driver and GPU cost can be timed in isolation
+int RunCaptureReplay(const LaunchOptions& options) {
+    if (!OpenGLCapture::LoadReplay(options.replayCapturePath)) {
+        OpenGLBackend::CleanUp();
+        return 1;
+    }
+    std::string label = "Capture replay '" + OpenGLCapture::GetReplayName() + "' " + std::to_string(OpenGLCapture::GetReplayCallCount()) + " calls";
+    label += OpenGLBackend::IsHeadless() ? " (headless)" : "";
+    for (int i = 0; i < options.warmupFrameCount; i++) {
+        OpenGLCapture::ReplayFrame();
+        OpenGLBackend::SwapBuffersPollEvents();
+    }
+    glFinish();
+
+    FrameStats::Reset();
+    for (int i = 0; i < options.frameCount && OpenGLBackend::WindowIsOpen(); i++) {
+        FrameStats::BeginFrame();
+        OpenGLCapture::ReplayFrame();
+        OpenGLBackend::SwapBuffersPollEvents();
+        glFinish();
+        FrameStats::EndFrame();
+    }
+    FrameStats::PrintSummary(label);
+    if (options.statsOutputPath.length()) {
+        FrameStats::ExportCSV(options.statsOutputPath);
+    }
+    FrameStats::CleanUp();
+    OpenGLCapture::CleanUpReplay();
+    OpenGLBackend::CleanUp();
+    return 0;
+}
+
+struct HairComparisonConfig {
+    std::string name;
+    HairSettings hairSettings;
+};
+
+struct HairComparisonResult {
+    HairComparisonConfig config;
+    double averageGpuTimeMs = 0;
+    double p95GpuTimeMs = 0;
+    double averageCpuTimeMs = 0;
+    double averagePSNR = 0;
+    double minPSNR = 0;
+    double averageSSIM = 0;
+    double minSSIM = 0;
+};
+
+std::vector<HairComparisonConfig> CreateHairComparisonConfigs() {
+    std::vector<HairComparisonConfig> configs;
+    for (int peelCount = 1; peelCount <= 7; peelCount++) {
+        configs.push_back({ "peel" + std::to_string(peelCount), { peelCount, 1.0f } });
+    }
+    for (float downscaleRatio : { 0.75f, 0.5f }) {
+        for (int peelCount : { 4, 6 }) {
+            std::string name = "peel" + std::to_string(peelCount) + "_scale" + std::to_string((int)(downscaleRatio * 100));
+            configs.push_back({ name, { peelCount, downscaleRatio } });
+        }
+    }
+    return configs;
+}
+
+// Renders every frame of the path under the given settings, timing each one and reading back the main color buffer on the sample frames
+void RenderHairComparisonPass(const HairSettings& hairSettings, const std::vector<int>& sampleFrames, int warmupFrameCount, std::vector<std::vector<uint8_t>>& sampleImages) {
+    float deltaTime = CameraPath::GetReplayDeltaTime();
+    int frameCount = CameraPath::GetReplayFrameCount();
+    OpenGLRenderer::SetHairSettings(hairSettings);
+    CameraPath::BeginReplay();
+    for (int i = 0; i < warmupFrameCount; i++) {
+        CameraPath::SeekReplay(0);
+        Update(deltaTime);
+        Render();
+    }
+    glFinish();
+    CameraPath::SeekReplay(0);
+    FrameStats::Reset();
+    sampleImages.resize(sampleFrames.size());
+    int sampleIndex = 0;
+    for (int i = 0; i < frameCount && OpenGLBackend::WindowIsOpen(); i++) {
+        FrameStats::BeginFrame();
+        Update(deltaTime);
+        Render();
+        glFinish();
+        FrameStats::EndFrame();
+        // Readback happens outside the timed region
+        if (sampleIndex < sampleFrames.size() && sampleFrames[sampleIndex] == i) {
+            OpenGLRenderer::ReadBackMainColor(sampleImages[sampleIndex]);
+            sampleIndex++;
+        }
+    }
+    CameraPath::EndReplay();
+    FrameStats::ResolveOutstandingQueries();
+}
+
+int RunHairComparison(const LaunchOptions& options) {
+    AssetManager::WaitForModels();
+    AssetManager::WaitForTextures();
+    BakeQueue::ImmediateBakeAllTextures();
+    OpenGLRenderer::SetTextOverlaysEnabled(false);
+    if (!CameraPath::LoadReplay(options.hairComparisonPath)) {
+        OpenGLBackend::CleanUp();
+        return 1;
+    }
+    int width = OpenGLRenderer::GetMainFrameBufferWidth();
+    int height = OpenGLRenderer::GetMainFrameBufferHeight();
+    int frameCount = CameraPath::GetReplayFrameCount();
+    int sampleCount = std::min(options.comparisonSampleCount, frameCount);
+    std::vector<int> sampleFrames;
+    for (int i = 0; i < sampleCount; i++) {
+        sampleFrames.push_back(i * frameCount / sampleCount);
+    }
+
+    // Enough layers that adding more no longer changes the image
+    HairSettings referenceSettings;
+    referenceSettings.peelCount = 16;
+    referenceSettings.downscaleRatio = 1.0f;
+    std::vector<std::vector<uint8_t>> referenceImages;
+    std::cout << "Rendering reference (" << referenceSettings.peelCount << " peels)\n";
+    RenderHairComparisonPass(referenceSettings, sampleFrames, options.warmupFrameCount, referenceImages);
+
+    std::vector<HairComparisonResult> results;
+    for (HairComparisonConfig& config : CreateHairComparisonConfigs()) {
+        std::cout << "Rendering " << config.name << "\n";
+        std::vector<std::vector<uint8_t>> sampleImages;
+        RenderHairComparisonPass(config.hairSettings, sampleFrames, options.warmupFrameCount, sampleImages);
+
+        HairComparisonResult& result = results.emplace_back();
+        result.config = config;
+        std::vector<double> gpuTimes;
+        for (FrameRecord& record : FrameStats::GetFrameRecords()) {
+            result.averageCpuTimeMs += record.cpuTimeMs;
+            if (record.gpuTimeMs >= 0) {
+                gpuTimes.push_back(record.gpuTimeMs);
+                result.averageGpuTimeMs += record.gpuTimeMs;
+            }
+        }
+        result.averageCpuTimeMs /= std::max(1, FrameStats::GetRecordedFrameCount());
+        if (gpuTimes.size()) {
+            std::sort(gpuTimes.begin(), gpuTimes.end());
+            result.averageGpuTimeMs /= gpuTimes.size();
+            result.p95GpuTimeMs = gpuTimes[std::min(gpuTimes.size() - 1, (size_t)(0.95 * (gpuTimes.size() - 1) + 0.5))];
+        }
+        result.minPSNR = 100.0;
+        result.minSSIM = 1.0;
+        int comparedCount = 0;
+        for (int i = 0; i < sampleImages.size() && i < referenceImages.size(); i++) {
+            if (sampleImages[i].empty() || referenceImages[i].empty()) {
+                continue;
+            }
+            double psnr = ImageTools::ComputePSNR(sampleImages[i].data(), referenceImages[i].data(), width, height, 4);
+            double ssim = ImageTools::ComputeSSIM(sampleImages[i].data(), referenceImages[i].data(), width, height, 4);
+            result.averagePSNR += psnr;
+            result.averageSSIM += ssim;
+            result.minPSNR = std::min(result.minPSNR, psnr);
+            result.minSSIM = std::min(result.minSSIM, ssim);
+            comparedCount++;
+        }
+        result.averagePSNR /= std::max(1, comparedCount);
+        result.averageSSIM /= std::max(1, comparedCount);
+    }
+
+    std::string label = "Hair comparison '" + CameraPath::GetReplayName() + "' " + std::to_string(width) + "x" + std::to_string(height);
+    label += OpenGLBackend::IsHeadless() ? " (headless)" : "";
+    std::cout << "\n" << label << ", " << sampleCount << " sampled frames vs " << referenceSettings.peelCount << " peel reference\n";
+    std::cout << std::format("{:<16}{:>10}{:>10}{:>10}{:>10}{:>10}{:>10}{:>10}\n", "config", "gpu avg", "gpu p95", "cpu avg", "psnr avg", "psnr min", "ssim avg", "ssim min");
+    for (HairComparisonResult& result : results) {
+        std::cout << std::format("{:<16}{:>10.3f}{:>10.3f}{:>10.3f}{:>10.2f}{:>10.2f}{:>10.4f}{:>10.4f}\n", result.config.name,
+            result.averageGpuTimeMs, result.p95GpuTimeMs, result.averageCpuTimeMs, result.averagePSNR, result.minPSNR, result.averageSSIM, result.minSSIM);
+    }
+    std::cout << "\n";
+
+    std::string outputPath = options.statsOutputPath.length() ? options.statsOutputPath : CameraPath::GetReplayName() + "_hair_comparison.csv";
+    std::ofstream file(outputPath);
+    if (file.is_open()) {
+        file << "config,peel_count,downscale_ratio,gpu_avg_ms,gpu_p95_ms,cpu_avg_ms,psnr_avg,psnr_min,ssim_avg,ssim_min\n";
+        for (HairComparisonResult& result : results) {
+            file << result.config.name << "," << result.config.hairSettings.peelCount << "," << result.config.hairSettings.downscaleRatio << ","
+                << result.averageGpuTimeMs << "," << result.p95GpuTimeMs << "," << result.averageCpuTimeMs << ","
+                << result.averagePSNR << "," << result.minPSNR << "," << result.averageSSIM << "," << result.minSSIM << "\n";
+        }
+        file.close();
+        std::cout << "Exported hair comparison: " << outputPath << "\n";
+    }
+    else {
+        std::cout << "RunHairComparison() failed to open '" << outputPath << "' for writing\n";
+    }
+    FrameStats::CleanUp();
+    OpenGLBackend::CleanUp();
+    return 0;
+}
+
+// Stand in for a texture decode, a procedural RGBA image and its box filtered mip chain. Returns the mip chain size in bytes
+size_t DecodeStressTexture(int seed) {
+    int size = 256 << (seed % 2);
+    std::vector<uint8_t> level(size * size * 4);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            uint32_t hash = ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)seed * 83492791u);
+            hash ^= hash >> 13;
+            hash *= 0x5bd1e995;
+            memcpy(&level[(y * size + x) * 4], &hash, 4);
+        }
+    }
+    size_t totalSize = level.size();
+    while (size > 1) {
+        int mipSize = size / 2;
+        std::vector<uint8_t> mip(mipSize * mipSize * 4);
+        for (int y = 0; y < mipSize; y++) {
+            for (int x = 0; x < mipSize; x++) {
+                for (int c = 0; c < 4; c++) {
+                    int sum = level[((y * 2) * size + x * 2) * 4 + c] + level[((y * 2) * size + x * 2 + 1) * 4 + c] +
+                              level[((y * 2 + 1) * size + x * 2) * 4 + c] + level[((y * 2 + 1) * size + x * 2 + 1) * 4 + c];
+                    mip[(y * mipSize + x) * 4 + c] = (uint8_t)(sum / 4);
+                }
+            }
+        }
+        totalSize += mip.size();
+        level = std::move(mip);
+        size = mipSize;
+    }
+    return totalSize;
+}
+
+// Decode jobs with a queue for bake continuation, timed against the same work on one thread. Needs no window or GL
+int RunJobStress(const LaunchOptions& options) {
+    int jobCount = options.jobStressCount;
+    using Clock = std::chrono::high_resolution_clock;
+
+    Clock::time_point serialStart = Clock::now();
+    size_t serialBytes = 0;
+    for (int i = 0; i < jobCount; i++) {
+        serialBytes += DecodeStressTexture(i);
+    }
+    double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - serialStart).count();
+
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    std::vector<size_t> bakeQueue;
+    JobCounter counter;
+    Clock::time_point jobStart = Clock::now();
+    for (int i = 0; i < jobCount; i++) {
+        auto decodedBytes = std::make_shared<size_t>(0);
+        JobSystem::Submit([i, decodedBytes, &mutex, &threadIds]() {
+            *decodedBytes = DecodeStressTexture(i);
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+        }, [decodedBytes, &mutex, &bakeQueue]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            bakeQueue.push_back(*decodedBytes);
+        }, i % 4 == 0 ? JobPriority::HIGH : JobPriority::NORMAL, JobPriority::NORMAL, &counter);
+    }
+    JobSystem::Wait(counter);
+    double jobMs = std::chrono::duration<double, std::milli>(Clock::now() - jobStart).count();
+
+    size_t jobBytes = 0;
+    for (size_t bytes : bakeQueue) {
+        jobBytes += bytes;
+    }
+    std::cout << "\nJob stress, " << jobCount << " decode jobs with bake continuations\n";
+    std::cout << std::format("{:<12}{:>12}{:>12}\n", "", "wall ms", "jobs/sec");
+    std::cout << std::format("{:<12}{:>12.2f}{:>12.1f}\n", "serial", serialMs, jobCount * 1000.0 / std::max(serialMs, 0.001));
+    std::cout << std::format("{:<12}{:>12.2f}{:>12.1f}\n", "job system", jobMs, jobCount * 1000.0 / std::max(jobMs, 0.001));
+    std::cout << "Speedup: " << std::format("{:.2f}", serialMs / std::max(jobMs, 0.001)) << "x on " << threadIds.size() << " threads\n";
+    std::cout << JobSystem::GetDebugText() << "\n";
+    if (jobBytes != serialBytes || bakeQueue.size() != (size_t)jobCount) {
+        std::cout << "RunJobStress() failed because the job results don't match the serial run\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+    LaunchOptions options;
+    if (!ParseLaunchOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    JobSystem::Init(0, options.pinWorkers);
+    if (options.jobStressCount > 0) {
+        return RunJobStress(options);
+    }
+    OpenGLBackend::SetTextureStagingSize((size_t)options.textureStagingMB * 1024 * 1024);
+    OpenGLBackend::SetTextureUploadBudget((size_t)options.uploadBudgetMB * 1024 * 1024, options.uploadBudgetMs);
+    if (options.replayCapturePath.length()) {
+        bool contextCreated = options.headless ? OpenGLBackend::InitHeadless(options.width, options.height) : OpenGLBackend::Init(options.width, options.height, "GL Capture Replay");
+        if (!contextCreated) {
+            return 1;
+        }
+        if (options.glStats) {
+            OpenGLStats::Install();
+        }
+        return RunCaptureReplay(options);
+    }
+    AssetManager::SetKeepCPUMeshData(options.keepMeshData);
+    if (!Init(options.width, options.height, "GL Depth Peeling", options.headless)) {
+        return 1;
+    }
+    if (options.glStats) {
+        OpenGLStats::Install();
+    }
+    OpenGLRenderer::SetIndirectDrawingEnabled(options.indirectDrawing);
+    Scene::CreateMermaidStressScene(options.mermaidCount);
+    if (options.hairComparisonPath.length()) {
+        return RunHairComparison(options);
+    }
+    if (options.headless || options.benchmarkPath.length() || options.capturePath.length()) {
+        return RunBenchmark(options);
+    }
+    double lastTime = glfwGetTime();
     while (OpenGLBackend::WindowIsOpen()) {
-        Update();
+        double currentTime = glfwGetTime();
+        float deltaTime = static_cast<float>(currentTime - lastTime);
+        lastTime = currentTime;
+        Update(deltaTime);
         Render();
+        ReportStartupTimes(startTime);
     }
-    glfwTerminate();
+    OpenGLBackend::CleanUp();
     return 0;
-}
\ No newline at end of file
+}
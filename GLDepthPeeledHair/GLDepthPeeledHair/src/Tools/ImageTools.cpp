@@ -3,6 +3,8 @@
 #include <memory.h>
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
 #pragma warning(push)
 #pragma warning(disable : 4996)
 #include "stb_image_write.h"
@@ -163,7 +165,7 @@ namespace ImageTools {
         kernelOptions.encodeWith = CMP_HPC; // CMP_CPU // CMP_GPU_OCL
         kernelOptions.format = CMP_FORMAT_BC7;
         kernelOptions.fquality = 0.88;
-        kernelOptions.threads = 0;
+        kernelOptions.threads = 1;  // Called from a job per texture, the job system provides the parallelism
        
         memset(&mipSetOut, 0, sizeof(CMP_MipSet));
         status = CMP_ProcessTexture(&mipSetIn, &mipSetOut, kernelOptions, CompressionCallback);
@@ -233,6 +235,67 @@ namespace ImageTools {
         free(flippedData);
     }
 
+    double ComputePSNR(const unsigned char* dataA, const unsigned char* dataB, int width, int height, int numChannels) {
+        // Alpha is ignored, the main color buffer doesn't carry anything meaningful in it
+        int comparedChannels = std::min(numChannels, 3);
+        double squaredErrorSum = 0.0;
+        for (int i = 0; i < width * height; i++) {
+            for (int c = 0; c < comparedChannels; c++) {
+                double difference = (double)dataA[i * numChannels + c] - (double)dataB[i * numChannels + c];
+                squaredErrorSum += difference * difference;
+            }
+        }
+        double meanSquaredError = squaredErrorSum / ((double)width * height * comparedChannels);
+        if (meanSquaredError <= 0.0) {
+            return 100.0; // Identical, clamp rather than report infinity
+        }
+        return 10.0 * std::log10((255.0 * 255.0) / meanSquaredError);
+    }
+
+    double ComputeSSIM(const unsigned char* dataA, const unsigned char* dataB, int width, int height, int numChannels) {
+        // Luma SSIM over 8x8 windows with a stride of 4, averaged
+        const int windowSize = 8;
+        const int stride = 4;
+        const double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+        const double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+        auto luma = [numChannels](const unsigned char* data, int index) {
+            const unsigned char* pixel = data + index * numChannels;
+            if (numChannels < 3) {
+                return (double)pixel[0];
+            }
+            return 0.299 * pixel[0] + 0.587 * pixel[1] + 0.114 * pixel[2];
+        };
+        double ssimSum = 0.0;
+        int windowCount = 0;
+        for (int y = 0; y + windowSize <= height; y += stride) {
+            for (int x = 0; x + windowSize <= width; x += stride) {
+                double sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+                for (int wy = 0; wy < windowSize; wy++) {
+                    for (int wx = 0; wx < windowSize; wx++) {
+                        int index = (y + wy) * width + (x + wx);
+                        double a = luma(dataA, index);
+                        double b = luma(dataB, index);
+                        sumA += a;
+                        sumB += b;
+                        sumAA += a * a;
+                        sumBB += b * b;
+                        sumAB += a * b;
+                    }
+                }
+                const double n = windowSize * windowSize;
+                double meanA = sumA / n;
+                double meanB = sumB / n;
+                double varianceA = sumAA / n - meanA * meanA;
+                double varianceB = sumBB / n - meanB * meanB;
+                double covariance = sumAB / n - meanA * meanB;
+                ssimSum += ((2.0 * meanA * meanB + c1) * (2.0 * covariance + c2)) /
+                           ((meanA * meanA + meanB * meanB + c1) * (varianceA + varianceB + c2));
+                windowCount++;
+            }
+        }
+        return windowCount ? ssimSum / windowCount : 1.0;
+    }
+
     void CreateFolder(const char* path) {
         std::filesystem::path dir(path);
         if (!std::filesystem::exists(dir)) {
@@ -20,6 +20,10 @@ namespace ImageTools {
     // Util
     void SaveBitmap(const char* filename, unsigned char* data, int width, int height, int numChannels);
 
+    // Comparison
+    double ComputePSNR(const unsigned char* dataA, const unsigned char* dataB, int width, int height, int numChannels);
+    double ComputeSSIM(const unsigned char* dataA, const unsigned char* dataB, int width, int height, int numChannels);
+
     // Debug
     std::string CMPErrorToString(int error);
     std::string CMPFormatToString(int format);
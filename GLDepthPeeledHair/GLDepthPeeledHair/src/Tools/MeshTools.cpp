@@ -0,0 +1,953 @@
+#include "MeshTools.h"
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <unordered_map>
+
+namespace MeshTools {
+
+    constexpr uint32_t CACHE_SIZE = 16;
+    constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+    constexpr int OVERDRAW_GRID_SIZE = 256;
+    constexpr float OVERDRAW_THRESHOLD = 1.05f;
+    constexpr float LOD_TRIANGLE_RATIOS[] = { 0.5f, 0.25f, 0.125f };
+    constexpr float LOD_MAX_RELATIVE_ERROR = 0.05f;     // Of the mesh AABB diagonal
+    constexpr float LOD_MIN_REDUCTION = 0.85f;          // A LOD has to drop at least 15% of the previous triangles
+    constexpr uint32_t HAIR_CARD_MIN_COUNT = 16;
+    constexpr uint32_t HAIR_CARD_MAX_TRIANGLES = 64;    // Average per card
+    constexpr float HAIR_CARD_MAX_ALPHA_SCALE = 4.0f;
+    constexpr uint32_t CLUSTER_MAX_TRIANGLES = 128;
+    constexpr float CLUSTER_MIN_CONE_DOT = 0.1f;        // Wider normal spread than this never backface culls
+
+    // FIFO post transform cache, a vertex is resident while fewer than CACHE_SIZE misses happened since it was inserted
+    struct VertexCache {
+        std::vector<uint32_t> timestamps;
+        uint32_t time = CACHE_SIZE + 1;
+
+        VertexCache(uint32_t vertexCount) : timestamps(vertexCount, 0) {}
+
+        bool Contains(uint32_t vertex) const {
+            return time - timestamps[vertex] <= CACHE_SIZE;
+        }
+        uint32_t Touch(uint32_t vertex) {
+            if (Contains(vertex)) {
+                return 0;
+            }
+            timestamps[vertex] = time++;
+            return 1;
+        }
+        uint32_t TouchTriangle(const uint32_t* triangle) {
+            return Touch(triangle[0]) + Touch(triangle[1]) + Touch(triangle[2]);
+        }
+        void Flush() {
+            time += CACHE_SIZE + 1;
+        }
+    };
+
+    /*
+    █ █ █▀▀ █▀▄ ▀█▀ █▀▀ █ █   █▀▀ █▀█ █▀▀ █ █ █▀▀
+    ▀▄▀ █▀▀ █▀▄  █  █▀▀ ▄▀▄   █   █▀█ █   █▀█ █▀▀
+     ▀  ▀▀▀ ▀ ▀  ▀  ▀▀▀ ▀ ▀   ▀▀▀ ▀ ▀ ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    int64_t SkipDeadEnd(std::vector<uint32_t>& deadEnd, const std::vector<uint32_t>& liveCount, uint32_t& cursor) {
+        while (!deadEnd.empty()) {
+            uint32_t vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveCount[vertex] > 0) {
+                return vertex;
+            }
+        }
+        while (cursor < liveCount.size()) {
+            if (liveCount[cursor] > 0) {
+                return cursor;
+            }
+            cursor++;
+        }
+        return -1;
+    }
+
+    // Tipsify (Sander, Nehab and Barczak 2007). Fans around the vertex that was in the cache the longest without falling out of it,
+    // and every time it has to jump to a dead end a cluster boundary is recorded for OptimizeOverdraw()
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& clusterOffsets) {
+        uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+        std::vector<uint32_t> liveCount(vertexCount, 0);
+        for (uint32_t index : indices) {
+            liveCount[index]++;
+        }
+        // Vertex to triangle adjacency as one flat array
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveCount[i];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fillCursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t i = 0; i < triangleCount * 3; i++) {
+            adjacency[fillCursor[indices[i]]++] = i / 3;
+        }
+
+        VertexCache cache(vertexCount);
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        clusterOffsets.assign(1, 0);
+        uint32_t cursor = 0;
+        int64_t fanningVertex = SkipDeadEnd(deadEnd, liveCount, cursor);
+
+        while (fanningVertex >= 0) {
+            candidates.clear();
+            for (uint32_t a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1]; a++) {
+                uint32_t triangle = adjacency[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                for (int k = 0; k < 3; k++) {
+                    uint32_t vertex = indices[triangle * 3 + k];
+                    result.push_back(vertex);
+                    deadEnd.push_back(vertex);
+                    candidates.push_back(vertex);
+                    liveCount[vertex]--;
+                    cache.Touch(vertex);
+                }
+                emitted[triangle] = 1;
+            }
+            // Prefer the oldest candidate that stays resident while its remaining triangles are fanned
+            int64_t nextVertex = -1;
+            int64_t bestPriority = -1;
+            for (uint32_t vertex : candidates) {
+                if (liveCount[vertex] == 0) {
+                    continue;
+                }
+                int64_t age = cache.time - cache.timestamps[vertex];
+                int64_t priority = (age + 2 * liveCount[vertex] <= CACHE_SIZE) ? age : 0;
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    nextVertex = vertex;
+                }
+            }
+            if (nextVertex < 0) {
+                nextVertex = SkipDeadEnd(deadEnd, liveCount, cursor);
+                uint32_t emittedTriangles = (uint32_t)(result.size() / 3);
+                if (nextVertex >= 0 && emittedTriangles > clusterOffsets.back()) {
+                    clusterOffsets.push_back(emittedTriangles);
+                }
+            }
+            fanningVertex = nextVertex;
+        }
+        return result;
+    }
+
+    /*
+    █▀█ █ █ █▀▀ █▀▄ █▀▄ █▀▄ █▀█ █ █
+    █ █ ▀▄▀ █▀▀ █▀▄ █ █ █▀▄ █▀█ █▄█
+    ▀▀▀  ▀  ▀▀▀ ▀ ▀ ▀▀  ▀ ▀ ▀ ▀ ▀ ▀ */
+
+    // Splits each cluster as soon as its running ACMR drops under threshold times the whole cluster's ACMR,
+    // smaller clusters give the sort more freedom for a bounded loss in cache efficiency
+    std::vector<uint32_t> SplitClusters(const std::vector<uint32_t>& indices, uint32_t vertexCount, const std::vector<uint32_t>& clusterOffsets, float threshold) {
+        uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+        VertexCache cache(vertexCount);
+        std::vector<uint32_t> result;
+        for (size_t c = 0; c < clusterOffsets.size(); c++) {
+            uint32_t start = clusterOffsets[c];
+            uint32_t end = (c + 1 < clusterOffsets.size()) ? clusterOffsets[c + 1] : triangleCount;
+            cache.Flush();
+            uint32_t clusterMisses = 0;
+            for (uint32_t t = start; t < end; t++) {
+                clusterMisses += cache.TouchTriangle(&indices[t * 3]);
+            }
+            float clusterThreshold = threshold * (float)clusterMisses / (float)(end - start);
+
+            result.push_back(start);
+            cache.Flush();
+            uint32_t runningMisses = 0;
+            uint32_t runningTriangles = 0;
+            for (uint32_t t = start; t + 1 < end; t++) {
+                runningMisses += cache.TouchTriangle(&indices[t * 3]);
+                runningTriangles++;
+                if ((float)runningMisses / (float)runningTriangles <= clusterThreshold) {
+                    result.push_back(t + 1);
+                    cache.Flush();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+        }
+        return result;
+    }
+
+    // Sorts whole clusters by how far out they face from the mesh centroid, so from most view directions the outer surfaces
+    // are drawn first and occlude the rest. Order inside a cluster is kept so most of the cache locality survives
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& clusterOffsets, float threshold) {
+        uint32_t triangleCount = (uint32_t)(indices.size() / 3);
+        if (triangleCount == 0) {
+            return;
+        }
+        std::vector<uint32_t> clusters = SplitClusters(indices, (uint32_t)vertices.size(), clusterOffsets, threshold);
+        uint32_t clusterCount = (uint32_t)clusters.size();
+
+        // Area weighted centroids, the unnormalized cross product is the triangle normal scaled by twice its area
+        std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+        std::vector<float> clusterAreas(clusterCount, 0.0f);
+        glm::vec3 meshCentroid = glm::vec3(0.0f);
+        float meshArea = 0.0f;
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            uint32_t end = (c + 1 < clusterCount) ? clusters[c + 1] : triangleCount;
+            for (uint32_t t = clusters[c]; t < end; t++) {
+                const glm::vec3& p0 = vertices[indices[t * 3]].position;
+                const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+                const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float area = glm::length(normal);
+                clusterCentroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormals[c] += normal;
+                clusterAreas[c] += area;
+            }
+            meshCentroid += clusterCentroids[c];
+            meshArea += clusterAreas[c];
+        }
+        meshCentroid = (meshArea > 0.0f) ? meshCentroid / meshArea : meshCentroid;
+
+        std::vector<float> sortKeys(clusterCount, 0.0f);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            float normalLength = glm::length(clusterNormals[c]);
+            if (clusterAreas[c] > 0.0f && normalLength > 0.0f) {
+                glm::vec3 centroid = clusterCentroids[c] / clusterAreas[c];
+                sortKeys[c] = glm::dot(centroid - meshCentroid, clusterNormals[c] / normalLength);
+            }
+        }
+        std::vector<uint32_t> order(clusterCount);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            order[c] = c;
+        }
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+            return sortKeys[a] > sortKeys[b];
+        });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (uint32_t c : order) {
+            uint32_t end = (c + 1 < clusterCount) ? clusters[c + 1] : triangleCount;
+            result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + end * 3);
+        }
+        indices.swap(result);
+    }
+
+    /*
+    █ █ █▀▀ █▀▄ ▀█▀ █▀▀ █ █   █▀▀ █▀▀ ▀█▀ █▀▀ █ █
+    ▀▄▀ █▀▀ █▀▄  █  █▀▀ ▄▀▄   █▀▀ █▀▀  █  █   █▀█
+     ▀  ▀▀▀ ▀ ▀  ▀  ▀▀▀ ▀ ▀   ▀   ▀▀▀  ▀  ▀▀▀ ▀ ▀ */
+
+    // Renumbers vertices in the order the index buffer first uses them, unreferenced vertices are dropped
+    void OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices) {
+        std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+        std::vector<Vertex> result;
+        result.reserve(vertices.size());
+        for (uint32_t& index : indices) {
+            if (remap[index] == INVALID_INDEX) {
+                remap[index] = (uint32_t)result.size();
+                result.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        vertices.swap(result);
+    }
+
+    /*
+    █▀█ █▀█ █▀█ █   █ █ █▀▀ ▀█▀ █▀▀
+    █▀█ █ █ █▀█ █   ▀█▀ ▀▀█  █  ▀▀█
+    ▀ ▀ ▀ ▀ ▀ ▀ ▀▀▀  ▀  ▀▀▀ ▀▀▀ ▀▀▀ */
+
+    VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+        VertexCacheStats stats;
+        VertexCache cache(vertexCount);
+        std::vector<uint8_t> referenced(vertexCount, 0);
+        uint32_t misses = 0;
+        uint32_t uniqueCount = 0;
+        for (uint32_t index : indices) {
+            misses += cache.Touch(index);
+            uniqueCount += referenced[index] ? 0 : 1;
+            referenced[index] = 1;
+        }
+        if (!indices.empty()) {
+            stats.acmr = (float)misses / (float)(indices.size() / 3);
+            stats.atvr = (float)misses / (float)uniqueCount;
+        }
+        return stats;
+    }
+
+    float EdgeFunction(const glm::vec3& a, const glm::vec3& b, float x, float y) {
+        return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+    }
+
+    // Depth tested rasterization into a small grid, returns how many pixels passed the depth test. Back faces are culled like the
+    // lighting pass does, OptimizeOverdraw() only orders the faces that point at the viewer
+    uint64_t RasterizeTriangle(std::vector<float>& depthBuffer, glm::vec3 a, glm::vec3 b, glm::vec3 c) {
+        float area = EdgeFunction(a, b, c.x, c.y);
+        if (area < 1e-6f) {
+            return 0;
+        }
+        int minX = std::max((int)std::floor(std::min({ a.x, b.x, c.x })), 0);
+        int minY = std::max((int)std::floor(std::min({ a.y, b.y, c.y })), 0);
+        int maxX = std::min((int)std::ceil(std::max({ a.x, b.x, c.x })), OVERDRAW_GRID_SIZE - 1);
+        int maxY = std::min((int)std::ceil(std::max({ a.y, b.y, c.y })), OVERDRAW_GRID_SIZE - 1);
+        uint64_t shaded = 0;
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                float w0 = EdgeFunction(b, c, px, py);
+                float w1 = EdgeFunction(c, a, px, py);
+                float w2 = EdgeFunction(a, b, px, py);
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                    continue;
+                }
+                float depth = (w0 * a.z + w1 * b.z + w2 * c.z) / area;
+                float& storedDepth = depthBuffer[y * OVERDRAW_GRID_SIZE + x];
+                if (depth < storedDepth) {
+                    storedDepth = depth;
+                    shaded++;
+                }
+            }
+        }
+        return shaded;
+    }
+
+    // Orthographic views down both directions of each axis, overdraw is shaded pixels over covered pixels summed across all six
+    OverdrawStats AnalyzeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+        OverdrawStats stats;
+        glm::vec3 aabbMin = glm::vec3(FLT_MAX);
+        glm::vec3 aabbMax = glm::vec3(-FLT_MAX);
+        for (uint32_t index : indices) {
+            aabbMin = glm::min(aabbMin, vertices[index].position);
+            aabbMax = glm::max(aabbMax, vertices[index].position);
+        }
+        glm::vec3 size = aabbMax - aabbMin;
+        float extent = std::max({ size.x, size.y, size.z });
+        if (indices.empty() || extent <= 0.0f) {
+            return stats;
+        }
+        float scale = (OVERDRAW_GRID_SIZE - 1) / extent;
+        std::vector<float> depthBuffer(OVERDRAW_GRID_SIZE * OVERDRAW_GRID_SIZE);
+        uint64_t shadedCount = 0;
+        uint64_t coveredCount = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            for (float direction : { 1.0f, -1.0f }) {
+                std::fill(depthBuffer.begin(), depthBuffer.end(), FLT_MAX);
+                for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                    glm::vec3 projected[3];
+                    for (int k = 0; k < 3; k++) {
+                        glm::vec3 p = (vertices[indices[i + k]].position - aabbMin) * scale;
+                        // Mirrored when looking down the positive axis so front faces keep counter clockwise winding on the grid
+                        float u = (direction > 0.0f) ? (OVERDRAW_GRID_SIZE - 1) - p[(axis + 1) % 3] : p[(axis + 1) % 3];
+                        projected[k] = glm::vec3(u, p[(axis + 2) % 3], p[axis] * direction);
+                    }
+                    shadedCount += RasterizeTriangle(depthBuffer, projected[0], projected[1], projected[2]);
+                }
+                for (float depth : depthBuffer) {
+                    coveredCount += (depth < FLT_MAX) ? 1 : 0;
+                }
+            }
+        }
+        stats.overdraw = (coveredCount > 0) ? (float)shadedCount / (float)coveredCount : 0.0f;
+        return stats;
+    }
+
+    /*
+    █▀▀ ▀█▀ █▄ ▄█ █▀█ █   ▀█▀ █▀▀ █ █
+    ▀▀█  █  █ █ █ █▀▀ █    █  █▀▀ ▀█▀
+    ▀▀▀ ▀▀▀ ▀   ▀ ▀   ▀▀▀ ▀▀▀ ▀    ▀  */
+
+    // Symmetric 4x4 plane quadric, weighted by triangle area so Evaluate() / weight is a mean squared distance
+    struct Quadric {
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+        double weight = 0.0;
+
+        void AddPlane(const glm::vec3& n, float d, float w) {
+            a00 += w * n.x * n.x; a11 += w * n.y * n.y; a22 += w * n.z * n.z;
+            a01 += w * n.x * n.y; a02 += w * n.x * n.z; a12 += w * n.y * n.z;
+            b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+            c += w * d * d;
+            weight += w;
+        }
+        void Add(const Quadric& q) {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22; a01 += q.a01; a02 += q.a02; a12 += q.a12;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c;
+            weight += q.weight;
+        }
+        float Evaluate(const glm::vec3& p) const {
+            double x = p.x, y = p.y, z = p.z;
+            double result = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return (weight > 0.0) ? (float)(std::max(result, 0.0) / weight) : 0.0f;
+        }
+    };
+
+    struct Collapse {
+        uint32_t from;
+        uint32_t to;
+        float cost;
+    };
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint64_t x = std::bit_cast<uint32_t>(p.x);
+            uint64_t y = std::bit_cast<uint32_t>(p.y);
+            uint64_t z = std::bit_cast<uint32_t>(p.z);
+            return std::hash<uint64_t>()((x * 73856093) ^ (y * 19349663) ^ (z * 83492791));
+        }
+    };
+
+    // Maps every vertex to the first vertex with the same position, so uv and normal seams don't look like holes
+    std::vector<uint32_t> GetPositionRemap(const std::vector<Vertex>& vertices) {
+        std::vector<uint32_t> remap(vertices.size());
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> firstVertex;
+        for (uint32_t i = 0; i < vertices.size(); i++) {
+            remap[i] = firstVertex.try_emplace(vertices[i].position, i).first->second;
+        }
+        return remap;
+    }
+
+    uint64_t GetEdgeKey(uint32_t a, uint32_t b) {
+        return (a < b) ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    void BuildTriangleAdjacency(const std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& offsets, std::vector<uint32_t>& adjacency) {
+        offsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : indices) {
+            offsets[index + 1]++;
+        }
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        adjacency.resize(indices.size());
+        std::vector<uint32_t> fillCursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t i = 0; i < indices.size(); i++) {
+            adjacency[fillCursor[indices[i]]++] = i / 3;
+        }
+    }
+
+    // Rejects a collapse that would flip or flatten one of the triangles that survive it
+    bool CollapseKeepsOrientation(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency, uint32_t from, uint32_t to) {
+        for (uint32_t a = offsets[from]; a < offsets[from + 1]; a++) {
+            const uint32_t* triangle = &indices[adjacency[a] * 3];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                continue;
+            }
+            glm::vec3 before[3];
+            glm::vec3 after[3];
+            for (int k = 0; k < 3; k++) {
+                before[k] = vertices[triangle[k]].position;
+                after[k] = (triangle[k] == from) ? vertices[to].position : before[k];
+            }
+            glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Garland-Heckbert edge collapse onto existing vertices, so LODs are index lists into the full mesh's vertex buffer.
+    // Vertices on open edges or attribute seams are locked. Each pass collapses the cheapest independent edges until
+    // the target is met, the error limit is hit or nothing can collapse. resultError is the largest error accepted
+    std::vector<uint32_t> SimplifyMesh(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, uint32_t targetIndexCount, float maxError, float& resultError) {
+        resultError = 0.0f;
+        uint32_t vertexCount = (uint32_t)vertices.size();
+        std::vector<uint32_t> positionRemap = GetPositionRemap(vertices);
+
+        std::vector<uint8_t> lockedPositions(vertexCount, 0);
+        std::vector<uint32_t> positionUseCount(vertexCount, 0);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            positionUseCount[positionRemap[i]]++;
+        }
+        std::unordered_map<uint64_t, uint32_t> edgeUseCount;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            for (int k = 0; k < 3; k++) {
+                edgeUseCount[GetEdgeKey(positionRemap[indices[i + k]], positionRemap[indices[i + (k + 1) % 3]])]++;
+            }
+        }
+        for (auto& [edgeKey, useCount] : edgeUseCount) {
+            if (useCount != 2) {
+                lockedPositions[(uint32_t)(edgeKey >> 32)] = 1;
+                lockedPositions[(uint32_t)(edgeKey & 0xFFFFFFFF)] = 1;
+            }
+        }
+        std::vector<uint8_t> locked(vertexCount, 0);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            locked[i] = lockedPositions[positionRemap[i]] || positionUseCount[positionRemap[i]] > 1;
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const glm::vec3& p0 = vertices[indices[i]].position;
+            glm::vec3 normal = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+            float length = glm::length(normal);
+            if (length == 0.0f) {
+                continue;
+            }
+            normal /= length;
+            float distance = -glm::dot(normal, p0);
+            for (int k = 0; k < 3; k++) {
+                quadrics[indices[i + k]].AddPlane(normal, distance, length * 0.5f);
+            }
+        }
+
+        std::vector<uint32_t> result = indices;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint8_t> touched(vertexCount);
+        float maxCost = maxError * maxError;
+
+        while (result.size() > targetIndexCount) {
+            BuildTriangleAdjacency(result, vertexCount, offsets, adjacency);
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; k++) {
+                    uint32_t a = result[i + k];
+                    uint32_t b = result[i + (k + 1) % 3];
+                    if (!locked[a]) {
+                        collapses.push_back({ a, b, quadrics[a].Evaluate(vertices[b].position) });
+                    }
+                    if (!locked[b]) {
+                        collapses.push_back({ b, a, quadrics[b].Evaluate(vertices[a].position) });
+                    }
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                return a.cost < b.cost;
+            });
+
+            for (uint32_t i = 0; i < vertexCount; i++) {
+                remap[i] = i;
+            }
+            std::fill(touched.begin(), touched.end(), 0);
+            size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+            size_t trianglesRemoved = 0;
+            uint32_t collapseCount = 0;
+            for (const Collapse& collapse : collapses) {
+                if (collapse.cost > maxCost || trianglesRemoved >= trianglesToRemove) {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to] || !CollapseKeepsOrientation(result, vertices, offsets, adjacency, collapse.from, collapse.to)) {
+                    continue;
+                }
+                // Freeze the whole neighbourhood for the rest of the pass so collapses never interact
+                for (uint32_t a = offsets[collapse.from]; a < offsets[collapse.from + 1]; a++) {
+                    const uint32_t* triangle = &result[adjacency[a] * 3];
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+                    trianglesRemoved += (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) ? 1 : 0;
+                }
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to].Add(quadrics[collapse.from]);
+                resultError = std::max(resultError, std::sqrt(collapse.cost));
+                collapseCount++;
+            }
+            if (collapseCount == 0) {
+                break;
+            }
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < result.size(); i += 3) {
+                uint32_t a = remap[result[i]];
+                uint32_t b = remap[result[i + 1]];
+                uint32_t c = remap[result[i + 2]];
+                if (a != b && b != c && a != c) {
+                    result[writeIndex++] = a;
+                    result[writeIndex++] = b;
+                    result[writeIndex++] = c;
+                }
+            }
+            result.resize(writeIndex);
+        }
+        return result;
+    }
+
+    /*
+    █ █ █▀█ ▀█▀ █▀▄   █▀▀ █▀█ █▀▄ █▀▄ █▀▀
+    █▀█ █▀█  █  █▀▄   █   █▀█ █▀▄ █ █ ▀▀█
+    ▀ ▀ ▀ ▀ ▀▀▀ ▀ ▀   ▀▀▀ ▀ ▀ ▀ ▀ ▀▀  ▀▀▀ */
+
+    // Union find over shared positions, returns the card each triangle belongs to
+    std::vector<uint32_t> FindCards(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, uint32_t& cardCount) {
+        std::vector<uint32_t> positionRemap = GetPositionRemap(vertices);
+        std::vector<uint32_t> parents(vertices.size());
+        for (uint32_t i = 0; i < parents.size(); i++) {
+            parents[i] = i;
+        }
+        auto find = [&parents](uint32_t i) {
+            while (parents[i] != i) {
+                parents[i] = parents[parents[i]];
+                i = parents[i];
+            }
+            return i;
+        };
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            uint32_t root = find(positionRemap[indices[i]]);
+            parents[find(positionRemap[indices[i + 1]])] = root;
+            parents[find(positionRemap[indices[i + 2]])] = root;
+        }
+        std::vector<uint32_t> cardIds(vertices.size(), INVALID_INDEX);
+        std::vector<uint32_t> triangleCards(indices.size() / 3);
+        cardCount = 0;
+        for (size_t t = 0; t < triangleCards.size(); t++) {
+            uint32_t root = find(positionRemap[indices[t * 3]]);
+            if (cardIds[root] == INVALID_INDEX) {
+                cardIds[root] = cardCount++;
+            }
+            triangleCards[t] = cardIds[root];
+        }
+        return triangleCards;
+    }
+
+    // Lots of small disconnected pieces, collapsing edges would only shrink each card so whole cards are removed instead
+    bool IsHairCardMesh(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+        uint32_t cardCount = 0;
+        FindCards(indices, vertices, cardCount);
+        return cardCount >= HAIR_CARD_MIN_COUNT && (indices.size() / 3) <= cardCount * HAIR_CARD_MAX_TRIANGLES;
+    }
+
+    // Keeps the largest cards and reports how much opacity the survivors need to cover the same area.
+    // resultError is the largest removed card's diagonal, which is how far the silhouette can move
+    std::vector<uint32_t> RemoveHairCards(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float keepRatio, float& resultError, float& alphaScale) {
+        uint32_t cardCount = 0;
+        std::vector<uint32_t> triangleCards = FindCards(indices, vertices, cardCount);
+        std::vector<float> cardAreas(cardCount, 0.0f);
+        std::vector<glm::vec3> cardMin(cardCount, glm::vec3(FLT_MAX));
+        std::vector<glm::vec3> cardMax(cardCount, glm::vec3(-FLT_MAX));
+        for (size_t t = 0; t < triangleCards.size(); t++) {
+            uint32_t card = triangleCards[t];
+            for (int k = 0; k < 3; k++) {
+                cardMin[card] = glm::min(cardMin[card], vertices[indices[t * 3 + k]].position);
+                cardMax[card] = glm::max(cardMax[card], vertices[indices[t * 3 + k]].position);
+            }
+            const glm::vec3& p0 = vertices[indices[t * 3]].position;
+            cardAreas[card] += glm::length(glm::cross(vertices[indices[t * 3 + 1]].position - p0, vertices[indices[t * 3 + 2]].position - p0)) * 0.5f;
+        }
+        std::vector<uint32_t> order(cardCount);
+        for (uint32_t i = 0; i < cardCount; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&cardAreas](uint32_t a, uint32_t b) {
+            return cardAreas[a] > cardAreas[b];
+        });
+        uint32_t keepCount = std::max((uint32_t)std::ceil(cardCount * keepRatio), 1u);
+        std::vector<uint8_t> kept(cardCount, 0);
+        float totalArea = 0.0f;
+        float keptArea = 0.0f;
+        resultError = 0.0f;
+        for (uint32_t i = 0; i < cardCount; i++) {
+            uint32_t card = order[i];
+            totalArea += cardAreas[card];
+            if (i < keepCount) {
+                kept[card] = 1;
+                keptArea += cardAreas[card];
+            }
+            else {
+                resultError = std::max(resultError, glm::length(cardMax[card] - cardMin[card]));
+            }
+        }
+        alphaScale = (keptArea > 0.0f) ? std::clamp(totalArea / keptArea, 1.0f, HAIR_CARD_MAX_ALPHA_SCALE) : 1.0f;
+
+        // Triangle order is kept so the cache and overdraw ordering from OptimizeMesh() carries over
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (size_t t = 0; t < triangleCards.size(); t++) {
+            if (kept[triangleCards[t]]) {
+                result.insert(result.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+            }
+        }
+        return result;
+    }
+
+    /*
+    █▀▀ █   █ █ █▀▀ ▀█▀ █▀▀ █▀▄ █▀▀
+    █   █   █ █ ▀▀█  █  █▀▀ █▀▄ ▀▀█
+    ▀▀▀ ▀▀▀ ▀▀▀ ▀▀▀  ▀  ▀▀▀ ▀ ▀ ▀▀▀ */
+
+    uint32_t ExpandBits(uint32_t v) {
+        v = (v | (v << 16)) & 0x030000FF;
+        v = (v | (v << 8)) & 0x0300F00F;
+        v = (v | (v << 4)) & 0x030C30C3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    }
+
+    uint32_t GetMortonCode(const glm::vec3& position, const glm::vec3& aabbMin, const glm::vec3& aabbSize) {
+        glm::vec3 normalized = glm::clamp((position - aabbMin) / glm::max(aabbSize, glm::vec3(1e-6f)), 0.0f, 1.0f);
+        glm::uvec3 cell = glm::uvec3(normalized * 1023.0f);
+        return (ExpandBits(cell.x) << 2) | (ExpandBits(cell.y) << 1) | ExpandBits(cell.z);
+    }
+
+    // Bounding sphere around the AABB center, normal cone from the average triangle normal (meshoptimizer's formulation)
+    MeshCluster ComputeClusterBounds(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, uint32_t firstIndex, uint32_t indexCount) {
+        MeshCluster cluster;
+        cluster.firstIndex = firstIndex;
+        cluster.indexCount = indexCount;
+        glm::vec3 aabbMin = glm::vec3(FLT_MAX);
+        glm::vec3 aabbMax = glm::vec3(-FLT_MAX);
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; i++) {
+            aabbMin = glm::min(aabbMin, vertices[indices[i]].position);
+            aabbMax = glm::max(aabbMax, vertices[indices[i]].position);
+        }
+        cluster.center = (aabbMin + aabbMax) * 0.5f;
+        glm::vec3 normalSum = glm::vec3(0.0f);
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; i += 3) {
+            const glm::vec3& p0 = vertices[indices[i]].position;
+            const glm::vec3& p1 = vertices[indices[i + 1]].position;
+            const glm::vec3& p2 = vertices[indices[i + 2]].position;
+            cluster.radius = std::max({ cluster.radius, glm::length(p0 - cluster.center), glm::length(p1 - cluster.center), glm::length(p2 - cluster.center) });
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float length = glm::length(normal);
+            normalSum += (length > 0.0f) ? normal / length : glm::vec3(0.0f);
+        }
+        float normalSumLength = glm::length(normalSum);
+        if (normalSumLength == 0.0f) {
+            return cluster;
+        }
+        cluster.coneAxis = normalSum / normalSumLength;
+        float minDot = 1.0f;
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; i += 3) {
+            const glm::vec3& p0 = vertices[indices[i]].position;
+            glm::vec3 normal = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+            float length = glm::length(normal);
+            if (length > 0.0f) {
+                minDot = std::min(minDot, glm::dot(normal / length, cluster.coneAxis));
+            }
+        }
+        // Widening the cone by 90 degrees on each side and inverting it gives sin(angle) as the cutoff
+        cluster.coneCutoff = (minDot <= CLUSTER_MIN_CONE_DOT) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+        return cluster;
+    }
+
+    // Cache and overdraw order inside one cluster. Runs on a local copy of the cluster's vertices so the per vertex tables
+    // stay cluster sized instead of mesh sized
+    void OptimizeClusterOrder(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, uint32_t firstIndex, uint32_t indexCount) {
+        std::unordered_map<uint32_t, uint32_t> meshToLocal;
+        std::vector<uint32_t> localToMesh;
+        std::vector<Vertex> localVertices;
+        std::vector<uint32_t> localIndices(indexCount);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            uint32_t index = indices[firstIndex + i];
+            auto [it, inserted] = meshToLocal.try_emplace(index, (uint32_t)localToMesh.size());
+            if (inserted) {
+                localToMesh.push_back(index);
+                localVertices.push_back(vertices[index]);
+            }
+            localIndices[i] = it->second;
+        }
+        std::vector<uint32_t> clusterOffsets;
+        localIndices = OptimizeVertexCache(localIndices, (uint32_t)localVertices.size(), clusterOffsets);
+        OptimizeOverdraw(localIndices, localVertices, clusterOffsets, OVERDRAW_THRESHOLD);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            indices[firstIndex + i] = localToMesh[localIndices[i]];
+        }
+    }
+
+    // Whole clusters are sorted by how far out they face from the mesh centroid, the same key OptimizeOverdraw() uses,
+    // so the outer layers of hair still draw first now that the order between clusters is free
+    void SortClustersByOverdraw(MeshData& meshData) {
+        uint32_t clusterCount = (uint32_t)meshData.clusters.size();
+        std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+        std::vector<float> clusterAreas(clusterCount, 0.0f);
+        glm::vec3 meshCentroid = glm::vec3(0.0f);
+        float meshArea = 0.0f;
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            const MeshCluster& cluster = meshData.clusters[c];
+            for (uint32_t i = cluster.firstIndex; i < cluster.firstIndex + cluster.indexCount; i += 3) {
+                const glm::vec3& p0 = meshData.vertices[meshData.indices[i]].position;
+                const glm::vec3& p1 = meshData.vertices[meshData.indices[i + 1]].position;
+                const glm::vec3& p2 = meshData.vertices[meshData.indices[i + 2]].position;
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float area = glm::length(normal);
+                clusterCentroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormals[c] += normal;
+                clusterAreas[c] += area;
+            }
+            meshCentroid += clusterCentroids[c];
+            meshArea += clusterAreas[c];
+        }
+        meshCentroid = (meshArea > 0.0f) ? meshCentroid / meshArea : meshCentroid;
+
+        std::vector<float> sortKeys(clusterCount, 0.0f);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            float normalLength = glm::length(clusterNormals[c]);
+            if (clusterAreas[c] > 0.0f && normalLength > 0.0f) {
+                glm::vec3 centroid = clusterCentroids[c] / clusterAreas[c];
+                sortKeys[c] = glm::dot(centroid - meshCentroid, clusterNormals[c] / normalLength);
+            }
+        }
+        std::vector<uint32_t> order(clusterCount);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            order[c] = c;
+        }
+        std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+            return sortKeys[a] > sortKeys[b];
+        });
+
+        std::vector<uint32_t> indices;
+        std::vector<MeshCluster> clusters;
+        indices.reserve(meshData.indices.size());
+        clusters.reserve(clusterCount);
+        for (uint32_t c : order) {
+            MeshCluster& cluster = clusters.emplace_back(meshData.clusters[c]);
+            cluster.firstIndex = (uint32_t)indices.size();
+            indices.insert(indices.end(), meshData.indices.begin() + meshData.clusters[c].firstIndex, meshData.indices.begin() + meshData.clusters[c].firstIndex + meshData.clusters[c].indexCount);
+        }
+        meshData.indices.swap(indices);
+        meshData.clusters.swap(clusters);
+    }
+
+    // Whole cards are packed in Morton order of their centers, so a cluster is a spatially tight handful of cards.
+    // Clustering throws away the order OptimizeMesh() produced, so cache and overdraw order are rebuilt inside each cluster
+    // and the clusters are sorted outside in. Reorders the full detail indices, so call it before GenerateLods()
+    void BuildClusters(MeshData& meshData) {
+        meshData.clusters.clear();
+        if (meshData.indices.size() < 3) {
+            return;
+        }
+        uint32_t cardCount = 0;
+        std::vector<uint32_t> triangleCards = FindCards(meshData.indices, meshData.vertices, cardCount);
+        std::vector<glm::vec3> cardCenters(cardCount, glm::vec3(0.0f));
+        std::vector<uint32_t> cardTriangleCounts(cardCount, 0);
+        for (size_t t = 0; t < triangleCards.size(); t++) {
+            for (int k = 0; k < 3; k++) {
+                cardCenters[triangleCards[t]] += meshData.vertices[meshData.indices[t * 3 + k]].position;
+            }
+            cardTriangleCounts[triangleCards[t]]++;
+        }
+        glm::vec3 aabbSize = meshData.aabbMax - meshData.aabbMin;
+        std::vector<uint32_t> cardMortonCodes(cardCount);
+        for (uint32_t c = 0; c < cardCount; c++) {
+            cardMortonCodes[c] = GetMortonCode(cardCenters[c] / (3.0f * cardTriangleCounts[c]), meshData.aabbMin, aabbSize);
+        }
+        std::vector<uint32_t> cardOrder(cardCount);
+        for (uint32_t c = 0; c < cardCount; c++) {
+            cardOrder[c] = c;
+        }
+        std::stable_sort(cardOrder.begin(), cardOrder.end(), [&cardMortonCodes](uint32_t a, uint32_t b) {
+            return cardMortonCodes[a] < cardMortonCodes[b];
+        });
+
+        // Bucket triangles by card
+        std::vector<uint32_t> cardOffsets(cardCount + 1, 0);
+        for (uint32_t c = 0; c < cardCount; c++) {
+            cardOffsets[c + 1] = cardOffsets[c] + cardTriangleCounts[c];
+        }
+        std::vector<uint32_t> cardTriangles(triangleCards.size());
+        std::vector<uint32_t> fillCursor(cardOffsets.begin(), cardOffsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCards.size(); t++) {
+            cardTriangles[fillCursor[triangleCards[t]]++] = t;
+        }
+
+        // A card is only split when it alone is bigger than a cluster
+        std::vector<uint32_t> result;
+        result.reserve(meshData.indices.size());
+        uint32_t clusterStart = 0;
+        for (uint32_t card : cardOrder) {
+            for (uint32_t i = cardOffsets[card]; i < cardOffsets[card + 1]; i++) {
+                uint32_t clusterTriangles = (uint32_t)(result.size() - clusterStart) / 3;
+                bool cardStart = (i == cardOffsets[card]);
+                if (clusterTriangles == CLUSTER_MAX_TRIANGLES || (cardStart && clusterTriangles + cardTriangleCounts[card] > CLUSTER_MAX_TRIANGLES && clusterTriangles > 0)) {
+                    meshData.clusters.push_back(ComputeClusterBounds(result, meshData.vertices, clusterStart, (uint32_t)result.size() - clusterStart));
+                    clusterStart = (uint32_t)result.size();
+                }
+                uint32_t t = cardTriangles[i];
+                result.insert(result.end(), meshData.indices.begin() + t * 3, meshData.indices.begin() + t * 3 + 3);
+            }
+        }
+        meshData.clusters.push_back(ComputeClusterBounds(result, meshData.vertices, clusterStart, (uint32_t)result.size() - clusterStart));
+        meshData.indices.swap(result);
+
+        for (const MeshCluster& cluster : meshData.clusters) {
+            OptimizeClusterOrder(meshData.indices, meshData.vertices, cluster.firstIndex, cluster.indexCount);
+        }
+        SortClustersByOverdraw(meshData);
+        OptimizeVertexFetch(meshData.indices, meshData.vertices);
+        meshData.vertexCount = (int)meshData.vertices.size();
+
+        uint32_t cullableCount = 0;
+        for (const MeshCluster& cluster : meshData.clusters) {
+            cullableCount += (cluster.coneCutoff < 1.0f) ? 1 : 0;
+        }
+        VertexCacheStats cacheStats = AnalyzeVertexCache(meshData.indices, (uint32_t)meshData.vertices.size());
+        OverdrawStats overdrawStats = AnalyzeOverdraw(meshData.indices, meshData.vertices);
+        std::cout << std::format("Built {} clusters for '{}', {} with a usable normal cone, ACMR {:.3f}, overdraw {:.3f}\n",
+            meshData.clusters.size(), meshData.name, cullableCount, cacheStats.acmr, overdrawStats.overdraw);
+    }
+
+    /*
+    █   █▀█ █▀▄ █▀▀
+    █   █ █ █ █ ▀▀█
+    ▀▀▀ ▀▀▀ ▀▀  ▀▀▀ */
+
+    // Every LOD is simplified from the full mesh rather than the previous LOD so errors don't compound
+    void GenerateLods(MeshData& meshData) {
+        meshData.lods.clear();
+        if (meshData.indices.size() < 3 || meshData.vertices.empty()) {
+            return;
+        }
+        uint32_t vertexCount = (uint32_t)meshData.vertices.size();
+        float maxError = glm::length(meshData.aabbMax - meshData.aabbMin) * LOD_MAX_RELATIVE_ERROR;
+        bool hairCards = IsHairCardMesh(meshData.indices, meshData.vertices);
+        size_t previousIndexCount = meshData.indices.size();
+        float previousError = 0.0f;
+        std::string triangleCounts = std::to_string(meshData.indices.size() / 3);
+
+        for (float ratio : LOD_TRIANGLE_RATIOS) {
+            MeshLodData lod;
+            if (hairCards) {
+                lod.indices = RemoveHairCards(meshData.indices, meshData.vertices, ratio, lod.error, lod.alphaScale);
+            }
+            else {
+                uint32_t targetIndexCount = (uint32_t)(meshData.indices.size() / 3 * ratio) * 3;
+                lod.indices = SimplifyMesh(meshData.indices, meshData.vertices, targetIndexCount, maxError, lod.error);
+            }
+            // Not worth a LOD if the simplifier stalled on locked or high error geometry
+            if (lod.indices.empty() || lod.indices.size() > previousIndexCount * LOD_MIN_REDUCTION) {
+                break;
+            }
+            std::vector<uint32_t> clusterOffsets;
+            lod.indices = OptimizeVertexCache(lod.indices, vertexCount, clusterOffsets);
+            lod.error = std::max(lod.error, previousError);
+            previousIndexCount = lod.indices.size();
+            previousError = lod.error;
+            triangleCounts += " / " + std::to_string(lod.indices.size() / 3);
+            meshData.lods.push_back(std::move(lod));
+        }
+        std::cout << "Generated " << meshData.lods.size() << " LODs for '" << meshData.name << "'" << (hairCards ? " (hair cards)" : "") << ": " << triangleCounts << " triangles\n";
+    }
+
+    /*
+    █▀▀ █ █ █▀█ █▀█ █▀▄ ▀█▀
+    █▀▀ ▄▀▄ █▀▀ █ █ █▀▄  █
+    ▀▀▀ ▀ ▀ ▀   ▀▀▀ ▀ ▀  ▀ */
+
+    void OptimizeMesh(MeshData& meshData) {
+        if (meshData.indices.size() < 3 || meshData.vertices.empty()) {
+            return;
+        }
+        VertexCacheStats cacheBefore = AnalyzeVertexCache(meshData.indices, (uint32_t)meshData.vertices.size());
+        OverdrawStats overdrawBefore = AnalyzeOverdraw(meshData.indices, meshData.vertices);
+
+        std::vector<uint32_t> clusterOffsets;
+        meshData.indices = OptimizeVertexCache(meshData.indices, (uint32_t)meshData.vertices.size(), clusterOffsets);
+        OptimizeOverdraw(meshData.indices, meshData.vertices, clusterOffsets, OVERDRAW_THRESHOLD);
+        OptimizeVertexFetch(meshData.indices, meshData.vertices);
+        meshData.vertexCount = (int)meshData.vertices.size();
+        meshData.indexCount = (int)meshData.indices.size();
+
+        VertexCacheStats cacheAfter = AnalyzeVertexCache(meshData.indices, (uint32_t)meshData.vertices.size());
+        OverdrawStats overdrawAfter = AnalyzeOverdraw(meshData.indices, meshData.vertices);
+        std::cout << std::format("Optimized mesh '{}': ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, overdraw {:.3f} -> {:.3f}\n",
+            meshData.name, cacheBefore.acmr, cacheAfter.acmr, cacheBefore.atvr, cacheAfter.atvr, overdrawBefore.overdraw, overdrawAfter.overdraw);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../Common/Types.h"
+#include "../File/FileFormats.h"
+
+struct VertexCacheStats {
+    float acmr = 0.0f;      // Vertex transforms per triangle
+    float atvr = 0.0f;      // Vertex transforms per unique vertex, 1.0 is ideal
+};
+
+struct OverdrawStats {
+    float overdraw = 0.0f;  // Shaded pixels per covered pixel, 1.0 is ideal
+};
+
+namespace MeshTools {
+    // Export time optimization, run on every mesh before it is written to a .model file
+    void OptimizeMesh(MeshData& meshData);
+
+    // Individual stages, in the order OptimizeMesh() runs them
+    std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>& clusterOffsets);
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& clusterOffsets, float threshold);
+    void OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices);
+
+    // Hair clusters for GPU culling, run after OptimizeMesh() and before GenerateLods(). Redoes the cache and overdraw order per cluster
+    void BuildClusters(MeshData& meshData);
+
+    // LODs, run after OptimizeMesh() since every LOD indexes the same optimized vertex buffer
+    void GenerateLods(MeshData& meshData);
+    std::vector<uint32_t> SimplifyMesh(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, uint32_t targetIndexCount, float maxError, float& resultError);
+    bool IsHairCardMesh(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);
+    std::vector<uint32_t> RemoveHairCards(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float keepRatio, float& resultError, float& alphaScale);
+
+    // Analysis
+    VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount);
+    OverdrawStats AnalyzeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);
+}
@@ -1,5 +1,9 @@
 #include "GameObject.h"
 #include "../AssetManagement/AssetManager.h"
+#include "../Core/Camera.h"
+
+// Largest error a LOD may show on screen, as a fraction of half the screen height
+constexpr float LOD_SCREEN_ERROR = 0.002f;
 
 void GameObject::SetPosition(glm::vec3 position) {
     m_transform.position = position;
@@ -11,20 +15,39 @@ void GameObject::SetRotationY(float rotation) {
 
 void GameObject::SetModel(const std::string& name) {
     m_model = AssetManager::GetModelByIndex(AssetManager::GetModelIndexByName(name.c_str()));
-    if (m_model) {
-        m_meshMaterialIndices.resize(m_model->GetMeshCount());
-        m_meshBlendingModes.resize(m_model->GetMeshCount());
-        std::fill(m_meshMaterialIndices.begin(), m_meshMaterialIndices.end(), -1);
-    }
-    else {
+    m_meshMaterialIndices.clear();
+    m_meshBlendingModes.clear();
+    m_defaultBlendingMode = BlendingMode::NONE;
+    m_blendingModeRequests.clear();
+    if (!m_model) {
         std::cout << "Failed to set model '" << name << "', it does not exist.\n";
     }
-    for (BlendingMode& blendingMode : m_meshBlendingModes) {
-        blendingMode = BlendingMode::NONE;
+    SyncMeshSlots();
+}
+
+// A streaming model has no meshes until AssetManager finalizes it, so the per mesh slots are sized lazily
+void GameObject::SyncMeshSlots() {
+    if (!m_model || m_meshMaterialIndices.size() == m_model->GetMeshCount()) {
+        return;
+    }
+    m_meshMaterialIndices.assign(m_model->GetMeshCount(), -1);
+    m_meshBlendingModes.assign(m_model->GetMeshCount(), m_defaultBlendingMode);
+    for (int i = 0; i < m_model->GetMeshCount(); i++) {
+        OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(m_model->GetMeshIndices()[i]);
+        for (auto& [meshName, blendingMode] : m_blendingModeRequests) {
+            if (mesh && mesh->GetName() == meshName) {
+                m_meshBlendingModes[i] = blendingMode;
+            }
+        }
     }
 }
 
 void GameObject::SetMeshMaterialByMeshName(std::string meshName, const char* materialName) {
+    // Materials are reapplied every frame, so a model that is still loading just picks them up later
+    if (m_model && m_model->m_awaitingLoadingFromDisk) {
+        return;
+    }
+    SyncMeshSlots();
     int materialIndex = AssetManager::GetMaterialIndex(materialName);
     if (m_model && materialIndex != -1) {
         for (int i = 0; i < m_model->GetMeshCount(); i++) {
@@ -46,6 +69,11 @@ void GameObject::SetMeshMaterialByMeshName(std::string meshName, const char* mat
 }
 
 void GameObject::SetMeshBlendingMode(const char* meshName, BlendingMode blendingMode) {
+    m_blendingModeRequests.emplace_back(meshName, blendingMode);
+    if (m_model && m_model->m_awaitingLoadingFromDisk) {
+        return;
+    }
+    SyncMeshSlots();
     // Range checks
     if (m_meshBlendingModes.empty()) {
         std::cout << "GameObject::SetMeshBlendingMode() failed: m_meshBlendingModes was empty!\n";
@@ -67,6 +95,9 @@ void GameObject::SetMeshBlendingMode(const char* meshName, BlendingMode blending
 }
 
 void GameObject::SetMeshBlendingModes(BlendingMode blendingMode) {
+    m_defaultBlendingMode = blendingMode;
+    m_blendingModeRequests.clear();
+    SyncMeshSlots();
     if (m_model) {
         for (int i = 0; i < m_model->GetMeshIndices().size(); i++) {
             OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(m_model->GetMeshIndices()[i]);
@@ -93,12 +124,53 @@ void GameObject::PrintMeshNames() {
     }
 }
 
+// Coarsest level whose error, projected from the closest the mesh bounds can get to the camera, stays under LOD_SCREEN_ERROR
+int SelectLod(OpenGLDetachedMesh* mesh, const glm::mat4& modelMatrix, const glm::vec3& viewPos, float projectionScale) {
+    if (mesh->GetLodCount() <= 1 || mesh->aabbMin.x > mesh->aabbMax.x) {
+        return 0;
+    }
+    float scale = std::max({ glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2])) });
+    glm::vec3 center = glm::vec3(modelMatrix * glm::vec4((mesh->aabbMin + mesh->aabbMax) * 0.5f, 1.0f));
+    float radius = glm::length(mesh->aabbMax - mesh->aabbMin) * 0.5f * scale;
+    float distance = std::max(glm::length(center - viewPos) - radius, NEAR_PLANE);
+    float screenErrorPerUnit = projectionScale * scale / distance;
+    int lodIndex = 0;
+    while (lodIndex + 1 < mesh->GetLodCount() && mesh->GetLod(lodIndex + 1).error * screenErrorPerUnit <= LOD_SCREEN_ERROR) {
+        lodIndex++;
+    }
+    return lodIndex;
+}
+
 void GameObject::UpdateRenderItems() {
+    glm::vec3 viewPos = Camera::GetViewPos();
+    float projectionScale = Camera::GetProjectionMatrix()[1][1];
     m_renderItems.clear();
     m_renderItemsBlended.clear();
     m_renderItemsAlphaDiscarded.clear();
     m_renderItemsHairTopLayer.clear();
     m_renderItemsHairBottomLayer.clear();
+    // Stand in for a model that is still streaming, a default material cube over its bounds when they're known
+    if (m_model && m_model->m_awaitingLoadingFromDisk) {
+        glm::vec3 aabbMin = m_model->m_aabbMin;
+        glm::vec3 aabbMax = m_model->m_aabbMax;
+        if (aabbMin.x > aabbMax.x) {
+            aabbMin = glm::vec3(-0.5f);
+            aabbMax = glm::vec3(0.5f);
+        }
+        RenderItem renderItem;
+        renderItem.modelMatrix = m_transform.to_mat4() * glm::translate(glm::mat4(1.0f), (aabbMin + aabbMax) * 0.5f) * glm::scale(glm::mat4(1.0f), aabbMax - aabbMin);
+        renderItem.meshIndex = AssetManager::GetPlaceholderMeshIndex();
+        Material* material = AssetManager::GetDefaultMaterial();
+        if (material && renderItem.meshIndex != -1) {
+            renderItem.materialIndex = AssetManager::GetMaterialIndex(material->m_name);
+            renderItem.baseColorTextureIndex = material->m_basecolor;
+            renderItem.normalTextureIndex = material->m_normal;
+            renderItem.rmaTextureIndex = material->m_rma;
+            m_renderItems.push_back(renderItem);
+        }
+        return;
+    }
+    SyncMeshSlots();
     if (m_model) {
         for (int i = 0; i < m_model->GetMeshCount(); i++) {
             OpenGLDetachedMesh* mesh = AssetManager::GetMeshByIndex(m_model->GetMeshIndices()[i]);
@@ -106,8 +178,10 @@ void GameObject::UpdateRenderItems() {
                 RenderItem renderItem;
                 renderItem.modelMatrix = m_transform.to_mat4();
                 renderItem.meshIndex = m_model->GetMeshIndices()[i];
+                renderItem.lodIndex = SelectLod(mesh, renderItem.modelMatrix, viewPos, projectionScale);
                 Material* material = AssetManager::GetMaterialByIndex(m_meshMaterialIndices[i]);
                 if (material) {
+                    renderItem.materialIndex = m_meshMaterialIndices[i];
                     renderItem.baseColorTextureIndex = material->m_basecolor;
                     renderItem.normalTextureIndex = material->m_normal;
                     renderItem.rmaTextureIndex = material->m_rma;
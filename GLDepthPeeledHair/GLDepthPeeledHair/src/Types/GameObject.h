@@ -26,6 +26,11 @@ struct GameObject {
     std::vector<RenderItem>& GetRenderItemsHairBottomLayer();
 
 private:
+    void SyncMeshSlots();
+
+    // Blending modes are kept by mesh name so they can be applied once a streaming model arrives
+    BlendingMode m_defaultBlendingMode = BlendingMode::NONE;
+    std::vector<std::pair<std::string, BlendingMode>> m_blendingModeRequests;
     std::vector<RenderItem> m_renderItems;
     std::vector<RenderItem> m_renderItemsBlended;
     std::vector<RenderItem> m_renderItemsAlphaDiscarded;